@@ -3,122 +3,129 @@
 //
 //  Created by Jonathan Tompson on 3/30/12.
 //
-//  getTime() is threadsafe
+//  A Clk measures the time since it was constructed.  Every method is const
+//  and lock-free, so one Clk can be shared by any number of threads (the
+//  ThreadPool workers timestamping events, etc) without contention.
+//
+//  Sources:
+//  CLK_SOURCE_OS - CLOCK_MONOTONIC on Linux, mach_absolute_time() on OS X,
+//  QueryPerformanceCounter() on Windows.  Never jumps with NTP or a change of
+//  the wall clock.
+//  CLK_SOURCE_TSC - The x86 time stamp counter, calibrated against the OS
+//  clock once per process (which takes CLK_TSC_CALIBRATION_MS the first time
+//  a TSC Clk is made).  Cheaper to read than the OS clock, but only used if
+//  the CPU reports an invariant TSC: otherwise (and on other architectures)
+//  the Clk falls back to CLK_SOURCE_OS, see source().
+//
+//  Ticks are the raw units of the source (nanoseconds for the OS clock on
+//  Linux and OS X).  getTicks() is the cheapest call: timestamp with it on
+//  hot paths and convert the differences with ticksToNS() later.
 //
 
 #pragma once
 
-#include <mutex>
+#include "jtil/math/math_types.h"  // for uint64_t
 
 #if defined(__APPLE_CC__)
 #include <mach/mach.h>
 #include <mach/mach_time.h>
-
-namespace jtil { 
-namespace clk {
-
-  class Clk {
-  public:
-    Clk() {
-      m_cntStart = mach_absolute_time();
-      (void) mach_timebase_info(&sTimebaseInfo);
-    }
-
-    double getTime() {
-      lock_.lock();
-      m_cntCurrent = mach_absolute_time();
-      elapsedNano = (m_cntCurrent-m_cntStart) * 
-        sTimebaseInfo.numer / sTimebaseInfo.denom;
-      double ret_val = static_cast<double>(elapsedNano) / 1000000000.0;
-      lock_.unlock();
-      return ret_val;
-    }
-
-  private:
-    std::mutex lock_;
-    uint64_t m_cntStart;
-    uint64_t m_cntCurrent;
-    uint64_t elapsedNano;
-    mach_timebase_info_data_t sTimebaseInfo;
-
-    // Non-copyable, non-assignable.
-    Clk(Clk&);
-    Clk& operator=(const Clk&);
-  };
-
-};  // namespace clk 
-};  // namespace jtil
-
+#elif defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
+#include <profileapi.h>
+#include <intrin.h>
 #elif defined(__GNUC__)
 #include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+  defined(_M_IX86)
+#define CLK_HAS_TSC
+#if defined(__GNUC__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#define CLK_TSC_CALIBRATION_MS 10
 
 namespace jtil {
 namespace clk {
 
+  typedef enum {
+    CLK_SOURCE_OS = 0,
+    CLK_SOURCE_TSC = 1,
+  } ClkSource;
+
   class Clk {
   public:
-    Clk() {
-      clock_gettime(CLOCK_REALTIME, &m_cntStart);
-    }
+    explicit Clk(const ClkSource source = CLK_SOURCE_OS);
 
-    double getTime() {
-      lock_.lock();
-      clock_gettime(CLOCK_REALTIME, &m_cntCurrent);
-      elapsedNano = (double)(m_cntCurrent.tv_nsec-m_cntStart.tv_nsec) /
-          1000000000.0;
-      elapsedSec = (double)(m_cntCurrent.tv_sec-m_cntStart.tv_sec);
-      double ret_val = elapsedNano + elapsedSec;
-      lock_.unlock();
-      return ret_val;
+    // getTime() - Seconds since construction
+    inline double getTime() const {
+      return static_cast<double>(getTicks() - start_ticks_) * secs_per_tick_;
     }
 
-  private:
-    std::mutex lock_;
-    timespec m_cntStart;
-    timespec m_cntCurrent;
-    double elapsedNano;
-    double elapsedSec;
-
-    // Non-copyable, non-assignable.
-    Clk(Clk&);
-    Clk& operator=(const Clk&);
-  };
-
-};  // namespace clk
-};  // namespace jtil
+    // getTimeNS() - Nanoseconds since construction
+    inline uint64_t getTimeNS() const {
+      return ticksToNS(getTicks() - start_ticks_);
+    }
 
+    // getTicks() - The current (absolute) tick count of the source
+    inline uint64_t getTicks() const {
+#if defined(CLK_HAS_TSC)
+      if (source_ == CLK_SOURCE_TSC) {
+        return __rdtsc();
+      }
 #endif
+      return OSTicks();
+    }
 
-#if defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
-#include <profileapi.h>
+    // ticksToNS() - Exact for any tick count (no overflow)
+    inline uint64_t ticksToNS(const uint64_t ticks) const {
+      return (ticks / ticks_per_sec_) * 1000000000ull +
+        ((ticks % ticks_per_sec_) * 1000000000ull) / ticks_per_sec_;
+    }
 
-namespace jtil {
-namespace clk {
+    inline double nsPerTick() const { return 1e9 * secs_per_tick_; }
+    inline uint64_t ticksPerSec() const { return ticks_per_sec_; }
+    inline uint64_t startTicks() const { return start_ticks_; }
+    // source() - The source actually in use
+    inline ClkSource source() const { return source_; }
 
-  class Clk {
-  public:
-    Clk() {
-      QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&m_cntFreq));
-      m_secsPerCnt = 1.0 / static_cast<double>(m_cntFreq);
-      QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&m_cntStart));
+    // OSTicks() - The OS clock (source CLK_SOURCE_OS) without a Clk
+    static inline uint64_t OSTicks() {
+#if defined(__APPLE_CC__)
+      static mach_timebase_info_data_t timebase = MachTimebase();
+      const uint64_t t = mach_absolute_time();
+      return (t / timebase.denom) * timebase.numer +
+        ((t % timebase.denom) * timebase.numer) / timebase.denom;
+#elif defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
+      __int64 t;
+      QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&t));
+      return static_cast<uint64_t>(t);
+#else
+      timespec t;
+      clock_gettime(CLOCK_MONOTONIC, &t);
+      return static_cast<uint64_t>(t.tv_sec) * 1000000000ull +
+        static_cast<uint64_t>(t.tv_nsec);
+#endif
     }
+    static uint64_t OSTicksPerSec();
 
-    double getTime() {
-      lock_.lock();
-      QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&m_cntCurrent));
-      double elapsedSec = static_cast<double>(m_cntCurrent - m_cntStart) * 
-        static_cast<double>(m_secsPerCnt);
-      lock_.unlock();
-      return elapsedSec;
-    }
+    // TSCTicksPerSec() - The calibrated TSC frequency, or 0 if the CPU has
+    // no invariant TSC.  The first call calibrates it.
+    static uint64_t TSCTicksPerSec();
 
   private:
-    std::mutex lock_;
-    double elapsedSec;
-    __int64 m_cntFreq,  // Frequency of the precision counter
-      m_cntStart,  // Current counter value
-      m_cntCurrent;
-    double  m_secsPerCnt;  // counter period
+    ClkSource source_;
+    uint64_t ticks_per_sec_;
+    double secs_per_tick_;
+    uint64_t start_ticks_;
+
+#if defined(__APPLE_CC__)
+    static mach_timebase_info_data_t MachTimebase();
+#elif defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
+    static uint64_t QPCFrequency();
+#endif
+    static uint64_t CalibrateTSC();
 
     // Non-copyable, non-assignable.
     Clk(Clk&);
@@ -127,5 +134,3 @@ namespace clk {
 
 };  // namespace clk
 };  // namespace jtil
-
-#endif
@@ -0,0 +1,138 @@
+//
+//  aligned_allocator.h
+//
+//  Allocation policies for Vector and VectorManaged (their Alloc template
+//  parameter).  A policy is a class of static functions:
+//
+//    void* allocate(const size_t bytes);
+//    void* reallocate(void* ptr, const size_t copy_bytes, const size_t bytes);
+//    void release(void* ptr);
+//
+//  All of them return NULL on failure.  reallocate() resizes ptr's block to
+//  bytes, keeping (at least) its first copy_bytes, and a NULL ptr is a plain
+//  allocate().
+//
+//  AlignedAllocator<N> - N byte aligned blocks (N a power of 2).  Vector's
+//                        default, with N = ALIGNMENT.
+//  CacheLineAllocator  - 64 byte aligned, so a buffer never shares its first
+//                        or last cache line with another allocation.
+//  HugePageAllocator   - blocks of 2MB or more are 2MB aligned, rounded up
+//                        to whole 2MB pages and (on Linux) madvise'd with
+//                        MADV_HUGEPAGE so transparent huge pages can back
+//                        them.  Smaller blocks are cache line aligned.
+//
+
+#pragma once
+
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uintptr_t
+#include <stdlib.h>  // For posix_memalign(), realloc(), free()
+#include <string.h>  // For memcpy()
+#ifdef _WIN32
+  #include <malloc.h>  // For _aligned_malloc()
+#else
+  #include <sys/mman.h>  // For madvise()
+#endif
+#include "jtil/alignment/data_align.h"
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+#define ALIGNED_ALLOCATOR_CACHE_LINE_SIZE 64
+#define ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+namespace jtil {
+namespace data_str {
+
+  template <size_t Alignment>
+  class AlignedAllocator {
+  public:
+    static_assert((Alignment & (Alignment - 1)) == 0 && 
+      Alignment >= sizeof(void*), "Alignment must be a power of 2 and at "
+      "least sizeof(void*)");
+
+    static inline void* allocate(const size_t bytes) {
+#ifdef _WIN32
+      return _aligned_malloc(bytes, Alignment);
+#else
+      void* ptr = NULL;
+      if (posix_memalign(&ptr, Alignment, bytes) != 0) {
+        return NULL;
+      }
+      return ptr;
+#endif
+    }
+
+    static inline void* reallocate(void* ptr, const size_t copy_bytes, 
+      const size_t bytes) {
+#ifdef _WIN32
+      static_cast<void>(copy_bytes);
+      return _aligned_realloc(ptr, bytes, Alignment);
+#else
+      // realloc only promises malloc's alignment (2 pointers on glibc), past
+      // that we have to move to a new block ourselves
+      if (Alignment <= 2 * sizeof(void*)) {
+        return realloc(ptr, bytes);
+      }
+      void* ret = allocate(bytes);
+      if (ret != NULL && ptr != NULL) {
+        memcpy(ret, ptr, copy_bytes < bytes ? copy_bytes : bytes);
+        free(ptr);
+      }
+      return ret;
+#endif
+    }
+
+    static inline void release(void* ptr) {
+#ifdef _WIN32
+      _aligned_free(ptr);
+#else
+      free(ptr);
+#endif
+    }
+  };
+
+  typedef AlignedAllocator<ALIGNED_ALLOCATOR_CACHE_LINE_SIZE> 
+    CacheLineAllocator;
+
+  class HugePageAllocator {
+  public:
+    static inline void* allocate(const size_t bytes) {
+      const size_t page = ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE;
+      if (bytes < page) {
+        return CacheLineAllocator::allocate(bytes);
+      }
+      const size_t huge_bytes = (bytes + page - 1) & ~(page - 1);
+      void* ptr = HugePageAligned::allocate(huge_bytes);
+#if defined(MADV_HUGEPAGE)
+      if (ptr != NULL) {
+        // This is only advice: without THP (or with it set to "never") we
+        // just get small pages
+        madvise(ptr, huge_bytes, MADV_HUGEPAGE);
+      }
+#endif
+      return ptr;
+    }
+
+    static inline void* reallocate(void* ptr, const size_t copy_bytes, 
+      const size_t bytes) {
+      // Never realloc, the new block wouldn't be huge page aligned
+      void* ret = allocate(bytes);
+      if (ret != NULL && ptr != NULL) {
+        memcpy(ret, ptr, copy_bytes < bytes ? copy_bytes : bytes);
+        release(ptr);
+      }
+      return ret;
+    }
+
+    static inline void release(void* ptr) {
+      CacheLineAllocator::release(ptr);  // Same free for both block sizes
+    }
+
+  private:
+    typedef AlignedAllocator<ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE> HugePageAligned;
+  };
+
+};  // namespace data_str
+};  // namespace jtil
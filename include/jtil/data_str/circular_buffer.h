@@ -5,7 +5,8 @@
 //
 // This is a fixed-size, circular buffer.
 //
-// The class is not thread-safe,
+// The class is not thread-safe, see CircularBufferSPSC
+// (circular_buffer_spsc.h) for handing values between two threads.
 //
 // To distinguish between empty and full states, the array never gets completely
 // full.  If: p_write == p_read, then the array is empty.
@@ -0,0 +1,221 @@
+//
+//  circular_buffer_spsc.h
+//
+//  A fixed-size, lock-free circular buffer for exactly one producer thread
+//  and one consumer thread (ie, handing frames from a capture thread to a
+//  processing thread).  Unlike CircularBuffer, writes never overwrite unread
+//  values: write() returns false (or writes fewer values) when it is full.
+//
+//  The write and read positions are free running 64 bit counters, so all
+//  'slots' are usable and the positions never wrap in practice.  Each one is
+//  only written by its owner thread (release) and read by the other thread
+//  (acquire), and each side keeps a cached copy of the other side's position
+//  so that it only touches the other cache line when it looks full / empty.
+//
+//  Large values can be produced and consumed in place (no copy):
+//
+//    Frame* frame = buffer.reserve();  // Producer, NULL if full
+//    if (frame) { fill(frame); buffer.commit(); }
+//    Frame* frame = buffer.peek();  // Consumer, NULL if empty
+//    if (frame) { process(frame); buffer.consume(); }
+//
+//  The slots are default constructed once and then reused, so a T that owns
+//  a buffer (ie, a depth image) keeps its memory from one frame to the next.
+//
+
+#pragma once
+
+#include <atomic>
+#include "jtil/math/math_types.h"  // for uint32_t, uint64_t
+#include "jtil/exceptions/wruntime_error.h"
+
+#define CIRCULAR_BUFFER_SPSC_CACHE_LINE_SIZE 64
+
+namespace jtil {
+namespace data_str {
+
+  template <class T>
+  class CircularBufferSPSC {
+  public:
+    explicit CircularBufferSPSC(const uint32_t slots);
+    ~CircularBufferSPSC();
+
+    // Producer only:
+    // write() - Copy 'value' into the next free slot, false if full
+    bool write(const T& value);
+    // write() - Copy up to 'n' values, returns the number written
+    uint32_t write(const T* values, const uint32_t n);
+    // reserve() - The next free slot (to fill in place), NULL if full.
+    // Calling it again before commit() returns the same slot.
+    T* reserve();
+    // commit() - Publish the slot returned by reserve()
+    void commit();
+
+    // Consumer only:
+    // read() - Copy out the oldest value, false if empty
+    bool read(T& ret_val);
+    // read() - Copy out up to 'n' values, returns the number read
+    uint32_t read(T* values, const uint32_t n);
+    // peek() - The oldest value (to use in place), NULL if empty.  It stays
+    // valid until consume() is called.
+    T* peek();
+    // consume() - Release the slot returned by peek()
+    void consume();
+
+    // Only a snapshot when the other thread is using the buffer
+    uint32_t size() const;
+    inline bool empty() const { return size() == 0; }
+    inline bool full() const { return size() == slots_; }
+    inline uint32_t capacity() const { return slots_; }
+
+  private:
+    typedef char CacheLinePad[CIRCULAR_BUFFER_SPSC_CACHE_LINE_SIZE];
+
+    CacheLinePad pad0_;
+    T* arr_;
+    uint32_t slots_;
+    CacheLinePad pad1_;
+    std::atomic<uint64_t> p_write_;  // Written by the producer
+    uint64_t p_read_cached_;  // Producer's copy of p_read_
+    CacheLinePad pad2_;
+    std::atomic<uint64_t> p_read_;  // Written by the consumer
+    uint64_t p_write_cached_;  // Consumer's copy of p_write_
+    CacheLinePad pad3_;
+
+    // Number of free slots starting at 'p_write' (producer side)
+    uint32_t numFree(const uint64_t p_write, const uint32_t n);
+    // Number of full slots starting at 'p_read' (consumer side)
+    uint32_t numFull(const uint64_t p_read, const uint32_t n);
+
+    // Non-copyable, non-assignable.
+    CircularBufferSPSC(const CircularBufferSPSC&);
+    CircularBufferSPSC& operator=(const CircularBufferSPSC&);
+  };
+
+  template <class T>
+  CircularBufferSPSC<T>::CircularBufferSPSC(const uint32_t slots) {
+    if (slots < 1) {
+      throw std::wruntime_error("CircularBufferSPSC<T>::CircularBufferSPSC: "
+        "slots < 1");
+    }
+    slots_ = slots;
+    arr_ = new T[slots_];
+    p_write_.store(0, std::memory_order_relaxed);
+    p_read_.store(0, std::memory_order_relaxed);
+    p_read_cached_ = 0;
+    p_write_cached_ = 0;
+  }
+
+  template <class T>
+  CircularBufferSPSC<T>::~CircularBufferSPSC() {
+    delete[] arr_;
+  }
+
+  template <class T>
+  uint32_t CircularBufferSPSC<T>::numFree(const uint64_t p_write,
+    const uint32_t n) {
+    uint32_t num_free = slots_ - static_cast<uint32_t>(p_write -
+      p_read_cached_);
+    if (num_free < n) {
+      // Only look at the consumer's position when we appear to be full
+      p_read_cached_ = p_read_.load(std::memory_order_acquire);
+      num_free = slots_ - static_cast<uint32_t>(p_write - p_read_cached_);
+    }
+    return num_free < n ? num_free : n;
+  }
+
+  template <class T>
+  uint32_t CircularBufferSPSC<T>::numFull(const uint64_t p_read,
+    const uint32_t n) {
+    uint32_t num_full = static_cast<uint32_t>(p_write_cached_ - p_read);
+    if (num_full < n) {
+      p_write_cached_ = p_write_.load(std::memory_order_acquire);
+      num_full = static_cast<uint32_t>(p_write_cached_ - p_read);
+    }
+    return num_full < n ? num_full : n;
+  }
+
+  template <class T>
+  bool CircularBufferSPSC<T>::write(const T& value) {
+    return write(&value, 1) == 1;
+  }
+
+  template <class T>
+  uint32_t CircularBufferSPSC<T>::write(const T* values, const uint32_t n) {
+    const uint64_t p_write = p_write_.load(std::memory_order_relaxed);
+    const uint32_t num = numFree(p_write, n);
+    uint32_t index = static_cast<uint32_t>(p_write % slots_);
+    for (uint32_t i = 0; i < num; i++) {
+      arr_[index] = values[i];
+      index = index + 1 == slots_ ? 0 : index + 1;
+    }
+    if (num > 0) {
+      p_write_.store(p_write + num, std::memory_order_release);
+    }
+    return num;
+  }
+
+  template <class T>
+  T* CircularBufferSPSC<T>::reserve() {
+    const uint64_t p_write = p_write_.load(std::memory_order_relaxed);
+    if (numFree(p_write, 1) == 0) {
+      return NULL;
+    }
+    return &arr_[p_write % slots_];
+  }
+
+  template <class T>
+  void CircularBufferSPSC<T>::commit() {
+    const uint64_t p_write = p_write_.load(std::memory_order_relaxed);
+    p_write_.store(p_write + 1, std::memory_order_release);
+  }
+
+  template <class T>
+  bool CircularBufferSPSC<T>::read(T& ret_val) {
+    return read(&ret_val, 1) == 1;
+  }
+
+  template <class T>
+  uint32_t CircularBufferSPSC<T>::read(T* values, const uint32_t n) {
+    const uint64_t p_read = p_read_.load(std::memory_order_relaxed);
+    const uint32_t num = numFull(p_read, n);
+    uint32_t index = static_cast<uint32_t>(p_read % slots_);
+    for (uint32_t i = 0; i < num; i++) {
+      values[i] = arr_[index];
+      index = index + 1 == slots_ ? 0 : index + 1;
+    }
+    if (num > 0) {
+      p_read_.store(p_read + num, std::memory_order_release);
+    }
+    return num;
+  }
+
+  template <class T>
+  T* CircularBufferSPSC<T>::peek() {
+    const uint64_t p_read = p_read_.load(std::memory_order_relaxed);
+    if (numFull(p_read, 1) == 0) {
+      return NULL;
+    }
+    return &arr_[p_read % slots_];
+  }
+
+  template <class T>
+  void CircularBufferSPSC<T>::consume() {
+    const uint64_t p_read = p_read_.load(std::memory_order_relaxed);
+    p_read_.store(p_read + 1, std::memory_order_release);
+  }
+
+  template <class T>
+  uint32_t CircularBufferSPSC<T>::size() const {
+    const uint64_t p_read = p_read_.load(std::memory_order_acquire);
+    const uint64_t p_write = p_write_.load(std::memory_order_acquire);
+    // The positions are read at different times, clamp to a sane range
+    if (p_write < p_read) {
+      return 0;
+    }
+    const uint64_t num = p_write - p_read;
+    return num > slots_ ? slots_ : static_cast<uint32_t>(num);
+  }
+
+};  // namespace data_str
+};  // namespace jtil
@@ -0,0 +1,361 @@
+//
+//  concurrent_hash_map.h
+//
+//  A thread-safe hash map for tables that are read from several threads at
+//  once (ie, asset lookups from loader threads while the render thread draws).
+//
+//  The keys are split over a power of 2 number of shards by the top bits of
+//  their hash, and every shard is a small open addressing table (linear
+//  probing, like HashMap) with its own readers-writer spin lock.  So lookups
+//  only exclude writers to the same shard, and writers to different shards
+//  don't see each other at all.  Each shard is padded to its own cache lines.
+//
+//  Unlike HashMap, keys can be erased (erased buckets are left as tombstones
+//  until the shard is next rehashed).  lookup() returns a copy of the value,
+//  since a reference could be invalidated by another thread as soon as the
+//  shard is unlocked.
+//
+//  The HashFunc is the same as HashMap's, it is called with size MAX_UINT32
+//  (to get the full 32 bit hash, see StringHash) and the result is mixed.
+//
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstring>  // For memset
+#include "jtil/math/math_types.h"  // for uint32_t, MAX_UINT32
+#include "jtil/data_str/pair.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+#define CONCURRENT_HASH_MAP_NUM_SHARDS 16
+#define CONCURRENT_HASH_MAP_CACHE_LINE_SIZE 64
+
+namespace jtil {
+namespace data_str {
+
+  template <class TKey, class TValue>
+  class ConcurrentHashMap {
+  public:
+    typedef uint32_t (*HashFunc) (const uint32_t size, const TKey& key);
+
+    // size is a hint of the total number of keys, num_shards is rounded up
+    // to a power of 2 (use ~4x the number of threads sharing the map)
+    ConcurrentHashMap(const uint32_t size, HashFunc hash_func,
+      const uint32_t num_shards = CONCURRENT_HASH_MAP_NUM_SHARDS);
+    ~ConcurrentHashMap();
+
+    // insert() - Add the key only if it's absent, false if it was present
+    bool insert(const TKey& key, const TValue& value);
+    // set() - Update the key only if it's present, false if it was absent
+    bool set(const TKey& key, const TValue& value);
+    bool lookup(const TKey& key, TValue& value) const;
+    bool erase(const TKey& key);
+    void clear();
+
+    // count() - A snapshot when other threads are writing
+    uint32_t count() const;
+    inline uint32_t numShards() const { return num_shards_; }
+
+  private:
+    typedef char CacheLinePad[CONCURRENT_HASH_MAP_CACHE_LINE_SIZE];
+
+    typedef enum {
+      BUCKET_EMPTY = 0,
+      BUCKET_FULL = 1,
+      BUCKET_ERASED = 2,
+    } BucketState;
+
+    // Any number of readers or one writer.  A waiting writer holds off new
+    // readers, so a steady stream of lookups can't starve it.
+    class ShardLock {
+    public:
+      ShardLock() { state_.store(0); }
+      void lockShared() const;
+      void unlockShared() const;
+      void lock() const;
+      void unlock() const;
+    private:
+      static const int WRITER = 1 << 30;
+      static const int WRITER_WAITING = 1 << 29;
+      mutable std::atomic<int> state_;  // Number of readers + flags above
+    };
+
+    struct Shard {
+      ShardLock lock;
+      uint32_t capacity;  // A power of 2
+      uint32_t count;
+      uint32_t num_erased;
+      uint8_t* state;  // BucketState
+      uint32_t* hash;  // Cached so probing and rehashing don't call hash_func
+      Pair<TKey, TValue>* table;
+      CacheLinePad pad;
+    };
+
+    uint32_t num_shards_;
+    uint32_t shard_shift_;  // 32 - log2(num_shards_)
+    Shard* shards_;
+    HashFunc hash_func_;
+
+    inline uint32_t hashKey(const TKey& key) const;
+    inline Shard& shardOf(const uint32_t hash) const {
+      return shards_[shard_shift_ < 32 ? hash >> shard_shift_ : 0];
+    }
+    // findBucket() - The key's bucket or -1.  REQUIRES: shard locked
+    int findBucket(const Shard& shard, const uint32_t hash,
+      const TKey& key) const;
+    // Grow (or purge tombstones) before an insert.  REQUIRES: shard locked
+    void reserveBucket(Shard& shard);
+    static void allocShard(Shard& shard, const uint32_t capacity);
+
+    // Non-copyable, non-assignable.
+    ConcurrentHashMap(const ConcurrentHashMap&);
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&);
+  };
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::ShardLock::lockShared() const {
+    while (true) {
+      int state = state_.load(std::memory_order_relaxed);
+      if ((state & (WRITER | WRITER_WAITING)) == 0 &&
+        state_.compare_exchange_weak(state, state + 1,
+        std::memory_order_acquire)) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::ShardLock::unlockShared() const {
+    state_.fetch_sub(1, std::memory_order_release);
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::ShardLock::lock() const {
+    while (true) {
+      int state = state_.load(std::memory_order_relaxed);
+      if ((state & ~WRITER_WAITING) == 0) {
+        // No readers or writer: take it (and clear our waiting flag, other
+        // waiting writers will set it again)
+        if (state_.compare_exchange_weak(state, WRITER,
+          std::memory_order_acquire)) {
+          return;
+        }
+      } else if ((state & WRITER_WAITING) == 0) {
+        state_.fetch_or(WRITER_WAITING, std::memory_order_relaxed);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::ShardLock::unlock() const {
+    state_.fetch_sub(WRITER, std::memory_order_release);
+  }
+
+  template <class TKey, class TValue>
+  ConcurrentHashMap<TKey, TValue>::ConcurrentHashMap(const uint32_t size,
+    HashFunc hash_func, const uint32_t num_shards) {
+    if (num_shards < 1 || num_shards > (1u << 16)) {
+      throw std::wruntime_error("ConcurrentHashMap::ConcurrentHashMap: "
+        "num_shards must be in [1, 2^16]");
+    }
+    hash_func_ = hash_func;
+    num_shards_ = 1;
+    shard_shift_ = 32;
+    while (num_shards_ < num_shards) {
+      num_shards_ <<= 1;
+      shard_shift_--;
+    }
+    // Max load is 0.5 (including tombstones), like HashMap
+    uint32_t capacity = 8;
+    while (capacity < 2 * (size / num_shards_ + 1)) {
+      capacity <<= 1;
+    }
+    shards_ = new Shard[num_shards_];
+    for (uint32_t i = 0; i < num_shards_; i++) {
+      allocShard(shards_[i], capacity);
+    }
+  }
+
+  template <class TKey, class TValue>
+  ConcurrentHashMap<TKey, TValue>::~ConcurrentHashMap() {
+    for (uint32_t i = 0; i < num_shards_; i++) {
+      delete[] shards_[i].state;
+      delete[] shards_[i].hash;
+      delete[] shards_[i].table;
+    }
+    delete[] shards_;
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::allocShard(Shard& shard,
+    const uint32_t capacity) {
+    shard.capacity = capacity;
+    shard.count = 0;
+    shard.num_erased = 0;
+    shard.state = new uint8_t[capacity];
+    memset(shard.state, BUCKET_EMPTY, capacity * sizeof(shard.state[0]));
+    shard.hash = new uint32_t[capacity];
+    shard.table = new Pair<TKey, TValue>[capacity];
+  }
+
+  template <class TKey, class TValue>
+  uint32_t ConcurrentHashMap<TKey, TValue>::hashKey(const TKey& key) const {
+    // Not every HashFunc mixes its bits well, so mix them again (the
+    // MurmurHash3 finalizer) before using the top ones for the shard and the
+    // bottom ones for the bucket.
+    uint32_t hash = hash_func_(MAX_UINT32, key);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+  }
+
+  template <class TKey, class TValue>
+  int ConcurrentHashMap<TKey, TValue>::findBucket(const Shard& shard,
+    const uint32_t hash, const TKey& key) const {
+    const uint32_t mask = shard.capacity - 1;
+    for (uint32_t i = 0; i < shard.capacity; i++) {
+      const uint32_t bucket = (hash + i) & mask;
+      if (shard.state[bucket] == BUCKET_EMPTY) {
+        return -1;
+      }
+      if (shard.state[bucket] == BUCKET_FULL && shard.hash[bucket] == hash &&
+        shard.table[bucket].first == key) {
+        return static_cast<int>(bucket);
+      }
+    }
+    return -1;
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::reserveBucket(Shard& shard) {
+    if (2 * (shard.count + shard.num_erased + 1) <= shard.capacity) {
+      return;
+    }
+    // Double if the live keys need it, otherwise just drop the tombstones
+    const uint32_t old_capacity = shard.capacity;
+    uint8_t* old_state = shard.state;
+    uint32_t* old_hash = shard.hash;
+    Pair<TKey, TValue>* old_table = shard.table;
+    allocShard(shard, 4 * (shard.count + 1) > old_capacity ?
+      2 * old_capacity : old_capacity);
+    const uint32_t mask = shard.capacity - 1;
+    for (uint32_t j = 0; j < old_capacity; j++) {
+      if (old_state[j] == BUCKET_FULL) {
+        uint32_t bucket = old_hash[j] & mask;
+        while (shard.state[bucket] != BUCKET_EMPTY) {
+          bucket = (bucket + 1) & mask;
+        }
+        shard.state[bucket] = BUCKET_FULL;
+        shard.hash[bucket] = old_hash[j];
+        shard.table[bucket] = old_table[j];
+        shard.count++;
+      }
+    }
+    delete[] old_state;
+    delete[] old_hash;
+    delete[] old_table;
+  }
+
+  template <class TKey, class TValue>
+  bool ConcurrentHashMap<TKey, TValue>::insert(const TKey& key,
+    const TValue& value) {
+    const uint32_t hash = hashKey(key);
+    Shard& shard = shardOf(hash);
+    shard.lock.lock();
+    if (findBucket(shard, hash, key) >= 0) {
+      shard.lock.unlock();
+      return false;
+    }
+    reserveBucket(shard);
+    const uint32_t mask = shard.capacity - 1;
+    uint32_t bucket = hash & mask;
+    while (shard.state[bucket] == BUCKET_FULL) {
+      bucket = (bucket + 1) & mask;
+    }
+    if (shard.state[bucket] == BUCKET_ERASED) {
+      shard.num_erased--;
+    }
+    shard.state[bucket] = BUCKET_FULL;
+    shard.hash[bucket] = hash;
+    shard.table[bucket].first = key;
+    shard.table[bucket].second = value;
+    shard.count++;
+    shard.lock.unlock();
+    return true;
+  }
+
+  template <class TKey, class TValue>
+  bool ConcurrentHashMap<TKey, TValue>::set(const TKey& key,
+    const TValue& value) {
+    const uint32_t hash = hashKey(key);
+    Shard& shard = shardOf(hash);
+    shard.lock.lock();
+    const int bucket = findBucket(shard, hash, key);
+    if (bucket >= 0) {
+      shard.table[bucket].second = value;
+    }
+    shard.lock.unlock();
+    return bucket >= 0;
+  }
+
+  template <class TKey, class TValue>
+  bool ConcurrentHashMap<TKey, TValue>::lookup(const TKey& key,
+    TValue& value) const {
+    const uint32_t hash = hashKey(key);
+    const Shard& shard = shardOf(hash);
+    shard.lock.lockShared();
+    const int bucket = findBucket(shard, hash, key);
+    if (bucket >= 0) {
+      value = shard.table[bucket].second;
+    }
+    shard.lock.unlockShared();
+    return bucket >= 0;
+  }
+
+  template <class TKey, class TValue>
+  bool ConcurrentHashMap<TKey, TValue>::erase(const TKey& key) {
+    const uint32_t hash = hashKey(key);
+    Shard& shard = shardOf(hash);
+    shard.lock.lock();
+    const int bucket = findBucket(shard, hash, key);
+    if (bucket >= 0) {
+      shard.state[bucket] = BUCKET_ERASED;
+      shard.count--;
+      shard.num_erased++;
+    }
+    shard.lock.unlock();
+    return bucket >= 0;
+  }
+
+  template <class TKey, class TValue>
+  void ConcurrentHashMap<TKey, TValue>::clear() {
+    for (uint32_t i = 0; i < num_shards_; i++) {
+      Shard& shard = shards_[i];
+      shard.lock.lock();
+      memset(shard.state, BUCKET_EMPTY, shard.capacity *
+        sizeof(shard.state[0]));
+      shard.count = 0;
+      shard.num_erased = 0;
+      shard.lock.unlock();
+    }
+  }
+
+  template <class TKey, class TValue>
+  uint32_t ConcurrentHashMap<TKey, TValue>::count() const {
+    uint32_t num = 0;
+    for (uint32_t i = 0; i < num_shards_; i++) {
+      shards_[i].lock.lockShared();
+      num += shards_[i].count;
+      shards_[i].lock.unlockShared();
+    }
+    return num;
+  }
+
+};  // namespace data_str
+};  // namespace jtil
@@ -0,0 +1,407 @@
+//
+//  flat_hash_map.h
+//
+//  An open addressing hash map that keeps one control byte per slot (like
+//  Abseil's "Swiss tables").  The control byte is EMPTY, ERASED, or for a
+//  full slot 7 bits of the key's hash.  Probing loads a group of 16 control
+//  bytes at once and compares them all against the key's 7 bits with SSE2,
+//  so a lookup usually compares just the one key that matches, and a miss
+//  usually ends at the first group.
+//
+//  Compared to HashMap the capacity is a power of 2 (no % by a prime), the
+//  max load is 7/8 rather than 1/2 and a slot needs a 1 byte tag rather than
+//  a bool, so a table takes roughly half the memory.  Keys can be erased:
+//  the slot becomes EMPTY if its group still has an EMPTY slot (no probe can
+//  have passed it), otherwise an ERASED tombstone that later inserts reuse
+//  and the next rehash drops.
+//
+//  The HashFunc is the same as HashMap's, it is called with size MAX_UINT32
+//  (to get the full 32 bit hash, see StringHash) and the result is mixed.
+//  The *Prehash functions take the result of hash(key), which (unlike
+//  HashMap's prehash) doesn't depend on the table size.
+//
+//  NOTE: Like HashMap, the map stores copies of the keys and values, and does
+//        NOT own what a pointer value points to.
+//
+
+#pragma once
+
+#include <cstring>  // For memset
+#include <algorithm>  // For std::swap
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define FLAT_HASH_MAP_SSE2
+#endif
+#if defined(_MSC_VER)
+  #include <intrin.h>  // For _BitScanForward
+#endif
+#include "jtil/math/math_types.h"  // for uint32_t, MAX_UINT32
+#include "jtil/data_str/pair.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+#define FLAT_HASH_MAP_GROUP_SIZE 16  // Control bytes probed at once
+
+namespace jtil {
+namespace data_str {
+
+  template <class TKey, class TValue>
+  class FlatHashMap {
+  public:
+    typedef uint32_t (*HashFunc) (const uint32_t size, const TKey& key);
+
+    // size - The number of keys that fit before the first rehash
+    FlatHashMap(const uint32_t size, HashFunc hash_func);
+    ~FlatHashMap();
+
+    inline uint32_t capacity() const { return capacity_; }
+    inline uint32_t count() const { return count_; }
+    inline float load() const {
+      return static_cast<float>(count_) / static_cast<float>(capacity_);
+    }
+
+    // hash() - The value the *Prehash functions take
+    uint32_t hash(const TKey& key) const;
+
+    // insert() - Add the key only if it's absent, false if it was present
+    bool insert(const TKey& key, const TValue& value);
+    bool insertPrehash(const uint32_t prehash, const TKey& key,
+      const TValue& value);
+    // set() - Update the key only if it's present, false if it was absent
+    bool set(const TKey& key, const TValue& value);
+    bool setPrehash(const uint32_t prehash, const TKey& key,
+      const TValue& value);
+    bool lookup(const TKey& key, TValue& value) const;
+    bool lookupPrehash(const uint32_t prehash, const TKey& key,
+      TValue& value) const;
+    bool erase(const TKey& key);
+    bool erasePrehash(const uint32_t prehash, const TKey& key);
+    void clear();  // O(capacity)
+    // reserve() - Grow (at most once) so that count keys fit without a rehash
+    void reserve(const uint32_t count);
+
+    // The slots, table()[i] holds a key if full(i) (ie, to iterate)
+    inline const Pair<TKey, TValue>* table() const { return table_; }
+    inline bool full(const uint32_t i) const { return ctrl_[i] >= 0; }
+
+  private:
+    static const int8_t CTRL_EMPTY = -128;
+    static const int8_t CTRL_ERASED = -2;
+
+    uint32_t capacity_;  // A power of 2, at least FLAT_HASH_MAP_GROUP_SIZE
+    uint32_t count_;
+    uint32_t growth_left_;  // EMPTY slots we can fill before the max load
+    int8_t* ctrl_;  // capacity_ control bytes, 16 byte aligned
+    int8_t* ctrl_alloc_;
+    Pair<TKey, TValue>* table_;
+    HashFunc hash_func_;
+
+    // Bit i is set if group[i] == tag
+    static inline uint32_t matchMask(const int8_t* group, const int8_t tag);
+    // Bit i is set if group[i] is EMPTY or ERASED
+    static inline uint32_t freeMask(const int8_t* group);
+    static inline uint32_t lowestBit(const uint32_t mask);
+    static inline int8_t tagOf(const uint32_t hash) {
+      return static_cast<int8_t>(hash & 0x7f);
+    }
+    inline uint32_t firstGroup(const uint32_t hash) const {
+      return (hash >> 7) & (capacity_ / FLAT_HASH_MAP_GROUP_SIZE - 1);
+    }
+
+    // findSlot() - The key's slot or -1
+    int findSlot(const uint32_t hash, const TKey& key) const;
+    // findFreeSlot() - The first EMPTY or ERASED slot on the key's probe
+    // sequence (there always is one, the load is at most 7/8)
+    uint32_t findFreeSlot(const uint32_t hash) const;
+    // capacityFor() - The smallest capacity that fits count keys
+    static uint32_t capacityFor(const uint32_t count);
+    void allocTable(const uint32_t capacity);
+    void rehash(const uint32_t new_capacity);
+
+    // Non-copyable, non-assignable.
+    FlatHashMap(const FlatHashMap&);
+    FlatHashMap& operator=(const FlatHashMap&);
+  };
+
+  template <class TKey, class TValue>
+  FlatHashMap<TKey, TValue>::FlatHashMap(const uint32_t size,
+    HashFunc hash_func) {
+    hash_func_ = hash_func;
+    allocTable(capacityFor(size));
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::capacityFor(const uint32_t count) {
+    uint32_t capacity = FLAT_HASH_MAP_GROUP_SIZE;
+    while (static_cast<uint64_t>(capacity) * 7 / 8 < count) {
+      if (capacity >= (1u << 31)) {
+        throw std::wruntime_error("FlatHashMap::capacityFor: too many keys");
+      }
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  template <class TKey, class TValue>
+  FlatHashMap<TKey, TValue>::~FlatHashMap() {
+    delete[] ctrl_alloc_;
+    delete[] table_;
+  }
+
+  template <class TKey, class TValue>
+  void FlatHashMap<TKey, TValue>::allocTable(const uint32_t capacity) {
+    capacity_ = capacity;
+    count_ = 0;
+    growth_left_ = capacity - capacity / 8;
+    ctrl_alloc_ = new int8_t[capacity + FLAT_HASH_MAP_GROUP_SIZE - 1];
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ctrl_alloc_);
+    ctrl_ = ctrl_alloc_ + ((FLAT_HASH_MAP_GROUP_SIZE -
+      addr % FLAT_HASH_MAP_GROUP_SIZE) % FLAT_HASH_MAP_GROUP_SIZE);
+    memset(ctrl_, CTRL_EMPTY, capacity);
+    table_ = new Pair<TKey, TValue>[capacity];
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::matchMask(const int8_t* group,
+    const int8_t tag) {
+#ifdef FLAT_HASH_MAP_SSE2
+    const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(
+      group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl,
+      _mm_set1_epi8(tag))));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < FLAT_HASH_MAP_GROUP_SIZE; i++) {
+      mask |= (group[i] == tag ? 1u : 0u) << i;
+    }
+    return mask;
+#endif
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::freeMask(const int8_t* group) {
+#ifdef FLAT_HASH_MAP_SSE2
+    // EMPTY and ERASED are the only control bytes < -1
+    const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(
+      group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(
+      _mm_set1_epi8(-1), ctrl)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < FLAT_HASH_MAP_GROUP_SIZE; i++) {
+      mask |= (group[i] < -1 ? 1u : 0u) << i;
+    }
+    return mask;
+#endif
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::lowestBit(const uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::hash(const TKey& key) const {
+    // Mix the bits (the MurmurHash3 finalizer, like ConcurrentHashMap): the
+    // low 7 bits become the tag and the rest pick the group
+    uint32_t hash = hash_func_(MAX_UINT32, key);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+  }
+
+  template <class TKey, class TValue>
+  int FlatHashMap<TKey, TValue>::findSlot(const uint32_t hash,
+    const TKey& key) const {
+    const int8_t tag = tagOf(hash);
+    const uint32_t num_groups = capacity_ / FLAT_HASH_MAP_GROUP_SIZE;
+    uint32_t group = firstGroup(hash);
+    // Triangular probing visits every group once when num_groups is a power
+    // of 2
+    for (uint32_t i = 1; i <= num_groups; i++) {
+      const int8_t* ctrl = ctrl_ + group * FLAT_HASH_MAP_GROUP_SIZE;
+      uint32_t match = matchMask(ctrl, tag);
+      while (match != 0) {
+        const uint32_t slot = group * FLAT_HASH_MAP_GROUP_SIZE +
+          lowestBit(match);
+        if (table_[slot].first == key) {
+          return static_cast<int>(slot);
+        }
+        match &= match - 1;
+      }
+      if (matchMask(ctrl, CTRL_EMPTY) != 0) {
+        return -1;  // The key would have gone in this group
+      }
+      group = (group + i) & (num_groups - 1);
+    }
+    return -1;
+  }
+
+  template <class TKey, class TValue>
+  uint32_t FlatHashMap<TKey, TValue>::findFreeSlot(const uint32_t hash)
+    const {
+    const uint32_t num_groups = capacity_ / FLAT_HASH_MAP_GROUP_SIZE;
+    uint32_t group = firstGroup(hash);
+    for (uint32_t i = 1; i <= num_groups; i++) {
+      const uint32_t mask = freeMask(ctrl_ + group *
+        FLAT_HASH_MAP_GROUP_SIZE);
+      if (mask != 0) {
+        return group * FLAT_HASH_MAP_GROUP_SIZE + lowestBit(mask);
+      }
+      group = (group + i) & (num_groups - 1);
+    }
+    throw std::wruntime_error("FlatHashMap::findFreeSlot: table full");
+  }
+
+  template <class TKey, class TValue>
+  void FlatHashMap<TKey, TValue>::rehash(const uint32_t new_capacity) {
+    const uint32_t old_capacity = capacity_;
+    int8_t* old_ctrl = ctrl_;
+    int8_t* old_ctrl_alloc = ctrl_alloc_;
+    Pair<TKey, TValue>* old_table = table_;
+    const uint32_t old_count = count_;
+    allocTable(new_capacity);
+    for (uint32_t i = 0; i < old_capacity; i++) {
+      if (old_ctrl[i] >= 0) {
+        const uint32_t hash_i = hash(old_table[i].first);
+        const uint32_t slot = findFreeSlot(hash_i);
+        ctrl_[slot] = tagOf(hash_i);
+        std::swap(table_[slot].first, old_table[i].first);
+        std::swap(table_[slot].second, old_table[i].second);
+      }
+    }
+    count_ = old_count;
+    growth_left_ -= count_;
+    delete[] old_ctrl_alloc;
+    delete[] old_table;
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::insert(const TKey& key,
+    const TValue& value) {
+    return insertPrehash(hash(key), key, value);
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::insertPrehash(const uint32_t prehash,
+    const TKey& key, const TValue& value) {
+    if (findSlot(prehash, key) >= 0) {
+      return false;
+    }
+    uint32_t slot = findFreeSlot(prehash);
+    if (ctrl_[slot] == CTRL_EMPTY && growth_left_ == 0) {
+      // Double if the live keys need it, otherwise just drop the tombstones
+      uint32_t new_capacity = capacity_;
+      if (static_cast<uint64_t>(count_ + 1) * 16 >
+        static_cast<uint64_t>(capacity_) * 7) {
+        if (capacity_ >= (1u << 31)) {
+          throw std::wruntime_error("FlatHashMap::insert: too many keys");
+        }
+        new_capacity *= 2;
+      }
+      rehash(new_capacity);
+      slot = findFreeSlot(prehash);
+    }
+    if (ctrl_[slot] == CTRL_EMPTY) {
+      growth_left_--;  // A reused tombstone doesn't add to the load
+    }
+    ctrl_[slot] = tagOf(prehash);
+    table_[slot].first = key;
+    table_[slot].second = value;
+    count_++;
+    return true;
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::set(const TKey& key, const TValue& value) {
+    return setPrehash(hash(key), key, value);
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::setPrehash(const uint32_t prehash,
+    const TKey& key, const TValue& value) {
+    const int slot = findSlot(prehash, key);
+    if (slot < 0) {
+      return false;
+    }
+    table_[slot].second = value;
+    return true;
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::lookup(const TKey& key,
+    TValue& value) const {
+    return lookupPrehash(hash(key), key, value);
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::lookupPrehash(const uint32_t prehash,
+    const TKey& key, TValue& value) const {
+    const int slot = findSlot(prehash, key);
+    if (slot < 0) {
+      return false;
+    }
+    value = table_[slot].second;
+    return true;
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::erase(const TKey& key) {
+    return erasePrehash(hash(key), key);
+  }
+
+  template <class TKey, class TValue>
+  bool FlatHashMap<TKey, TValue>::erasePrehash(const uint32_t prehash,
+    const TKey& key) {
+    const int slot = findSlot(prehash, key);
+    if (slot < 0) {
+      return false;
+    }
+    // If the group has an EMPTY slot, probes for other keys stop here
+    // anyway, so the slot can be EMPTY too
+    const int8_t* group = ctrl_ + (slot & ~(FLAT_HASH_MAP_GROUP_SIZE - 1));
+    if (matchMask(group, CTRL_EMPTY) != 0) {
+      ctrl_[slot] = CTRL_EMPTY;
+      growth_left_++;
+    } else {
+      ctrl_[slot] = CTRL_ERASED;
+    }
+    // Free what the key and value hold
+    table_[slot].first = TKey();
+    table_[slot].second = TValue();
+    count_--;
+    return true;
+  }
+
+  template <class TKey, class TValue>
+  void FlatHashMap<TKey, TValue>::reserve(const uint32_t count) {
+    const uint32_t new_capacity = capacityFor(count);
+    if (new_capacity > capacity_) {
+      rehash(new_capacity);
+    }
+  }
+
+  template <class TKey, class TValue>
+  void FlatHashMap<TKey, TValue>::clear() {
+    // Free what the keys and values hold, as erase() does
+    for (uint32_t i = 0; i < capacity_; i++) {
+      if (ctrl_[i] >= 0) {
+        table_[i].first = TKey();
+        table_[i].second = TValue();
+      }
+    }
+    memset(ctrl_, CTRL_EMPTY, capacity_);
+    count_ = 0;
+    growth_left_ = capacity_ - capacity_ / 8;
+  }
+
+};  // namespace data_str
+};  // namespace jtil
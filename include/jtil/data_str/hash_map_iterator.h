@@ -0,0 +1,94 @@
+//
+//  hash_map_iterator.h
+//
+//  A forward iterator over the full buckets of a HashMap or HashMapManaged,
+//  in bucket order:
+//
+//    HashMap<string, uint32_t>::const_iterator it;
+//    for (it = hm.begin(); it != hm.end(); ++it) {
+//      cout << it->first << " = " << it->second << endl;
+//    }
+//
+//  An iterator converts to a const_iterator, and the two can be compared.
+//  Don't change it->first through a (non-const) iterator, the key's bucket
+//  depends on it.  An insert can rehash, which invalidates every iterator.
+//
+
+#pragma once
+
+#include <cstddef>  // For ptrdiff_t
+#include <iterator>  // For std::forward_iterator_tag
+#include <type_traits>  // For std::remove_const, std::enable_if
+#include "jtil/math/math_types.h"  // for uint32_t
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+namespace jtil {
+namespace data_str {
+
+  // TPair is Pair<TKey, TValue> or const Pair<TKey, TValue>
+  template <typename TPair>
+  class HashMapIterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<TPair>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef TPair* pointer;
+    typedef TPair& reference;
+
+    HashMapIterator() : table_(NULL), bucket_full_(NULL), index_(0),
+      size_(0) { }
+    // The first full bucket at or after index
+    HashMapIterator(TPair* table, const bool* bucket_full,
+      const uint32_t index, const uint32_t size) : table_(table),
+      bucket_full_(bucket_full), index_(index), size_(size) {
+      skipEmpty();
+    }
+    // iterator -> const_iterator (only enabled when TPair is const U)
+    template <typename U>
+    HashMapIterator(const HashMapIterator<U>& other,
+      typename std::enable_if<std::is_same<TPair, const U>::value>::type* =
+      NULL) : table_(other.table_), bucket_full_(other.bucket_full_),
+      index_(other.index_), size_(other.size_) { }
+
+    inline reference operator*() const { return table_[index_]; }
+    inline pointer operator->() const { return &table_[index_]; }
+    inline HashMapIterator& operator++() {
+      index_++;
+      skipEmpty();
+      return *this;
+    }
+    inline HashMapIterator operator++(int) {
+      HashMapIterator ret(*this);
+      ++(*this);
+      return ret;
+    }
+    // With either constness on each side
+    template <typename U>
+    inline bool operator==(const HashMapIterator<U>& other) const {
+      return table_ == other.table_ && index_ == other.index_;
+    }
+    template <typename U>
+    inline bool operator!=(const HashMapIterator<U>& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    template <typename U> friend class HashMapIterator;
+
+    TPair* table_;
+    const bool* bucket_full_;
+    uint32_t index_;
+    uint32_t size_;
+
+    inline void skipEmpty() {
+      while (index_ < size_ && !bucket_full_[index_]) {
+        index_++;
+      }
+    }
+  };
+
+};  // namespace data_str
+};  // namespace jtil
@@ -11,6 +11,9 @@
 //  This is a hash_map so it is a set of key and value pairs.
 //  WORKS BEST IF SIZE IS A PRIME NUMBER, ESPECIALLY WITH A MOD HASH FUNCTION
 //
+//  Like HashMap, each full bucket also keeps its key's prehash (compared before
+//  the key), and reserve() / build() size the table once up front.
+//
 //  NOTE: When insert is called, HashMap will make a copy of the input element's
 //        value field (Hashmap owns the copy.).
 //        IMPORTANT:  When the <TValue> is a pointer (ie <int*>), then ownership
@@ -21,12 +24,17 @@
 #pragma once
 
 #include <cstring>  // For gcc builds, get rid of fpermissive compile error
+#include <algorithm>  // For std::sort, std::swap
+#include <utility>  // For std::move, std::forward
 #include <stdio.h>  // For printf()
 #include "jtil/math/math_types.h"  // for uint
 #include "jtil/math/math_base.h"  // for NextPrime
 #include "jtil/data_str/pair.h"
+#include "jtil/data_str/hash_map_iterator.h"
 #include "jtil/exceptions/wruntime_error.h"
 
+#define HASH_MAP_MANAGED_MOVED_FROM_SIZE 11  // Table size of a moved from map
+
 #ifndef NULL
 #define NULL 0
 #endif
@@ -38,9 +46,16 @@ namespace data_str {
   public:
     // Function pointer for the hash function
     typedef uint32_t (*HashFunc) (const uint32_t size, const TKey& key);
+    typedef HashMapIterator<Pair<TKey, TValue> > iterator;
+    typedef HashMapIterator<const Pair<TKey, TValue> > const_iterator;
 
     HashMapManaged(const uint32_t size, HashFunc hash_func);
     ~HashMapManaged();
+    // Move construction and assignment take other's table and leave other
+    // empty, with a new HASH_MAP_MANAGED_MOVED_FROM_SIZE table (so it can be
+    // reused)
+    HashMapManaged(HashMapManaged&& other);
+    HashMapManaged& operator=(HashMapManaged&& other);
 
     inline uint32_t size() const { return size_; }
     inline uint32_t count() const { return count_; }
@@ -48,6 +63,12 @@ namespace data_str {
     bool insert(const TKey& key, const TValue& value);
     bool insertPrehash(const uint32_t prehash, const TKey& key, 
       const TValue& value);
+    // Versions that move the key and value in (if the key is absent)
+    bool insert(TKey&& key, TValue&& value);
+    bool insertPrehash(const uint32_t prehash, TKey&& key, TValue&& value);
+    // emplace() - Insert TValue(args...), constructed even if the key exists
+    template <typename... Args>
+    bool emplace(const TKey& key, Args&&... args);
     // REMOVAL MIGHT BE BROKEN AND NEEDS TO BE CHECKED!!!
     // DO I NEED TO MARK FORMALLY OCCUPIED?  PUT TOGETHER A TEST CASE FOR THIS.
     //bool remove(const TKey& key);
@@ -56,22 +77,47 @@ namespace data_str {
     bool lookupPrehash(const uint32_t prehash, const TKey& key, TValue& value)
       const;
     void clear();  // O(m) - m is the number of buckets (potentially slow)
+    // reserve() - Grow (at most once) so that count keys fit without a rehash
+    void reserve(const uint32_t count);
+    // build() - Insert n keys, growing the table once and filling it in
+    // bucket order.  Like insert(), a key that is already present is
+    // skipped.  Returns the number of keys inserted.
+    uint32_t build(const TKey* keys, const TValue* values, const uint32_t n);
 
     inline const Pair<TKey, TValue>* table() { return table_; }
     inline const bool* bucket_full() { return bucket_full_; }
 
+    inline iterator begin() {
+      return iterator(table_, bucket_full_, 0, size_);
+    }
+    inline iterator end() {
+      return iterator(table_, bucket_full_, size_, size_);
+    }
+    inline const_iterator begin() const {
+      return const_iterator(table_, bucket_full_, 0, size_);
+    }
+    inline const_iterator end() const {
+      return const_iterator(table_, bucket_full_, size_, size_);
+    }
+
   protected:
     uint32_t size_;
     uint32_t count_;
     Pair<TKey, TValue>* table_;
     bool* bucket_full_;  // Array of booleans telling us if an item exists there
+    uint32_t* hashes_;  // The prehash of each full bucket
     float load_factor_;
     static const float max_load_;
 
     HashFunc hash_func_;
     static uint32_t linearProbeFunc(const uint32_t hash, 
       const uint32_t probe_index, const uint32_t size);
-    void rehash();
+    void rehash(const uint32_t new_size);
+    void swap(HashMapManaged& other);
+    void allocate(const uint32_t size);  // An empty table
+    void release();  // Frees the table
+    template <typename K, typename V>
+    bool insertImpl(const uint32_t prehash, K&& key, V&& value);
 
     // Non-copyable, non-assignable.
     HashMapManaged(HashMapManaged&);
@@ -91,66 +137,150 @@ namespace data_str {
   HashMapManaged<TKey, TValue>::HashMapManaged(const uint32_t size, 
     HashFunc hash_func) {
     hash_func_ = hash_func;
-    load_factor_ = 0;
-    count_ = 0;
-    size_ = size;
-    if (size_ < 1) {
+    if (size < 1) {
       throw std::wruntime_error(L"HashMapManaged<TKey, TValue>"
         L"::HashMapManaged: size < 1");
     }
+    allocate(size);
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue>::allocate(const uint32_t size) {
+    size_ = size;
+    count_ = 0;
+    load_factor_ = 0;
     table_ = new Pair<TKey, TValue>[size_];
     bucket_full_ = new bool[size_];
     memset(bucket_full_, false, size_*sizeof(bucket_full_[0]));
+    hashes_ = new uint32_t[size_];
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue>::release() {
+    delete[] table_;
+    delete[] bucket_full_;
+    delete[] hashes_;
+    table_ = NULL;
+    bucket_full_ = NULL;
+    hashes_ = NULL;
+  };
+
+  template <class TKey, class TValue>
+  HashMapManaged<TKey, TValue>::HashMapManaged(HashMapManaged&& other) {
+    size_ = 0;
+    count_ = 0;
+    table_ = NULL;
+    bucket_full_ = NULL;
+    hashes_ = NULL;
+    load_factor_ = 0;
+    hash_func_ = other.hash_func_;
+    swap(other);
+    other.allocate(HASH_MAP_MANAGED_MOVED_FROM_SIZE);
   };
 
   template <class TKey, class TValue>
-  void HashMapManaged<TKey, TValue>::rehash() {
+  HashMapManaged<TKey, TValue>& HashMapManaged<TKey, TValue>::operator=(
+    HashMapManaged&& other) {
+    if (this != &other) {
+      release();
+      size_ = 0;
+      swap(other);
+      other.hash_func_ = hash_func_;
+      other.allocate(HASH_MAP_MANAGED_MOVED_FROM_SIZE);
+    }
+    return *this;
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue>::swap(HashMapManaged& other) {
+    std::swap(size_, other.size_);
+    std::swap(count_, other.count_);
+    std::swap(table_, other.table_);
+    std::swap(bucket_full_, other.bucket_full_);
+    std::swap(hashes_, other.hashes_);
+    std::swap(load_factor_, other.load_factor_);
+    std::swap(hash_func_, other.hash_func_);
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue>::rehash(const uint32_t new_size) {
     // printf("HashMap rehash\n");
-    uint32_t new_size = size_*2;
-    new_size = static_cast<uint32_t>(math::NextPrime(new_size));
     Pair<TKey, TValue>* new_table = new Pair<TKey, TValue>[new_size];
     bool* new_bucket_full = new bool[new_size];
     memset(new_bucket_full, false, new_size*sizeof(new_bucket_full[0]));
-    // manually insert all the old key/value pairs into the hash table
+    uint32_t* new_hashes = new uint32_t[new_size];
+    // Move all the old key/value pairs into the new table (swapping them
+    // across saves copying keys like std::string)
     for (uint32_t j = 0; j < size_; j ++) {
       if (bucket_full_[j]) {
-        TKey curKey = table_[j].first;
-        TValue curValue = table_[j].second;
+        const uint32_t prehash = hash_func_(new_size, table_[j].first);
         bool value_inserted = false;
-        // Now insert this key/value pair
         for (uint32_t i = 0; i < new_size; i ++) {
-          uint32_t hash = linearProbeFunc(hash_func_(new_size, curKey), i, 
-            new_size);
+          uint32_t hash = linearProbeFunc(prehash, i, new_size);
           if (!new_bucket_full[hash]) {
             new_bucket_full[hash] = true;
-            new_table[hash].first = curKey;
-            new_table[hash].second = curValue;
+            new_hashes[hash] = prehash;
+            std::swap(new_table[hash].first, table_[j].first);
+            std::swap(new_table[hash].second, table_[j].second);
             value_inserted = true;
             break;
           }
-        }  // end for (uint32_t i = 0; i < size_; i ++)
+        }  // end for (uint32_t i = 0; i < new_size; i ++)
         if (!value_inserted) {
           printf("HashMapManaged<TKey, TValue>::rehash - Couldn't insert a ");
           printf("value!  This shouldn't happen.  Check hash table logic.\n");
           throw std::wruntime_error("HashMap::rehash: insert failed");
         }
-      }  // end if (bucket_full_[i])
+      }  // end if (bucket_full_[j])
     }
     size_ = new_size;
     delete[] table_;
     delete[] bucket_full_;
+    delete[] hashes_;
     table_ = new_table;
     bucket_full_ = new_bucket_full;
+    hashes_ = new_hashes;
+    load_factor_ = static_cast<float>(count_) / static_cast<float>(size_);
   };
 
   template <class TKey, class TValue>
-  HashMapManaged<TKey, TValue>::~HashMapManaged() {
-    if (table_) {
-      delete[] table_;
+  void HashMapManaged<TKey, TValue>::reserve(const uint32_t count) {
+    // The load must stay <= max_load_ (0.5) once count keys are in
+    const uint64_t min_size = static_cast<uint64_t>(count) * 2;
+    if (min_size > size_) {
+      rehash(static_cast<uint32_t>(math::NextPrime(
+        static_cast<std::size_t>(min_size))));
     }
-    if (bucket_full_) {
-      delete[] bucket_full_;
+  };
+
+  template <class TKey, class TValue>
+  uint32_t HashMapManaged<TKey, TValue>::build(const TKey* keys,
+    const TValue* values, const uint32_t n) {
+    reserve(count_ + n);
+    // Sort the keys by prehash (bucket << 32 | index) so the table is
+    // written front to back.  Equal keys keep their order, so the first
+    // one wins like with n insert() calls.
+    uint64_t* order = new uint64_t[n];
+    for (uint32_t i = 0; i < n; i++) {
+      const uint32_t prehash = hash_func_(size_, keys[i]);
+      order[i] = (static_cast<uint64_t>(prehash) << 32) | i;
     }
+    std::sort(order, order + n);
+    uint32_t num_inserted = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      const uint32_t j = static_cast<uint32_t>(order[i] & 0xffffffff);
+      if (insertPrehash(static_cast<uint32_t>(order[i] >> 32), keys[j],
+        values[j])) {
+        num_inserted++;
+      }
+    }
+    delete[] order;
+    return num_inserted;
+  };
+
+  template <class TKey, class TValue>
+  HashMapManaged<TKey, TValue>::~HashMapManaged() {
+    release();
   };
 
   template <class TKey, class TValue>
@@ -175,24 +305,53 @@ namespace data_str {
   template <class TKey, class TValue>
   bool HashMapManaged<TKey, TValue>::insertPrehash(const uint32_t prehash, 
     const TKey& key, const TValue& value) {
+    return insertImpl(prehash, key, value);
+  };
+
+  template <class TKey, class TValue>
+  bool HashMapManaged<TKey, TValue>::insert(TKey&& key, TValue&& value) {
+    const uint32_t hash = hash_func_(size_, key);
+    return insertImpl(hash, std::move(key), std::move(value));
+  };
+
+  template <class TKey, class TValue>
+  bool HashMapManaged<TKey, TValue>::insertPrehash(const uint32_t prehash,
+    TKey&& key, TValue&& value) {
+    return insertImpl(prehash, std::move(key), std::move(value));
+  };
+
+  template <class TKey, class TValue>
+  template <typename... Args>
+  bool HashMapManaged<TKey, TValue>::emplace(const TKey& key,
+    Args&&... args) {
+    return insertImpl(hash_func_(size_, key), key,
+      TValue(std::forward<Args>(args)...));
+  };
+
+  template <class TKey, class TValue>
+  template <typename K, typename V>
+  bool HashMapManaged<TKey, TValue>::insertImpl(const uint32_t prehash,
+    K&& key, V&& value) {
     // keep trying to insert until the table is full.  We're doing linear probe
     // http://en.wikipedia.org/wiki/Linear_probing
     for (uint32_t i = 0; i < size_; i ++) {
       uint32_t hash = linearProbeFunc(prehash, i, size_);
       if (!bucket_full_[hash]) {
         bucket_full_[hash] = true;
-        table_[hash].first = key;
-        table_[hash].second = value;
+        hashes_[hash] = prehash;
+        table_[hash].first = std::forward<K>(key);
+        table_[hash].second = std::forward<V>(value);
         count_++;
         load_factor_ = static_cast<float>(count_) / static_cast<float>(size_);
         while (load_factor_ > max_load_) {
-          rehash();
+          rehash(static_cast<uint32_t>(math::NextPrime(size_ * 2)));
           load_factor_ = static_cast<float>(count_) / 
             static_cast<float>(size_);
         }
         return true;
       } else {
-        if (table_[hash].first == key)  // Key already exists
+        // Key already exists
+        if (hashes_[hash] == prehash && table_[hash].first == key)
           return false;
       }
     }
@@ -240,7 +399,7 @@ namespace data_str {
       if (!bucket_full_[hash]) {
         return false;
       } else {
-        if (table_[hash].first == key) {
+        if (hashes_[hash] == prehash && table_[hash].first == key) {
           value = table_[hash].second;
           return true;
         }
@@ -262,8 +421,15 @@ namespace data_str {
     // Function pointer for the hash function
     typedef uint32_t (*HashFunc) (const uint32_t size, const TKey& key);
 
+    typedef HashMapIterator<Pair<TKey, TValue*> > iterator;
+    typedef HashMapIterator<const Pair<TKey, TValue*> > const_iterator;
+
     HashMapManaged<TKey, TValue*>(const uint32_t size, HashFunc hash_func);
     ~HashMapManaged<TKey, TValue*>();
+    // Move construction and assignment take other's table (and values) and
+    // leave other empty, with a new HASH_MAP_MANAGED_MOVED_FROM_SIZE table
+    HashMapManaged(HashMapManaged&& other);
+    HashMapManaged& operator=(HashMapManaged&& other);
 
     inline uint32_t size() const { return size_; }
     inline uint32_t count() const { return count_; }
@@ -271,6 +437,13 @@ namespace data_str {
     bool insert(const TKey& key, TValue* value);
     bool insertPrehash(const uint32_t prehash, const TKey& key, 
       TValue* value);
+    // Versions that move the key in (if it is absent)
+    bool insert(TKey&& key, TValue* value);
+    bool insertPrehash(const uint32_t prehash, TKey&& key, TValue* value);
+    // emplace() - Insert new TValue(args...), only constructed (and owned)
+    // if the key is absent
+    template <typename... Args>
+    bool emplace(const TKey& key, Args&&... args);
     // REMOVAL MIGHT BE BROKEN AND NEEDS TO BE CHECKED!!!
     // DO I NEED TO MARK FORMALLY OCCUPIED?  PUT TOGETHER A TEST CASE FOR THIS.
     //bool remove(const TKey& key);
@@ -279,22 +452,48 @@ namespace data_str {
     bool lookupPrehash(const uint32_t prehash, const TKey& key, TValue*& value)
       const;
     void clear();  // O(m) - m is the number of buckets (potentially slow)
+    // reserve() - Grow (at most once) so that count keys fit without a rehash
+    void reserve(const uint32_t count);
+    // build() - Insert n keys, growing the table once and filling it in
+    // bucket order.  Like insert(), a key that is already present is
+    // skipped (and its value is NOT owned by the map, the caller must delete
+    // it).  Returns the number of keys inserted.
+    uint32_t build(const TKey* keys, TValue* const* values, const uint32_t n);
 
     inline const Pair<TKey, TValue*>* table() { return table_; }
     inline const bool* bucket_full() { return bucket_full_; }
 
+    inline iterator begin() {
+      return iterator(table_, bucket_full_, 0, size_);
+    }
+    inline iterator end() {
+      return iterator(table_, bucket_full_, size_, size_);
+    }
+    inline const_iterator begin() const {
+      return const_iterator(table_, bucket_full_, 0, size_);
+    }
+    inline const_iterator end() const {
+      return const_iterator(table_, bucket_full_, size_, size_);
+    }
+
   private:
     uint32_t size_;
     uint32_t count_;
     Pair<TKey, TValue*>* table_;
     bool* bucket_full_;  // Array of booleans telling us if an item exists
+    uint32_t* hashes_;  // The prehash of each full bucket
     float load_factor_;
     static const float max_load_;
 
     HashFunc hash_func_;
     static uint32_t linearProbeFunc(const uint32_t hash, 
       const uint32_t probe_index, const uint32_t size);
-    void rehash();
+    void rehash(const uint32_t new_size);
+    void swap(HashMapManaged& other);
+    void allocate(const uint32_t size);  // An empty table
+    void release();  // Deletes the values and frees the table
+    template <typename K>
+    bool insertImpl(const uint32_t prehash, K&& key, TValue* value);
 
     // Non-copyable, non-assignable.
     HashMapManaged(HashMapManaged&);
@@ -314,82 +513,166 @@ namespace data_str {
   HashMapManaged<TKey, TValue*>::HashMapManaged(const uint32_t size, 
     HashFunc hash_func) {
     hash_func_ = hash_func;
-    load_factor_ = 0;
-    count_ = 0;
-    size_ = size;
-    if (size_ < 1) {
+    if (size < 1) {
       throw std::wruntime_error(L"HashMapManaged<TKey, TValue*>"
         L"::HashMapManaged: size < 1");
     }
+    allocate(size);
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue*>::allocate(const uint32_t size) {
+    size_ = size;
+    count_ = 0;
+    load_factor_ = 0;
     table_ = new Pair<TKey, TValue*>[size_];
     for (uint32_t i = 0; i < size_; i ++) {
       table_[i].second = NULL;
     }
     bucket_full_ = new bool[size_];
     memset(bucket_full_, false, size_*sizeof(bucket_full_[0]));
+    hashes_ = new uint32_t[size_];
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue*>::release() {
+    if (table_ && bucket_full_) {
+      for (uint32_t i = 0; i < size_; i ++) {
+        if (bucket_full_[i]) {
+          if (table_[i].second != NULL) {
+            delete table_[i].second;
+            table_[i].second = NULL;
+          }
+        }
+      }
+    }
+    delete[] table_;
+    delete[] bucket_full_;
+    delete[] hashes_;
+    table_ = NULL;
+    bucket_full_ = NULL;
+    hashes_ = NULL;
+  };
+
+  template <class TKey, class TValue>
+  HashMapManaged<TKey, TValue*>::HashMapManaged(HashMapManaged&& other) {
+    size_ = 0;
+    count_ = 0;
+    table_ = NULL;
+    bucket_full_ = NULL;
+    hashes_ = NULL;
+    load_factor_ = 0;
+    hash_func_ = other.hash_func_;
+    swap(other);
+    other.allocate(HASH_MAP_MANAGED_MOVED_FROM_SIZE);
   };
 
   template <class TKey, class TValue>
-  void HashMapManaged<TKey, TValue*>::rehash() {
+  HashMapManaged<TKey, TValue*>& HashMapManaged<TKey, TValue*>::operator=(
+    HashMapManaged&& other) {
+    if (this != &other) {
+      release();
+      size_ = 0;
+      swap(other);
+      other.hash_func_ = hash_func_;
+      other.allocate(HASH_MAP_MANAGED_MOVED_FROM_SIZE);
+    }
+    return *this;
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue*>::swap(HashMapManaged& other) {
+    std::swap(size_, other.size_);
+    std::swap(count_, other.count_);
+    std::swap(table_, other.table_);
+    std::swap(bucket_full_, other.bucket_full_);
+    std::swap(hashes_, other.hashes_);
+    std::swap(load_factor_, other.load_factor_);
+    std::swap(hash_func_, other.hash_func_);
+  };
+
+  template <class TKey, class TValue>
+  void HashMapManaged<TKey, TValue*>::rehash(const uint32_t new_size) {
     // printf("HashMapManaged rehash\n");
-    uint32_t new_size = size_*2;
-    new_size = static_cast<uint32_t>(math::NextPrime(new_size));
     Pair<TKey, TValue*>* new_table = new Pair<TKey, TValue*>[new_size];
     for (uint32_t i = 0; i < new_size; i ++) {
       new_table[i].second = NULL;
     }
     bool* new_bucket_full = new bool[new_size];
     memset(new_bucket_full, false, new_size*sizeof(new_bucket_full[0]));
-    // manually insert all the old key/value pairs into the hash table
+    uint32_t* new_hashes = new uint32_t[new_size];
+    // Move all the old key/value pairs into the new table (swapping them
+    // across saves copying keys like std::string)
     for (uint32_t j = 0; j < size_; j ++) {
       if (bucket_full_[j]) {
-        TKey curKey = table_[j].first;
-        TValue* curValue = table_[j].second;
+        const uint32_t prehash = hash_func_(new_size, table_[j].first);
         bool value_inserted = false;
-        // Now insert this key/value pair
         for (uint32_t i = 0; i < new_size; i ++) {
-          uint32_t hash = linearProbeFunc(hash_func_(new_size, curKey), i, 
-            new_size);
+          uint32_t hash = linearProbeFunc(prehash, i, new_size);
           if (!new_bucket_full[hash]) {
             new_bucket_full[hash] = true;
-            new_table[hash].first = curKey;
-            new_table[hash].second = curValue;
+            new_hashes[hash] = prehash;
+            std::swap(new_table[hash].first, table_[j].first);
+            std::swap(new_table[hash].second, table_[j].second);
             value_inserted = true;
             break;
           }
-        }  // end for (uint32_t i = 0; i < size_; i ++)
+        }  // end for (uint32_t i = 0; i < new_size; i ++)
         if (!value_inserted) {
           printf("HashMapManaged<TKey, TValue*>::rehash - Couldn't insert!  ");
           printf("This shouldn't happen.  Check hash table logic.\n");
           throw std::wruntime_error("HashMapManaged::rehash: insert failed");
         }
-      }  // end if (bucket_full_[i])
+      }  // end if (bucket_full_[j])
     }
     size_ = new_size;
     delete[] table_;
     delete[] bucket_full_;
+    delete[] hashes_;
     table_ = new_table;
     bucket_full_ = new_bucket_full;
+    hashes_ = new_hashes;
+    load_factor_ = static_cast<float>(count_) / static_cast<float>(size_);
   };
 
   template <class TKey, class TValue>
-  HashMapManaged<TKey, TValue*>::~HashMapManaged() {
-    if (table_ && bucket_full_) {
-      for (uint32_t i = 0; i < size_; i ++) {
-        if (bucket_full_[i]) {
-          if (table_[i].second != NULL) {
-            delete table_[i].second;
-            table_[i].second = NULL;
-          }
-        }
-      }
+  void HashMapManaged<TKey, TValue*>::reserve(const uint32_t count) {
+    // The load must stay <= max_load_ (0.5) once count keys are in
+    const uint64_t min_size = static_cast<uint64_t>(count) * 2;
+    if (min_size > size_) {
+      rehash(static_cast<uint32_t>(math::NextPrime(
+        static_cast<std::size_t>(min_size))));
     }
-    if (table_) {
-      delete[] table_;
+  };
+
+  template <class TKey, class TValue>
+  uint32_t HashMapManaged<TKey, TValue*>::build(const TKey* keys,
+    TValue* const* values, const uint32_t n) {
+    reserve(count_ + n);
+    // Sort the keys by prehash (bucket << 32 | index) so the table is
+    // written front to back.  Equal keys keep their order, so the first
+    // one wins like with n insert() calls.
+    uint64_t* order = new uint64_t[n];
+    for (uint32_t i = 0; i < n; i++) {
+      const uint32_t prehash = hash_func_(size_, keys[i]);
+      order[i] = (static_cast<uint64_t>(prehash) << 32) | i;
     }
-    if (bucket_full_) {
-      delete[] bucket_full_;
+    std::sort(order, order + n);
+    uint32_t num_inserted = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      const uint32_t j = static_cast<uint32_t>(order[i] & 0xffffffff);
+      if (insertPrehash(static_cast<uint32_t>(order[i] >> 32), keys[j],
+        values[j])) {
+        num_inserted++;
+      }
     }
+    delete[] order;
+    return num_inserted;
+  };
+
+  template <class TKey, class TValue>
+  HashMapManaged<TKey, TValue*>::~HashMapManaged() {
+    release();
   };
 
   template <class TKey, class TValue>
@@ -421,24 +704,57 @@ namespace data_str {
   template <class TKey, class TValue>
   bool HashMapManaged<TKey, TValue*>::insertPrehash(const uint32_t prehash,
     const TKey& key, TValue* value) {
+    return insertImpl(prehash, key, value);
+  };
+
+  template <class TKey, class TValue>
+  bool HashMapManaged<TKey, TValue*>::insert(TKey&& key, TValue* value) {
+    const uint32_t hash = hash_func_(size_, key);
+    return insertImpl(hash, std::move(key), value);
+  };
+
+  template <class TKey, class TValue>
+  bool HashMapManaged<TKey, TValue*>::insertPrehash(const uint32_t prehash,
+    TKey&& key, TValue* value) {
+    return insertImpl(prehash, std::move(key), value);
+  };
+
+  template <class TKey, class TValue>
+  template <typename... Args>
+  bool HashMapManaged<TKey, TValue*>::emplace(const TKey& key,
+    Args&&... args) {
+    const uint32_t hash = hash_func_(size_, key);
+    TValue* value;
+    if (lookupPrehash(hash, key, value)) {
+      return false;
+    }
+    return insertImpl(hash, key, new TValue(std::forward<Args>(args)...));
+  };
+
+  template <class TKey, class TValue>
+  template <typename K>
+  bool HashMapManaged<TKey, TValue*>::insertImpl(const uint32_t prehash,
+    K&& key, TValue* value) {
     // keep trying to insert until the table is full.  We're doing linear probe
     // http://en.wikipedia.org/wiki/Linear_probing
     for (uint32_t i = 0; i < size_; i ++) {
       uint32_t hash = linearProbeFunc(prehash, i, size_);
       if (!bucket_full_[hash]) {
         bucket_full_[hash] = true;
-        table_[hash].first = key;
+        hashes_[hash] = prehash;
+        table_[hash].first = std::forward<K>(key);
         table_[hash].second = value;
         count_++;
         load_factor_ = static_cast<float>(count_) / static_cast<float>(size_);
         while (load_factor_ > max_load_) {
-          rehash();
+          rehash(static_cast<uint32_t>(math::NextPrime(size_ * 2)));
           load_factor_ = static_cast<float>(count_) / 
             static_cast<float>(size_);
         }
         return true;
       } else {
-        if (table_[hash].first == key)  // Key already exists
+        // Key already exists
+        if (hashes_[hash] == prehash && table_[hash].first == key)
           return false;
       }
     }
@@ -490,7 +806,7 @@ namespace data_str {
       if (!bucket_full_[hash]) {
         return false;
       } else {
-        if (table_[hash].first == key) {
+        if (hashes_[hash] == prehash && table_[hash].first == key) {
           value = table_[hash].second;
           return true;
         }
@@ -10,26 +10,55 @@
 //        transferred.  That is, the vector is not responsible for handling
 //        cleanup when Vector<type*> is used.
 //
+//  Only the elements in [0, size()) are constructed; the rest of the array is
+//  raw memory.  Trivially copyable T (the numeric and VecN types) is grown
+//  with realloc and copied with memcpy, anything else is move constructed
+//  into the new array and destroyed in the old one.
+//
+//  The array comes from the Alloc policy (see aligned_allocator.h), by
+//  default ALIGNMENT aligned on every platform:
+//
+//    Vector<Float4x4, CacheLineAllocator> mats;  // 64 byte aligned
+//    Vector<float, HugePageAllocator> big;  // 2MB pages for 2MB+ arrays
+//
 
 #pragma once
 
 #include <stdio.h>  // For printf()
+#include <string.h>  // For memcpy(), memmove()
+#include <new>  // For placement new
+#include <type_traits>  // For std::is_trivially_copyable
+#include <utility>  // For std::move, std::forward, std::swap
 #include "jtil/alignment/data_align.h"
+#include "jtil/data_str/vector_fwd.h"
+#include "jtil/data_str/aligned_allocator.h"
 #include "jtil/math/math_types.h"  // for uint
 #include "jtil/exceptions/wruntime_error.h"
 
 namespace jtil {
 namespace data_str {
 
-  template <typename T>
+  template <typename T, typename Alloc>
   class Vector {
   public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
     explicit Vector(const uint32_t capacity = 0);
     ~Vector();
+    Vector(const Vector& other);  // O(n) - copy
+    // Move construction and assignment take other's array (other is left
+    // empty)
+    Vector(Vector&& other);
+    Vector& operator=(Vector&& other);
 
     void capacity(const uint32_t capacity);  // Request manual capacity incr
     void clear();
     inline void pushBack(const T& elem);  // Add a copy of the element to back
+    inline void pushBack(T&& elem);  // Move the element to the back
+    // emplaceBack() - Construct T(args...) in place at the back
+    template <typename... Args>
+    inline void emplaceBack(Args&&... args);
     inline void popBack(T& elem);  // remove last element and set to elem
     inline void popBack();  // remove last element
     inline void popBackUnsafe(T& elem);  // No bounds checking
@@ -41,19 +70,29 @@ namespace data_str {
     void resize(const uint32_t size_);
     inline const uint32_t& size() const { return size_; }
     inline const uint32_t& capacity() const { return capacity_; }
-    bool operator==(const Vector<T>& a) const;  // O(n) - linear search
-    Vector<T>& operator=(const Vector<T>& other);  // O(n) - copy
+    bool operator==(const Vector& a) const;  // O(n) - linear search
+    Vector& operator=(const Vector& other);  // O(n) - copy
     T operator[](const uint32_t index) const;
     T & operator[](const uint32_t index);
 
+    inline iterator begin() { return pvec_; }
+    inline iterator end() { return pvec_ + size_; }
+    inline const_iterator begin() const { return pvec_; }
+    inline const_iterator end() const { return pvec_ + size_; }
+
   private:
     uint32_t size_;
     uint32_t capacity_;  // will only grow or shrink by a factor of 2
     T* pvec_;
+
+    static const bool trivial_copy_ = std::is_trivially_copyable<T>::value;
+
+    inline void grow();  // Double the capacity (or make it 1)
+    inline void destroy(const uint32_t begin, const uint32_t end);
   };
 
-  template <typename T>
-  Vector<T>::Vector(const uint32_t capacity) {  // capacity = 0
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>::Vector(const uint32_t capacity) {  // capacity = 0
     pvec_ = NULL;
     capacity_ = 0;
     size_ = 0;
@@ -62,130 +101,184 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  Vector<T>::~Vector() {
-    if (pvec_) { 
-#ifdef _WIN32
-      _aligned_free(pvec_); 
-#else
-      free(pvec_); 
-#endif
-      pvec_ = NULL; 
-    }
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>::Vector(const Vector<T, Alloc>& other) {
+    pvec_ = NULL;
     capacity_ = 0;
     size_ = 0;
+    *this = other;
   };
 
-  template <typename T>
-  void Vector<T>::capacity(const uint32_t capacity) {
-    if (capacity != capacity_ && capacity != 0) {
-      T* pvec_old = pvec_;
-
-#ifdef _WIN32 
-      T dummy;
-      static_cast<void>(dummy);  // Get rid of unreference local variable warn
-      void* temp = NULL;
-      temp = _aligned_malloc(capacity * sizeof(dummy), ALIGNMENT);
-#else
-      T dummy;
-      void* temp = NULL;
-      temp = malloc(capacity * sizeof(dummy));
-#endif
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>::Vector(Vector<T, Alloc>&& other) {
+    pvec_ = other.pvec_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    other.pvec_ = NULL;
+    other.capacity_ = 0;
+    other.size_ = 0;
+  };
 
-      if (temp == NULL) { 
-        throw std::wruntime_error("Vector<T>::capacity: Malloc Failed.");
-      }
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>& Vector<T, Alloc>::operator=(Vector<T, Alloc>&& other) {
+    if (this != &other) {
+      this->clear();
+      std::swap(pvec_, other.pvec_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+    }
+    return *this;
+  };
 
-      // Use placement new to call the constructors for the array
-      pvec_ = reinterpret_cast<T*>(temp);
-      for (uint32_t i = 0; i < capacity; i ++) {
-        pvec_[i] = *(new(pvec_ + i) T());  // Call placement new on each item
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>::~Vector() {
+    clear();
+  };
+
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::destroy(const uint32_t begin, const uint32_t end) {
+    if (!trivial_copy_) {
+      for (uint32_t i = begin; i < end; i++) {
+        pvec_[i].~T();
       }
+    }
+  };
 
-      if (pvec_old) {
-        if (capacity <= capacity_) {
-          for (uint32_t i = 0; i < capacity; i ++) {
-            pvec_[i] = pvec_old[i];
-          }
-        } else {
-          for (uint32_t i = 0; i < capacity_; i ++) {
-            pvec_[i] = pvec_old[i];
-          }
-        }
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::grow() {
+    capacity(capacity_ == 0 ? 1 : capacity_ * 2);  // Grow the array by 2
+  };
 
-#ifdef _WIN32
-        _aligned_free(pvec_old); 
-#else
-        free(pvec_old); 
-#endif
-        pvec_old = NULL;
-      }
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::capacity(const uint32_t capacity) {
+    if (capacity == capacity_) {
+      return;
+    }
+    if (capacity == 0) {  // Clear array if desired capacity is zero
+      clear();
+      return;
+    }
+    if (size_ > capacity) {  // If we're truncating the array then resize
+      destroy(capacity, size_);
+      size_ = capacity;
+    }
 
-      capacity_ = capacity;
-      if (size_ > capacity_) {  // If we've truncated the array then resize_
-        size_ = capacity_;
+    const size_t bytes = static_cast<size_t>(capacity) * sizeof(T);
+    if (trivial_copy_) {
+      // realloc copies the live elements (or extends the block in place)
+      void* temp = Alloc::reallocate(pvec_, size_ * sizeof(T), bytes);
+      if (temp == NULL) {
+        throw std::wruntime_error("Vector<T>::capacity: Realloc Failed.");
       }
-    } else if (capacity == 0) {  // Clear array if desired capacity is zero
-      clear();
+      pvec_ = reinterpret_cast<T*>(temp);
+    } else {
+      T* temp = reinterpret_cast<T*>(Alloc::allocate(bytes));
+      if (temp == NULL) { 
+        throw std::wruntime_error("Vector<T>::capacity: Malloc Failed.");
+      }
+      for (uint32_t i = 0; i < size_; i++) {
+        new(temp + i) T(std::move(pvec_[i]));
+      }
+      destroy(0, size_);
+      Alloc::release(pvec_);
+      pvec_ = temp;
     }
+    capacity_ = capacity;
   };
 
-  template <typename T>
-  void Vector<T>::clear() {
-    size_ = 0;
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::clear() {
     if (pvec_) { 
-#ifdef _WIN32
-      _aligned_free(pvec_); 
-#else
-      free(pvec_);
-#endif      
+      destroy(0, size_);
+      Alloc::release(pvec_);
       pvec_ = NULL; 
     }
+    size_ = 0;
     capacity_ = 0;
   };
 
-  template <typename T>
-  void Vector<T>::pushBack(const T& elem) {
-    if (capacity_ == 0)
-      capacity(1);
-    else if (size_ == capacity_)
-      capacity(capacity_ * 2);  // Grow the array by size_ 2
-    pvec_[size_] = elem;
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::pushBack(const T& elem) {
+    if (size_ == capacity_) {
+      if (size_ > 0 && &elem >= pvec_ && &elem < pvec_ + size_) {
+        // elem is one of ours and growing will move it
+        const uint32_t index = static_cast<uint32_t>(&elem - pvec_);
+        grow();
+        new(pvec_ + size_) T(pvec_[index]);
+        size_ += 1;
+        return;
+      }
+      grow();
+    }
+    new(pvec_ + size_) T(elem);
+    size_ += 1;
+  };
+
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::pushBack(T&& elem) {
+    if (size_ == capacity_) {
+      // elem may be one of ours: take it before growing frees the buffer
+      T temp(std::move(elem));
+      grow();
+      new(pvec_ + size_) T(std::move(temp));
+      size_ += 1;
+      return;
+    }
+    new(pvec_ + size_) T(std::move(elem));
+    size_ += 1;
+  };
+
+  template <typename T, typename Alloc>
+  template <typename... Args>
+  void Vector<T, Alloc>::emplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+      // The args may refer to our elements: build it before growing
+      T temp(std::forward<Args>(args)...);
+      grow();
+      new(pvec_ + size_) T(std::move(temp));
+      size_ += 1;
+      return;
+    }
+    new(pvec_ + size_) T(std::forward<Args>(args)...);
     size_ += 1;
   };
   
-  template <typename T>
-  void Vector<T>::popBack(T& elem) {
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::popBack(T& elem) {
     if (size_ > 0) {
-      elem = pvec_[size_-1];
-      size_ -= 1;  // just reduce the size_ by 1
+      elem = std::move(pvec_[size_-1]);
+      size_ -= 1;
+      destroy(size_, size_ + 1);
     } else {
       throw std::wruntime_error("Vector<T>::popBack: Out of bounds");
     }
   };
 
-  template <typename T>
-  void Vector<T>::popBack() {
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::popBack() {
     if (size_ > 0) {
-      size_ -= 1;  // just reduce the size_ by 1
+      size_ -= 1;
+      destroy(size_, size_ + 1);
     } else {
       throw std::wruntime_error("Vector<T>::popBack: Out of bounds");
     }
   };
 
-  template <typename T>
-  void Vector<T>::popBackUnsafe(T& elem) {
-    elem = pvec_[size_-1];
-    size_ -= 1;  // just reduce the size_ by 1
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::popBackUnsafe(T& elem) {
+    elem = std::move(pvec_[size_-1]);
+    size_ -= 1;
+    destroy(size_, size_ + 1);
   };
 
-  template <typename T>
-  void Vector<T>::popBackUnsafe() {
-    size_ -= 1;  // just reduce the size_ by 1
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::popBackUnsafe() {
+    size_ -= 1;
+    destroy(size_, size_ + 1);
   };
 
-  template <typename T>
-  T* Vector<T>::at(const uint32_t index ) {
+  template <typename T, typename Alloc>
+  T* Vector<T, Alloc>::at(const uint32_t index ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -193,8 +286,8 @@ namespace data_str {
     return &pvec_[index];
   };
 
-  template <typename T>
-  const T* Vector<T>::at(const uint32_t index ) const {
+  template <typename T, typename Alloc>
+  const T* Vector<T, Alloc>::at(const uint32_t index ) const {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -202,8 +295,8 @@ namespace data_str {
     return &pvec_[index];
   };
 
-  template <typename T>
-  T Vector<T>::operator[](const uint32_t index) const { 
+  template <typename T, typename Alloc>
+  T Vector<T, Alloc>::operator[](const uint32_t index) const { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -211,8 +304,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  T& Vector<T>::operator[](const uint32_t index) { 
+  template <typename T, typename Alloc>
+  T& Vector<T, Alloc>::operator[](const uint32_t index) { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -220,8 +313,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  void Vector<T>::set(const uint32_t index, const T& val ) {
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::set(const uint32_t index, const T& val ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -229,21 +322,25 @@ namespace data_str {
     pvec_[index] = val;
   };
 
-  template <typename T>
-  void Vector<T>::resize(const uint32_t size) { 
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::resize(const uint32_t size) { 
 #if defined(_DEBUG) || defined(DEBUG)
-    if ( size > capacity_) { 
+    if (size > capacity_) { 
       throw std::wruntime_error("Vector<T>::resize: Out of bounds");
-    } else { 
-#endif
-      size_ = size; 
-#if defined(_DEBUG) || defined(DEBUG)
-    } 
+    }
 #endif
+    if (size > capacity_) {
+      capacity(size);  // Rather than construct past the end of the array
+    }
+    for (uint32_t i = size_; i < size; i++) {
+      new(pvec_ + i) T();
+    }
+    destroy(size, size_);
+    size_ = size; 
   };   
 
-  template <typename T>
-  bool Vector<T>::operator==(const Vector& a) const {
+  template <typename T, typename Alloc>
+  bool Vector<T, Alloc>::operator==(const Vector& a) const {
     if (this == &a) {  // if both point to the same memory
       return true; 
     }
@@ -258,13 +355,20 @@ namespace data_str {
     return true;
   };
 
-  template <typename T>
-  Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
+  template <typename T, typename Alloc>
+  Vector<T, Alloc>& Vector<T, Alloc>::operator=(const Vector<T, Alloc>& other) {
     if (this != &other) {  // protect against invalid self-assignment
       this->clear();
       this->capacity(other.capacity_);
-      for (uint32_t i = 0; i < other.size_; i ++) {
-        this->pvec_[i] = other.pvec_[i];
+      if (trivial_copy_) {
+        if (other.size_ > 0) {
+          memcpy(static_cast<void*>(this->pvec_),
+            static_cast<const void*>(other.pvec_), other.size_ * sizeof(T));
+        }
+      } else {
+        for (uint32_t i = 0; i < other.size_; i ++) {
+          new(this->pvec_ + i) T(other.pvec_[i]);
+        }
       }
       this->size_ = other.size_;
     }
@@ -272,17 +376,24 @@ namespace data_str {
     return *this;
   };
 
-  template <typename T>
-  void Vector<T>::deleteAtAndShift(const uint32_t index) {
+  template <typename T, typename Alloc>
+  void Vector<T, Alloc>::deleteAtAndShift(const uint32_t index) {
 #ifdef _DEBUG
     if (index > (size_-1)) {
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
     }
 #endif
-    for (uint32_t i = index; i < size_-1; i++) {
-      pvec_[i] = pvec_[i+1];
+    if (trivial_copy_) {
+      memmove(static_cast<void*>(pvec_ + index),
+        static_cast<const void*>(pvec_ + index + 1),
+        (size_ - 1 - index) * sizeof(T));
+    } else {
+      for (uint32_t i = index; i < size_-1; i++) {
+        pvec_[i] = std::move(pvec_[i+1]);
+      }
     }
     size_--;
+    destroy(size_, size_ + 1);
   };
 
 };  // namespace data_str
@@ -0,0 +1,25 @@
+//
+//  vector_fwd.h
+//
+//  Forward declarations of Vector and VectorManaged.  Headers that only need
+//  the names should include this rather than declaring them: the default
+//  allocation policy can only be given in one declaration.
+//
+
+#pragma once
+
+#include <stddef.h>  // For size_t
+#include "jtil/alignment/data_align.h"  // For ALIGNMENT
+
+namespace jtil {
+namespace data_str {
+
+  template <size_t Alignment> class AlignedAllocator;
+
+  template <typename T, typename Alloc = AlignedAllocator<ALIGNMENT> >
+  class Vector;
+  template <typename T, typename Alloc = AlignedAllocator<ALIGNMENT> >
+  class VectorManaged;
+
+};  // namespace data_str
+};  // namespace jtil
@@ -12,26 +12,44 @@
 //        writting to that index.
 //
 //        BOUNDS CHECKS ONLY PERFORMED ON _DEBUG builds.
+//
+//        The array comes from the Alloc policy, as for Vector (see
+//        aligned_allocator.h).
 
 #pragma once
 
 #include <stdio.h>  // For printf()
+#include <utility>  // For std::move, std::forward, std::swap
 #include "jtil/alignment/data_align.h"
+#include "jtil/data_str/vector_fwd.h"
+#include "jtil/data_str/aligned_allocator.h"
 #include "jtil/math/math_types.h"  // for uint
 #include "jtil/exceptions/wruntime_error.h"
 
 namespace jtil {
 namespace data_str {
 
-  template <typename T>
+  template <typename T, typename Alloc>
   class VectorManaged {
   public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
     explicit VectorManaged(const uint32_t capacity = 0);
     ~VectorManaged();
+    VectorManaged(const VectorManaged& other);  // O(n) - copy
+    // Move construction and assignment take other's array (other is left
+    // empty)
+    VectorManaged(VectorManaged&& other);
+    VectorManaged& operator=(VectorManaged&& other);
 
     void capacity(const uint32_t capacity);  // Request manual capacity incr
     void clear();
     inline void pushBack(const T& elem);  // Add a copy of the element to back
+    inline void pushBack(T&& elem);  // Move the element to the back
+    // emplaceBack() - Construct T(args...) in place at the back
+    template <typename... Args>
+    inline void emplaceBack(Args&&... args);
     inline void popBack();  // remove last element and call it's destructor
     inline void popBackUnsafe();  // No bounds checking
     inline T* at(uint32_t index);  // Get an internal reference
@@ -40,19 +58,24 @@ namespace data_str {
     void resize(const uint32_t size_);
     inline const uint32_t& size() const { return size_; }
     inline const uint32_t& capacity() const { return capacity_; }
-    bool operator==(const VectorManaged<T>& a) const;  // O(n) - linear search
-    VectorManaged<T>& operator=(const VectorManaged<T>& other);  // O(n) - copy
+    bool operator==(const VectorManaged& a) const;  // O(n) - linear search
+    VectorManaged& operator=(const VectorManaged& other);  // O(n) - copy
     T operator[](const uint32_t index) const;
     T & operator[](const uint32_t index);
 
+    inline iterator begin() { return pvec_; }
+    inline iterator end() { return pvec_ + size_; }
+    inline const_iterator begin() const { return pvec_; }
+    inline const_iterator end() const { return pvec_ + size_; }
+
   private:
     uint32_t size_;
     uint32_t capacity_;  // will only grow or shrink by a factor of 2
     T* pvec_;
   };
 
-  template <typename T>
-  VectorManaged<T>::VectorManaged(const uint32_t capacity) {  // capacity = 0
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>::VectorManaged(const uint32_t capacity) {
     pvec_ = NULL;
     capacity_ = 0;
     size_ = 0;
@@ -61,38 +84,55 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  VectorManaged<T>::~VectorManaged() {
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>::VectorManaged(const VectorManaged<T, Alloc>& other) {
+    pvec_ = NULL;
+    capacity_ = 0;
+    size_ = 0;
+    *this = other;
+  };
+
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>::VectorManaged(VectorManaged<T, Alloc>&& other) {
+    pvec_ = other.pvec_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    other.pvec_ = NULL;
+    other.capacity_ = 0;
+    other.size_ = 0;
+  };
+
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>& VectorManaged<T, Alloc>::operator=(
+    VectorManaged<T, Alloc>&& other) {
+    if (this != &other) {
+      this->clear();
+      std::swap(pvec_, other.pvec_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+    }
+    return *this;
+  };
+
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>::~VectorManaged() {
     if (pvec_) { 
       for (uint32_t i = 0; i < capacity_; i ++) {
         (&pvec_[i])->~T();  // Call the destructor on each element of the array
       }
-#ifdef _WIN32
-      _aligned_free(pvec_); 
-#else
-      free(pvec_); 
-#endif
+      Alloc::release(pvec_);
       pvec_ = NULL; 
     }
     capacity_ = 0;
     size_ = 0;
   };
 
-  template <typename T>
-  void VectorManaged<T>::capacity(const uint32_t capacity) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::capacity(const uint32_t capacity) {
     if (capacity != capacity_ && capacity != 0) {
       T* pvec_old = pvec_;
 
-#ifdef _WIN32
-      T dummy;
-      static_cast<void>(dummy);  // Get rid of unreference local variable warn
-      void* temp = NULL;
-      temp = _aligned_malloc(capacity * sizeof(dummy), ALIGNMENT);
-#else
-      T dummy;
-      void* temp = NULL;
-      temp = malloc(capacity * sizeof(dummy));
-#endif
+      void* temp = Alloc::allocate(capacity * sizeof(T));
 
       if (temp == NULL) { 
         throw std::wruntime_error("VectorManaged<T>::capacity: Malloc Failed.");
@@ -101,25 +141,24 @@ namespace data_str {
       // Use placement new to call the constructors for the array
       pvec_ = reinterpret_cast<T*>(temp);
       for (uint32_t i = 0; i < capacity; i ++) {
-        pvec_[i] = *(new(pvec_ + i) T());  // Call placement new on each item
+        new(pvec_ + i) T();  // Call placement new on each item
       }
 
       if (pvec_old) {
         if (capacity <= capacity_) {
           for (uint32_t i = 0; i < capacity; i ++) {
-            pvec_[i] = pvec_old[i];
+            pvec_[i] = std::move(pvec_old[i]);
           }
         } else {
           for (uint32_t i = 0; i < capacity_; i ++) {
-            pvec_[i] = pvec_old[i];
+            pvec_[i] = std::move(pvec_old[i]);
           }
         }
+        for (uint32_t i = 0; i < capacity_; i ++) {
+          (&pvec_old[i])->~T();
+        }
 
-#ifdef _WIN32
-        _aligned_free(pvec_old); 
-#else
-        free(pvec_old); 
-#endif
+        Alloc::release(pvec_old);
         pvec_old = NULL;
       }
 
@@ -132,25 +171,30 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  void VectorManaged<T>::clear() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::clear() {
     size_ = 0;
     if (pvec_) { 
       for (uint32_t i = 0; i < capacity_; i ++) {
         (&pvec_[i])->~T();  // explicitly call the destructor on each element
       }
-#ifdef _WIN32
-      _aligned_free(pvec_); 
-#else
-      free(pvec_);
-#endif      
+      Alloc::release(pvec_);
       pvec_ = NULL; 
     }
     capacity_ = 0;
   };
 
-  template <typename T>
-  void VectorManaged<T>::pushBack(const T& elem) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::pushBack(const T& elem) {
+    if (size_ > 0 && size_ == capacity_ && &elem >= pvec_ &&
+      &elem < pvec_ + size_) {
+      // elem is one of ours and growing will move it
+      const uint32_t index = static_cast<uint32_t>(&elem - pvec_);
+      capacity(capacity_ * 2);
+      pvec_[size_] = pvec_[index];
+      size_ += 1;
+      return;
+    }
     if (capacity_ == 0)
       capacity(1);
     else if (size_ == capacity_)
@@ -158,22 +202,58 @@ namespace data_str {
     pvec_[size_] = elem;
     size_ += 1;
   };
+
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::pushBack(T&& elem) {
+    if (size_ == capacity_) {
+      // elem may be one of ours: take it before growing frees the buffer
+      T temp(std::move(elem));
+      capacity(capacity_ == 0 ? 1 : capacity_ * 2);
+      pvec_[size_] = std::move(temp);
+      size_ += 1;
+      return;
+    }
+    pvec_[size_] = std::move(elem);
+    size_ += 1;
+  };
+
+  template <typename T, typename Alloc>
+  template <typename... Args>
+  void VectorManaged<T, Alloc>::emplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+      // The args may refer to our elements: build it before growing
+      T temp(std::forward<Args>(args)...);
+      capacity(capacity_ == 0 ? 1 : capacity_ * 2);
+      pvec_[size_] = std::move(temp);
+      size_ += 1;
+      return;
+    }
+    // The slot holds a default constructed T, replace it
+    (&pvec_[size_])->~T();
+    try {
+      new(pvec_ + size_) T(std::forward<Args>(args)...);
+    } catch (...) {
+      new(pvec_ + size_) T();  // Leave a valid T in the slot
+      throw;
+    }
+    size_ += 1;
+  };
   
-  template <typename T>
-  void VectorManaged<T>::popBack() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::popBack() {
     if (size_ > 0)
       size_ -= 1;  // just reduce the size_ by 1
     else
       throw std::wruntime_error("VectorManaged<T>::popBack: Out of bounds");
   };
 
-  template <typename T>
-  void VectorManaged<T>::popBackUnsafe() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::popBackUnsafe() {
     size_ -= 1;  // just reduce the size_ by 1
   };
 
-  template <typename T>
-  T* VectorManaged<T>::at(const uint32_t index ) {
+  template <typename T, typename Alloc>
+  T* VectorManaged<T, Alloc>::at(const uint32_t index ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
@@ -181,8 +261,8 @@ namespace data_str {
     return &pvec_[index];
   };
 
-  template <typename T>
-  T VectorManaged<T>::operator[](const uint32_t index) const { 
+  template <typename T, typename Alloc>
+  T VectorManaged<T, Alloc>::operator[](const uint32_t index) const { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -190,8 +270,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  T& VectorManaged<T>::operator[](const uint32_t index) { 
+  template <typename T, typename Alloc>
+  T& VectorManaged<T, Alloc>::operator[](const uint32_t index) { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -199,8 +279,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  void VectorManaged<T>::set(const uint32_t index, const T& val ) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::set(const uint32_t index, const T& val ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
@@ -208,8 +288,8 @@ namespace data_str {
     pvec_[index] = val;
   };
 
-  template <typename T>
-  void VectorManaged<T>::resize(const uint32_t size) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::resize(const uint32_t size) {
 #if defined(_DEBUG) || defined(DEBUG)
     if ( size > capacity_ || size < 0 ) { 
       throw std::wruntime_error("VectorManaged<T>::resize: Out of bounds");
@@ -221,8 +301,8 @@ namespace data_str {
 #endif
   };   
 
-  template <typename T>
-  bool VectorManaged<T>::operator==(const VectorManaged& a) const {
+  template <typename T, typename Alloc>
+  bool VectorManaged<T, Alloc>::operator==(const VectorManaged& a) const {
     if (this == &a) {  // if both point to the same memory
       return true; 
     }
@@ -237,9 +317,9 @@ namespace data_str {
     return true;
   };
 
-  template <typename T>
-  VectorManaged<T>& VectorManaged<T>::operator=(
-    const VectorManaged<T>& other) {
+  template <typename T, typename Alloc>
+  VectorManaged<T, Alloc>& VectorManaged<T, Alloc>::operator=(
+    const VectorManaged<T, Alloc>& other) {
     if (this != &other) {  // protect against invalid self-assignment
       this->clear();
       this->capacity(other.capacity_);
@@ -252,15 +332,15 @@ namespace data_str {
     return *this;
   };
 
-  template <typename T>
-  void VectorManaged<T>::deleteAtAndShift(const uint32_t index) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T, Alloc>::deleteAtAndShift(const uint32_t index) {
 #ifdef _DEBUG
     if (index > (size_-1)) {
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
     }
 #endif
     for (uint32_t i = index; i < size_-1; i++) {
-      pvec_[i] = pvec_[i+1];
+      pvec_[i] = std::move(pvec_[i+1]);
     }
     size_--;
   };
@@ -269,15 +349,25 @@ namespace data_str {
   // Template specialization for pointers, note if VectorManaged<int*> is used, 
   // T is an int in this case.  NOT a int*.  Hence, pvec needs to be a double 
   // ptr
-  template <typename T>
-  class VectorManaged<T*> {
+  template <typename T, typename Alloc>
+  class VectorManaged<T*, Alloc> {
   public:
-    explicit VectorManaged<T*>(const uint32_t capacity = 0);
-    ~VectorManaged<T*>();
+    typedef T** iterator;
+    typedef T* const* const_iterator;
+
+    explicit VectorManaged(const uint32_t capacity = 0);
+    ~VectorManaged();
+    // Move construction and assignment take other's array (other is left
+    // empty)
+    VectorManaged(VectorManaged&& other);
+    VectorManaged& operator=(VectorManaged&& other);
 
     void capacity(const uint32_t capacity);  // Request manual capacity incr
     void clear();
     inline void pushBack(T * const elem);  // Add copy of the ptr to back
+    // emplaceBack() - pushBack(new T(args...))
+    template <typename... Args>
+    inline void emplaceBack(Args&&... args);
     inline void popBack();  // remove last element and call it's destructor
     inline void popBackUnsafe();  // No bounds checking
     inline T** at(const uint32_t index);  // Get an internal reference
@@ -287,19 +377,24 @@ namespace data_str {
     void resize(const uint32_t size_);
     inline const uint32_t& size() const { return size_; }
     inline const uint32_t& capacity() const { return capacity_; }
-    bool operator==(const VectorManaged<T*> &a) const;  // O(n) - linear search
+    bool operator==(const VectorManaged &a) const;  // O(n) - linear search
     VectorManaged& operator=(const VectorManaged& other);  // O(n) - copy
     T* operator[](const uint32_t index) const;
     T* & operator[](const uint32_t index);
 
+    inline iterator begin() { return pvec_; }
+    inline iterator end() { return pvec_ + size_; }
+    inline const_iterator begin() const { return pvec_; }
+    inline const_iterator end() const { return pvec_ + size_; }
+
   private:
     uint32_t size_;
     uint32_t capacity_;  // will only grow or shrink by a factor of 2
     T** pvec_;
   };
 
-  template <typename T>
-  VectorManaged<T*>::VectorManaged(const uint32_t capacity) {  // capacity = 0
+  template <typename T, typename Alloc>
+  VectorManaged<T*, Alloc>::VectorManaged(const uint32_t capacity) {
     pvec_ = NULL;
     capacity_ = 0;
     size_ = 0;
@@ -308,8 +403,30 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  VectorManaged<T*>::~VectorManaged() {
+  template <typename T, typename Alloc>
+  VectorManaged<T*, Alloc>::VectorManaged(VectorManaged&& other) {
+    pvec_ = other.pvec_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    other.pvec_ = NULL;
+    other.capacity_ = 0;
+    other.size_ = 0;
+  };
+
+  template <typename T, typename Alloc>
+  VectorManaged<T*, Alloc>& VectorManaged<T*, Alloc>::operator=(
+    VectorManaged&& other) {
+    if (this != &other) {
+      this->clear();
+      std::swap(pvec_, other.pvec_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+    }
+    return *this;
+  };
+
+  template <typename T, typename Alloc>
+  VectorManaged<T*, Alloc>::~VectorManaged() {
     if (pvec_) { 
       for (uint32_t i = 0; i < capacity_; i ++) {
         if (pvec_[i]) {
@@ -317,32 +434,19 @@ namespace data_str {
           pvec_[i] = NULL;
         }
       }
-#ifdef _WIN32     
-      _aligned_free(pvec_); 
-#else
-      free(pvec_);      
-#endif
+      Alloc::release(pvec_);
       pvec_ = NULL; 
     }
     capacity_ = 0;
     size_ = 0;
   };
 
-  template <typename T>
-  void VectorManaged<T*>::capacity(const uint32_t capacity) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::capacity(const uint32_t capacity) {
     if (capacity != capacity_ && capacity != 0) {
       T** pvec_old = pvec_;
 
-#ifdef _WIN32
-      T* dummy;
-      dummy = NULL;
-      void ** temp = NULL;
-      temp = reinterpret_cast<void**>(_aligned_malloc(capacity * 
-                                                      sizeof(dummy), 
-                                                      ALIGNMENT));
-#else
-      T** temp = new T*[capacity];
-#endif
+      void* temp = Alloc::allocate(capacity * sizeof(T*));
 
       if (temp == NULL) { 
         throw std::wruntime_error("VectorManaged<T>::capacity: Malloc Failed.");
@@ -365,11 +469,7 @@ namespace data_str {
           }
         }
 
-#ifdef _WIN32
-        _aligned_free(pvec_old); 
-#else
-        free(pvec_old);
-#endif
+        Alloc::release(pvec_old);
         pvec_old = NULL;
       }
 
@@ -383,8 +483,8 @@ namespace data_str {
   };
 
   // A partial specialization of for pointer types 
-  template<typename T> 
-  void VectorManaged<T*>::clear() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::clear() {
     size_ = 0;
     if (pvec_) { 
       for (uint32_t i = 0; i < capacity_; i ++) {
@@ -393,18 +493,14 @@ namespace data_str {
           pvec_[i] = NULL;
         }
       }
-#ifdef _WIN32
-      _aligned_free(pvec_); 
-#else
-      free(pvec_);
-#endif
+      Alloc::release(pvec_);
       pvec_ = NULL; 
     }
     capacity_ = 0;
   };
 
-  template <typename T>
-  void VectorManaged<T*>::pushBack(T * const elem) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::pushBack(T * const elem) {
     if (capacity_ == 0)
       capacity(1);
     else if (size_ == capacity_)
@@ -412,9 +508,15 @@ namespace data_str {
     pvec_[size_] = elem;
     size_ += 1;
   };
+
+  template <typename T, typename Alloc>
+  template <typename... Args>
+  void VectorManaged<T*, Alloc>::emplaceBack(Args&&... args) {
+    pushBack(new T(std::forward<Args>(args)...));
+  };
   
-  template <typename T>
-  void VectorManaged<T*>::popBack() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::popBack() {
     if (size_ > 0) {
       if (pvec_[size_-1]) {
         delete pvec_[size_-1];
@@ -426,8 +528,8 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  void VectorManaged<T*>::popBackUnsafe() {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::popBackUnsafe() {
     if (pvec_[size_-1]) {
       delete pvec_[size_-1];
       pvec_[size_-1] = NULL;
@@ -435,8 +537,8 @@ namespace data_str {
     size_ -= 1;
   };
 
-  template <typename T>
-  T** VectorManaged<T*>::at(const uint32_t index ) {
+  template <typename T, typename Alloc>
+  T** VectorManaged<T*, Alloc>::at(const uint32_t index ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
@@ -444,8 +546,8 @@ namespace data_str {
     return &pvec_[index];
   };
 
-  template <typename T>
-  T* VectorManaged<T*>::operator[](const uint32_t index) const { 
+  template <typename T, typename Alloc>
+  T* VectorManaged<T*, Alloc>::operator[](const uint32_t index) const { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -453,8 +555,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  T*& VectorManaged<T*>::operator[](const uint32_t index) { 
+  template <typename T, typename Alloc>
+  T*& VectorManaged<T*, Alloc>::operator[](const uint32_t index) { 
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("Vector<T>::at: Out of bounds");
@@ -462,8 +564,8 @@ namespace data_str {
     return pvec_[index]; 
   };
 
-  template <typename T>
-  void VectorManaged<T*>::set(const uint32_t index, T * const val ) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::set(const uint32_t index, T * const val ) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1))
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
@@ -471,8 +573,8 @@ namespace data_str {
     pvec_[index] = val;
   };
 
-  template <typename T>
-  void VectorManaged<T*>::deleteAt(const uint32_t index) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::deleteAt(const uint32_t index) {
 #if defined(_DEBUG) || defined(DEBUG)
     if (index > (size_-1)) {
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
@@ -484,8 +586,8 @@ namespace data_str {
     }
   };
 
-  template <typename T>
-  void VectorManaged<T*>::resize(const uint32_t size) { 
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::resize(const uint32_t size) { 
 #if defined(_DEBUG) || defined(DEBUG)
     if ( size > capacity_) { 
       throw std::wruntime_error("VectorManaged<T>::resize: Out of bounds");
@@ -505,8 +607,9 @@ namespace data_str {
 #endif
   };   
 
-  template <typename T>
-  bool VectorManaged<T*>::operator==(const VectorManaged<T*>& a) const {
+  template <typename T, typename Alloc>
+  bool VectorManaged<T*, Alloc>::operator==(
+    const VectorManaged<T*, Alloc>& a) const {
     if (this == &a) {  // if both point to the same memory
       return true; 
     }
@@ -521,9 +624,9 @@ namespace data_str {
     return true;
   };
 
-  template <typename T>
-  VectorManaged<T*>& VectorManaged<T*>::operator=(
-    const VectorManaged<T*>& other) {
+  template <typename T, typename Alloc>
+  VectorManaged<T*, Alloc>& VectorManaged<T*, Alloc>::operator=(
+    const VectorManaged<T*, Alloc>& other) {
     if (this != &other) {  // protect against invalid self-assignment
       this->clear();
       this->capacity(other.capacity_);
@@ -536,8 +639,8 @@ namespace data_str {
     return *this;
   };
 
-  template <typename T>
-  void VectorManaged<T*>::deleteAtAndShift(const uint32_t index) {
+  template <typename T, typename Alloc>
+  void VectorManaged<T*, Alloc>::deleteAtAndShift(const uint32_t index) {
 #ifdef _DEBUG
     if (index > (size_-1)) {
       throw std::wruntime_error("VectorManaged<T>::at: Out of bounds");
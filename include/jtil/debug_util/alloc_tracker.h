@@ -0,0 +1,113 @@
+//
+//  alloc_tracker.h
+//
+//  Counts heap allocations (Linux only), to find the allocation heavy paths
+//  and to check that a fix really cut the allocations per frame:
+//
+//    AllocTracker::enable();
+//    {
+//      AllocScope scope("Scene::update");  // tag must be a literal
+//      scene->update();
+//      std::cout << scope.stats().num_allocs << std::endl;
+//    }
+//    AllocTracker::printReport(std::cout);  // Totals per tag
+//
+//  The global operator new / delete are replaced to do the counting, which
+//  affects every program linked against jtil, so it is off by default: build
+//  jtil with JTIL_ALLOC_TRACKER to turn it on.  Add JTIL_TRACK_MALLOC to also
+//  replace malloc / free (which then count operator new too), so C
+//  allocations are seen.  When the tracker is disabled at runtime each
+//  allocation only costs a relaxed atomic load.
+//
+//  With enable(true) the allocations are also aggregated by call site (the
+//  top ALLOC_TRACKER_STACK_DEPTH frames of the stack), which is slow but
+//  shows who allocates.  Compile with -rdynamic to get function names in
+//  printReport().
+//
+//  Sizes are malloc_usable_size(), so they include the allocator's rounding.
+//  An AllocScope counts the allocations of its own thread; frees are
+//  counted on the thread that frees.  Only the frees of blocks allocated
+//  while enabled are counted (even after disable()): the tracker keeps a
+//  table of those blocks, so with it enabled every allocation and free also
+//  takes one of its locks.  Once ALLOC_TRACKER_MAX_LIVE blocks are live the
+//  new ones aren't counted (printReport() says how many).
+//
+//  Without JTIL_ALLOC_TRACKER, or on other platforms, everything compiles but
+//  nothing is counted and supported() is false (Windows has the CRT debug
+//  heap, see debug_util.h).
+//
+
+#pragma once
+
+#include <ostream>
+#include "jtil/math/math_types.h"  // for uint64_t, int64_t
+
+#define ALLOC_TRACKER_STACK_DEPTH 6  // Frames kept per call site
+#define ALLOC_TRACKER_MAX_CALL_SITES 4096
+#define ALLOC_TRACKER_MAX_TAGS 256
+#define ALLOC_TRACKER_MAX_SCOPE_DEPTH 16  // Nested AllocScopes per thread
+#define ALLOC_TRACKER_MAX_LIVE (1 << 20)  // Blocks tracked (power of 2)
+
+namespace jtil {
+namespace debug {
+
+  struct AllocStats {
+    AllocStats();
+    void clear();
+
+    uint64_t num_allocs;
+    uint64_t num_frees;
+    uint64_t bytes_allocated;
+    uint64_t bytes_freed;
+    int64_t peak_bytes;  // Of bytes_allocated - bytes_freed
+  };
+
+  class AllocTracker {
+  public:
+    // enable() - Start counting.  call_sites also aggregates allocations by
+    // call site (slow).
+    static void enable(const bool call_sites = false);
+    static void disable();
+    static bool enabled();
+    // supported() - false if nothing can be counted on this platform
+    static bool supported();
+
+    // getStats() - Every allocation since the first enable()
+    static void getStats(AllocStats* stats);
+    // liveAllocations() - Allocations made while enabled and not freed yet
+    // (the blocks allocated before enable() don't count)
+    static int64_t liveAllocations();
+
+    // printReport() - The global stats, the totals of every AllocScope tag
+    // and the max_call_sites call sites that allocated the most bytes
+    static void printReport(std::ostream& out, const int max_call_sites = 20);
+    // clear() - Forget the tag totals and call sites
+    static void clear();
+
+    // breakOnAllocation() - raise(SIGTRAP) on allocation number alloc_num
+    // (counting from 1 since the first enable()), 0 to disable
+    static void breakOnAllocation(const uint64_t alloc_num);
+  };
+
+  // AllocScope - Counts the allocations of the calling thread during its
+  // lifetime, and adds them to the totals of 'tag' when it ends
+  class AllocScope {
+  public:
+    explicit AllocScope(const char* tag);
+    ~AllocScope();
+
+    // stats() - So far (peak_bytes is relative to the start of the scope)
+    AllocStats stats() const;
+
+  private:
+    const char* tag_;
+    int depth_;  // In the thread's scope stack, -1 if it was too deep
+    AllocStats start_;
+
+    // Non-copyable, non-assignable.
+    AllocScope(const AllocScope&);
+    AllocScope& operator=(const AllocScope&);
+  };
+
+};  // namespace debug
+};  // namespace jtil
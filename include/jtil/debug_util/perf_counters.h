@@ -0,0 +1,89 @@
+//
+//  perf_counters.h
+//
+//  Hardware performance counters of the calling thread (Linux only, using
+//  perf_event_open), to tell whether a kernel got slower because of cache
+//  misses, branch mispredicts or instruction count:
+//
+//    PerfCounters perf;
+//    PerfCounterValues vals;
+//    {
+//      PerfScope scope(&perf, &vals);
+//      ImageUtil::downsample(...);
+//    }
+//    std::cout << vals.ipc() << std::endl;
+//
+//  Counters the kernel won't give us (no PMU in a VM or container, a strict
+//  perf_event_paranoid setting, or not Linux) are simply unavailable: their
+//  values stay invalid and everything else keeps working.  Only the calling
+//  thread is counted, not the threads it spawns.
+//
+//  To record the counters of every BENCHMARK run, see
+//  test_unit/perf_benchmark_counters.h.
+//
+
+#pragma once
+
+#include "jtil/math/math_types.h"  // for uint64_t
+
+namespace jtil {
+namespace debug {
+
+  typedef enum {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS = 1,
+    PERF_LLC_MISSES = 2,  // Last level cache
+    PERF_BRANCH_MISSES = 3,
+    PERF_TASK_CLOCK = 4,  // ns on the CPU (software, usually available)
+    PERF_NUM_COUNTERS = 5,
+  } PerfCounter;
+
+  struct PerfCounterValues {
+    PerfCounterValues();
+    void clear();
+    double ipc() const;  // Instructions per cycle, 0 if unknown
+
+    uint64_t counts[PERF_NUM_COUNTERS];
+    bool valid[PERF_NUM_COUNTERS];
+  };
+
+  class PerfCounters {
+  public:
+    // PerfCounters() - Opens and starts the counters of the calling thread
+    PerfCounters();
+    ~PerfCounters();
+
+    // read() - The counts since construction (scaled up if the kernel had
+    // to multiplex the counters).  Must be called on the same thread.
+    void read(PerfCounterValues* values) const;
+
+    bool available(const PerfCounter counter) const;
+    bool anyAvailable() const;
+    static const char* name(const PerfCounter counter);
+
+  private:
+    int fds_[PERF_NUM_COUNTERS];  // -1 if unavailable
+
+    // Non-copyable, non-assignable.
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+  };
+
+  // PerfScope - Adds the counts of its lifetime to 'total'
+  class PerfScope {
+  public:
+    PerfScope(const PerfCounters* counters, PerfCounterValues* total);
+    ~PerfScope();
+
+  private:
+    const PerfCounters* counters_;
+    PerfCounterValues* total_;
+    PerfCounterValues start_;
+
+    // Non-copyable, non-assignable.
+    PerfScope(const PerfScope&);
+    PerfScope& operator=(const PerfScope&);
+  };
+
+};  // namespace debug
+};  // namespace jtil
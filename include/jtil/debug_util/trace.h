@@ -0,0 +1,110 @@
+//
+//  trace.h
+//
+//  Scoped trace events, saved in Chrome's trace event format (open the file
+//  in chrome://tracing or ui.perfetto.dev) to see where a frame's time goes
+//  on every thread:
+//
+//    Trace::start();
+//    ...
+//    void Scene::loadModels() {
+//      JTIL_TRACE_SCOPE("Scene::loadModels");  // name must be a literal
+//      ...
+//    }
+//    ...
+//    Trace::stop();
+//    Trace::saveChromeJSON("frame.json");
+//
+//  Each thread writes its events into its own ring buffer of
+//  TRACE_BUFFER_SIZE events (the oldest are overwritten), so recording takes
+//  no locks: only the first event of a thread takes a lock to register its
+//  buffer.  When a thread exits its buffer (and events) is kept for the next
+//  thread that traces, so the events of threads that have finished can still
+//  be saved until that thread overwrites them, and the memory only grows
+//  with the number of threads alive at once.  When not recording a
+//  scope costs one relaxed atomic load, and defining JTIL_NO_TRACE compiles
+//  the scopes out altogether.
+//
+//  ThreadPool tasks are traced as "ThreadPool::task" and threads named with
+//  threading::SetThreadName() show up under that name.
+//
+
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include "jtil/math/math_types.h"  // for uint64_t
+
+#define TRACE_BUFFER_SIZE (1 << 14)  // Events per thread, power of 2
+
+#define JTIL_TRACE_CONCAT_INT(a, b) a ## b
+#define JTIL_TRACE_CONCAT(a, b) JTIL_TRACE_CONCAT_INT(a, b)
+#if defined(JTIL_NO_TRACE)
+  #define JTIL_TRACE_SCOPE(name)
+#else
+  #define JTIL_TRACE_SCOPE(name) \
+    jtil::debug::TraceScope JTIL_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#endif
+
+namespace jtil {
+namespace debug {
+
+  typedef enum {
+    TRACE_BEGIN = 0,
+    TRACE_END = 1,
+  } TraceEventType;
+
+  class Trace {
+  public:
+    // start() - Start recording (events from before start() are dropped)
+    static void start();
+    static void stop();
+    static inline bool recording() {
+      return recording_.load(std::memory_order_relaxed);
+    }
+
+    // begin() / end() - Prefer JTIL_TRACE_SCOPE.  name must outlive the
+    // trace (ie, a string literal).
+    static void begin(const char* name);
+    static void end(const char* name);
+
+    // setThreadName() - Name the calling thread in the trace
+    static void setThreadName(const char* name);
+
+    // writeChromeJSON() - The events recorded between the last start() and
+    // stop() (or now).  Safe to call while other threads are recording.
+    static void writeChromeJSON(std::ostream& out);
+    static void saveChromeJSON(const std::string& filename);
+
+  private:
+    static std::atomic<bool> recording_;
+  };
+
+  class TraceScope {
+  public:
+    explicit TraceScope(const char* name) : name_(name),
+      began_(Trace::recording()) {
+      if (began_) {
+        Trace::begin(name_);
+      }
+    }
+    // Ends the scope even if the recording was stopped in the meantime, so
+    // begin and end events stay paired
+    ~TraceScope() {
+      if (began_) {
+        Trace::end(name_);
+      }
+    }
+
+  private:
+    const char* name_;
+    bool began_;
+
+    // Non-copyable, non-assignable.
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+  };
+
+};  // namespace debug
+};  // namespace jtil
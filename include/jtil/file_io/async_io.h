@@ -0,0 +1,167 @@
+//
+//  async_io.h
+//
+//  Reads whole files on dedicated I/O threads so the caller (and the
+//  ThreadPool) never blocks on the disk.  read() queues a request and returns
+//  a handle straight away; the optional completion callback runs on a
+//  ThreadPool worker (if the service was given a pool) so decompression and
+//  parsing of one file overlap with the reads of the next ones:
+//
+//    AsyncIO io(2, &tp);
+//    for (...) {
+//      requests.pushBack(io.read(filename,
+//        MakeCallableOnce(&Scene::decodeModel, this)));
+//    }
+//    for (...) { requests[i]->wait(); delete requests[i]; }
+//
+//  Backends:
+//  ASYNC_IO_PREAD - Each I/O thread reads one file at a time with pread()
+//  (std::ifstream on Windows).  Before reading a file it asks the kernel to
+//  start reading the next ASYNC_IO_READ_AHEAD queued files into the page
+//  cache (posix_fadvise WILLNEED), so the disk stays busy between requests.
+//  ASYNC_IO_URING - Linux only.  Each I/O thread keeps up to
+//  ASYNC_IO_URING_DEPTH files in flight on its own io_uring.  If the kernel
+//  doesn't support io_uring (or it is disabled) the service falls back to
+//  ASYNC_IO_PREAD, see backend().
+//
+//  The caller owns the returned requests.  Deleting one waits for it to
+//  finish (including its callback), so never delete a request from its own
+//  callback.  Delete the requests before the service, whose destructor
+//  finishes every queued request first.
+//
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <string>
+#include <condition_variable>
+#include "jtil/math/math_types.h"  // for uint8_t, uint64_t
+#include "jtil/threading/callback.h"
+#include "jtil/threading/callback_queue.h"
+
+#define ASYNC_IO_CHUNK_SIZE (1 << 20)  // Bytes per read call
+#define ASYNC_IO_READ_AHEAD 4  // Queued files to prefetch (ASYNC_IO_PREAD)
+#define ASYNC_IO_URING_DEPTH 16  // Files in flight per thread (ASYNC_IO_URING)
+
+namespace jtil {
+namespace threading { class ThreadPool; }
+namespace file_io {
+
+  typedef enum {
+    ASYNC_IO_PREAD = 0,
+    ASYNC_IO_URING = 1,
+  } AsyncIOBackend;
+
+  class AsyncIO;
+
+  class AsyncIORequest {
+  public:
+    // ~AsyncIORequest() - Waits for the request to finish
+    ~AsyncIORequest();
+
+    void wait();  // Until the data is read and the callback has returned
+    bool done() const;
+
+    // The accessors below are only valid once done() (or inside the
+    // callback, where the read has finished but done() is still false)
+    inline bool ok() const { return error_.empty(); }
+    inline const std::string& error() const { return error_; }
+    inline const std::string& filename() const { return filename_; }
+    // data() - The file's contents, followed by a 0 byte (not included in
+    // size()) so that text can be parsed in place
+    inline uint8_t* data() { return data_; }
+    inline uint64_t size() const { return size_; }
+    // releaseData() - Take ownership of data() (free it with delete[])
+    uint8_t* releaseData();
+
+  private:
+    friend class AsyncIO;
+    AsyncIORequest(AsyncIO* io, const std::string& filename,
+      threading::Callback<void, AsyncIORequest*>* on_complete);
+
+    AsyncIO* io_;  // not owned here
+    std::string filename_;
+    threading::Callback<void, AsyncIORequest*>* on_complete_;
+    uint8_t* data_;
+    uint64_t size_;
+    uint64_t offset_;  // Bytes read so far
+    int fd_;  // -1 until opened (POSIX backends)
+    std::string error_;
+    bool prefetching_;  // Being opened by read ahead, protected by queue_lock_
+    bool done_;  // Protected by io_->done_lock_
+
+    // Non-copyable, non-assignable.
+    AsyncIORequest(const AsyncIORequest&);
+    AsyncIORequest& operator=(const AsyncIORequest&);
+  };
+
+  class AsyncIO {
+  public:
+    // tp - Where callbacks run, or NULL to run them on the I/O threads (in
+    // which case they should be short).  Not owned here.  Once tp is stopped
+    // the callbacks run on the I/O threads too, but stop it only after the
+    // requests are done: callbacks still queued on it would be dropped.
+    explicit AsyncIO(const int num_threads = 2,
+      threading::ThreadPool* tp = NULL,
+      const AsyncIOBackend backend = ASYNC_IO_PREAD);
+    // ~AsyncIO() - Finishes every queued request
+    ~AsyncIO();
+
+    // read() - Queue a read of the whole file.  on_complete (may be NULL)
+    // is called with the request once it has been read (check ok()).  If
+    // on_complete is a once callback it is deleted after it's called.
+    AsyncIORequest* read(const std::string& filename,
+      threading::Callback<void, AsyncIORequest*>* on_complete = NULL);
+
+    // backend() - The backend actually in use
+    inline AsyncIOBackend backend() const { return backend_; }
+    inline int numThreads() const { return num_threads_; }
+
+  private:
+    friend class AsyncIORequest;
+
+    threading::ThreadPool* tp_;  // not owned here
+    AsyncIOBackend backend_;
+    int num_threads_;
+    std::thread* threads_;
+    std::mutex queue_lock_;
+    std::condition_variable queue_cv_;
+    threading::CallbackQueue<AsyncIORequest*> queue_;  // Protected by lock
+    // The requests at the back of queue_ that read ahead hasn't opened yet
+    threading::CallbackQueue<AsyncIORequest*> prefetch_queue_;
+    std::condition_variable prefetch_cv_;  // A prefetching_ request is open
+    bool stop_;  // Protected by queue_lock_
+    std::mutex done_lock_;
+    std::condition_variable done_cv_;
+    int num_pending_;  // Requests not done yet, protected by done_lock_
+
+    void threadMain(int thread_index);
+    // Returns NULL once stop_ is set and the queue is empty
+    AsyncIORequest* dequeue(const bool block);
+    void readAheadQueued();
+    void readPread(AsyncIORequest* request);
+    // Opens the file (unless read ahead did) and allocates the buffer, false
+    // (and error_ set) on failure
+    bool open(AsyncIORequest* request);
+    void close(AsyncIORequest* request);
+    // finish() - Run the callback (on the pool if we have one) and wake the
+    // waiters
+    void finish(AsyncIORequest* request);
+    void complete(AsyncIORequest* request);
+
+#if defined(__linux__)
+    struct Uring;
+    static Uring* createUring();
+    static void destroyUring(Uring* uring);
+    void uringMain(Uring* uring);
+    bool uringSubmitRead(Uring* uring, AsyncIORequest* request);
+#endif
+
+    // Non-copyable, non-assignable.
+    AsyncIO(const AsyncIO&);
+    AsyncIO& operator=(const AsyncIO&);
+  };
+
+};  // namespace file_io
+};  // namespace jtil
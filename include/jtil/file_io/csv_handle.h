@@ -7,11 +7,10 @@
 #pragma once
 
 #include <string>
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
 
-namespace data_str { template <typename T> class VectorManaged; }
-
 namespace file_io {
   class CSVHandle { 
   public:
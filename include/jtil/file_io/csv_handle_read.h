@@ -9,9 +9,9 @@
 #include <string>
 #include <fstream>
 #include "jtil/file_io/csv_handle.h"
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
-namespace data_str { template <typename T> class VectorManaged; }
 
 namespace file_io {
 
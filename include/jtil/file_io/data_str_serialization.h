@@ -10,10 +10,10 @@
 
 #include <string>
 #include "jtil/math/math_types.h"
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
 
-namespace data_str { template <typename T> class Vector; }
 namespace renderer { struct Material; }
 
 namespace file_io {
@@ -12,8 +12,7 @@
 #include <fstream>
 #include "jtil/math/math_types.h"
 #include "jtil/exceptions/wruntime_error.h"
-
-namespace jtil { namespace data_str { template <typename T> class VectorManaged; } }
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
 namespace file_io {
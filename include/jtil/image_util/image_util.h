@@ -19,6 +19,7 @@
 #include "jtil/exceptions/wruntime_error.h"
 #include "jtil/math/math_types.h"
 #include "jtil/math/math_base.h"
+#include "jtil/threading/thread_pool.h"
 
 #define USE_OMP
 #define OMP_THREADS 4
@@ -556,11 +557,59 @@ namespace image_util {
 		}
 	};
 
+  // Integral image row pass: sum accross x for rows [b, e)
+  template <class T>
+  struct IntegralImageRows {
+    IntegralImageRows(double* integral_im, const T* src, const int32_t width) 
+      : integral_im(integral_im), src(src), width(width) { }
+    void operator()(const int32_t b, const int32_t e) const {
+      for (int32_t y = b; y < e; y++) {
+        double* row = &integral_im[y * width];
+        const T* src_row = &src[y * width];
+        row[0] = (double)src_row[0];
+        for (int32_t x = 1; x < width; x++) {
+          row[x] = row[x - 1] + (double)src_row[x];
+        }
+      }
+    }
+    double* integral_im;
+    const T* src;
+    const int32_t width;
+  };
+
+  // Integral image column pass: sum accross y for columns [b, e)
+  struct IntegralImageCols {
+    IntegralImageCols(double* integral_im, const int32_t width, 
+      const int32_t height) : integral_im(integral_im), width(width), 
+      height(height) { }
+    void operator()(const int32_t b, const int32_t e) const {
+      for (int32_t y = 1; y < height; y++) {
+        double* row = &integral_im[y * width];
+        const double* prev_row = &integral_im[(y - 1) * width];
+        for (int32_t x = b; x < e; x++) {
+          row[x] = prev_row[x] + row[x];
+        }
+      }
+    }
+    double* integral_im;
+    const int32_t width;
+    const int32_t height;
+  };
+
   // Source can be arbitrary precision, but the destination precision is
-  // double.
+  // double.  If tp is not NULL then the work is split accross its workers
+  // (otherwise OpenMP is used, if USE_OMP is defined).
   template <class T>
 	void IntegralImage(double* integral_im, T* src, const int32_t width, 
-    const int32_t height) {
+    const int32_t height, threading::ThreadPool* tp = NULL) {
+    if (tp != NULL) {
+      tp->parallelFor(0, height, 0, IntegralImageRows<T>(integral_im, src, 
+        width));
+      tp->parallelFor(0, width, 0, IntegralImageCols(integral_im, width, 
+        height));
+      return;
+    }
+
     // Copy over the first column into the double array
 #ifdef USE_OMP
     #pragma omp parallel for num_threads(OMP_THREADS)
@@ -902,57 +951,85 @@ namespace image_util {
   //     image with from the input data at double precision.
   // --> Requires a preallocated temporary array same size as the source
   // TODO - This REALLY needs cleaning up.  There should be ONE function
+  // The per-row work of FracDownsampleImageSAT for dst rows [b, e)
   template <class T>
-  void FracDownsampleImageSAT(T* dst, const int32_t dx, const int32_t dy, 
-    const int32_t dw, const int32_t dh, const int32_t ds, T* src, 
-    const int32_t sx, const int32_t sy, const int32_t sw, const int32_t sh, 
-    const int32_t ss, const int32_t stotalh, double* tmp_array) {
-
-    // EPSILON - Important for rounding integer downsample values?
-    double upScaleX = ((double)sw) / ((double)dw);
-		double upScaleY = ((double)sh) / ((double)dh); 
-
-    IntegralImage<float>(tmp_array, src, ss, stotalh);
-
-    for (int32_t y = dy; y < dy + dh; y++) {
-      double st = (double)(y - dy) * upScaleY + (double)sy - 1.0;
-      double sb = (double)(y + 1 - dy) * upScaleY + (double)sy - 1.0;
-      if (st >= -1 && sb < stotalh) {
+  struct FracDownsampleImageSATRows {
+    FracDownsampleImageSATRows(T* dst, const int32_t dx, const int32_t dy, 
+      const int32_t dw, const int32_t dh, const int32_t ds, const int32_t sx, 
+      const int32_t sy, const int32_t sw, const int32_t sh, const int32_t ss, 
+      const int32_t stotalh, const double* tmp_array, const bool use_omp) : 
+      dst(dst), dx(dx), dy(dy), dw(dw), ds(ds), sx(sx), sy(sy), ss(ss),
+      stotalh(stotalh), tmp_array(tmp_array), use_omp(use_omp) {
+      // EPSILON - Important for rounding integer downsample values?
+      upScaleX = ((double)sw) / ((double)dw);
+      upScaleY = ((double)sh) / ((double)dh); 
+    }
+    void operator()(const int32_t b, const int32_t e) const {
+      for (int32_t y = b; y < e; y++) {
+        double st = (double)(y - dy) * upScaleY + (double)sy - 1.0;
+        double sb = (double)(y + 1 - dy) * upScaleY + (double)sy - 1.0;
+        if (st >= -1 && sb < stotalh) {
 #ifdef USE_OMP
-        #pragma omp parallel for num_threads(OMP_THREADS)
+          #pragma omp parallel for num_threads(OMP_THREADS) if(use_omp)
 #endif
-        for (int32_t x = dx; x < dx + dw; x++) {
-          double sl = (double)(x - dx) * upScaleX + (double)sx - 1.0;
-          double sr = (double)(x + 1 - dx) * upScaleX + (double)sx - 1.0;
-          int di = x + y * ds;
-          if (sl >= -1 && sr < ss) {
-            double A = SampleBilerpSAT<double, double>(tmp_array, sl, st, ss);
-            double B = SampleBilerpSAT<double, double>(tmp_array, sr, st, ss);
-            double C = SampleBilerpSAT<double, double>(tmp_array, sl, sb, ss);
-            double D = SampleBilerpSAT<double, double>(tmp_array, sr, sb, ss);
-
-            //  0  1  2  3
-            //  4  5  6  7 
-            //  8  9 10 11
-            // 12 13 14 15
-            // If sl = 0, sr = 2, st = 0, sb = 2 --> Then SAT will find the 
-            // rectangle sum rooted at (sb, sr) to (sl+1, st+1)
-            // which is 10 + 6 + 9 + 5 in the above example.
-
-            double sum = (A + D) - (B + C);
-            double area = std::max<double>((sr - sl) * (sb - st), EPSILON); 
-            dst[di] = (T)(sum / area);  // EDIT: used to be sum * area!
-          } else {
-            dst[di] = 0;						
+          for (int32_t x = dx; x < dx + dw; x++) {
+            double sl = (double)(x - dx) * upScaleX + (double)sx - 1.0;
+            double sr = (double)(x + 1 - dx) * upScaleX + (double)sx - 1.0;
+            int di = x + y * ds;
+            if (sl >= -1 && sr < ss) {
+              double A = SampleBilerpSAT<double, double>(tmp_array, sl, st, ss);
+              double B = SampleBilerpSAT<double, double>(tmp_array, sr, st, ss);
+              double C = SampleBilerpSAT<double, double>(tmp_array, sl, sb, ss);
+              double D = SampleBilerpSAT<double, double>(tmp_array, sr, sb, ss);
+
+              //  0  1  2  3
+              //  4  5  6  7 
+              //  8  9 10 11
+              // 12 13 14 15
+              // If sl = 0, sr = 2, st = 0, sb = 2 --> Then SAT will find the 
+              // rectangle sum rooted at (sb, sr) to (sl+1, st+1)
+              // which is 10 + 6 + 9 + 5 in the above example.
+
+              double sum = (A + D) - (B + C);
+              double area = std::max<double>((sr - sl) * (sb - st), EPSILON); 
+              dst[di] = (T)(sum / area);  // EDIT: used to be sum * area!
+            } else {
+              dst[di] = 0;						
+            }
+          }
+        } else {
+          for (int32_t x = dx; x < dx + dw; x++) {
+            int32_t di = x + y * ds;
+            dst[di] = (T)0;
           }
-        }
-      } else {
-        for (int32_t x = dx; x < dx + dw; x++) {
-          int32_t di = x + y * ds;
-          dst[di] = (T)0;
         }
       }
     }
+    T* dst;
+    const int32_t dx, dy, dw, ds, sx, sy, ss, stotalh;
+    const double* tmp_array;
+    const bool use_omp;
+    double upScaleX;
+    double upScaleY;
+  };
+
+  // If tp is not NULL then the rows are split accross its workers (otherwise
+  // OpenMP is used, if USE_OMP is defined).
+  template <class T>
+  void FracDownsampleImageSAT(T* dst, const int32_t dx, const int32_t dy, 
+    const int32_t dw, const int32_t dh, const int32_t ds, T* src, 
+    const int32_t sx, const int32_t sy, const int32_t sw, const int32_t sh, 
+    const int32_t ss, const int32_t stotalh, double* tmp_array,
+    threading::ThreadPool* tp = NULL) {
+    IntegralImage<float>(tmp_array, src, ss, stotalh, tp);
+
+    FracDownsampleImageSATRows<T> rows(dst, dx, dy, dw, dh, ds, sx, sy, sw, 
+      sh, ss, stotalh, tmp_array, tp == NULL);
+    if (tp != NULL) {
+      tp->parallelFor(dy, dy + dh, 0, rows);
+    } else {
+      rows(dy, dy + dh);
+    }
   };
 
   // FracDownsampleImagePoint
@@ -9,8 +9,7 @@
 #define COST_KERNEL_LENGTH 0.025f  // As a fraction of the total contour length
 
 #include "jtil/math/math_types.h"
-
-namespace data_str { template <typename T> class Vector; }
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
 namespace image_util {
@@ -21,6 +20,7 @@ namespace marching_squares {
     Contour(const math::Float2& v1, const uint32_t contour_index, 
       const uint32_t curr);
     Contour();
+    Contour(const Contour& a);  // Same as operator=
     math::Float2 v1;
     uint32_t next;  
     uint32_t prev;
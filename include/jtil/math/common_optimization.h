@@ -10,6 +10,7 @@
 
 #include "jtil/math/math_types.h"
 #include "jtil/data_str/vector.h"
+#include "jtil/math/random.h"
 
 // TODO: Move these to math_base (not common_optimization)
 #if defined(WIN32) || defined(_WIN32)
@@ -67,6 +68,8 @@ namespace math {
     float* best_pos;  // num_coeffs
     float residue;
     float best_residue;
+    Rand rand;  // The particle's own stream, so particles can be updated in
+                // any order (or in parallel) and give the same result
   };
 
 };  // namespace math
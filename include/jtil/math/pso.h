@@ -14,7 +14,7 @@
 
 #pragma once
 
-#include <random>
+#include <cstring>
 #include "jtil/math/math_types.h"
 #include "jtil/math/common_optimization.h"
 
@@ -60,6 +60,8 @@ namespace math {
     float phi_p;
     float phi_g;
     bool verbose;  // Set to true for detailed output
+    // Random seed, each minimize() restarts from it so runs are reproducible
+    uint64_t seed;
   
   private:
     uint32_t num_coeffs_;
@@ -76,8 +78,6 @@ namespace math {
 
     SwarmNode** swarm_;
 
-    static MERSINE_TWISTER_ENG eng;
-    static UNIFORM_REAL_DISTRIBUTION dist_real;
     
     float interpolateCoeff(const float a, const float interp_val, 
       const float b, const float c, bool angle);
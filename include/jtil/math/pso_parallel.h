@@ -13,7 +13,7 @@
 #define NTILES_DIM 8  // Number of tiles in the x and y dimensions
 #define NTILES (NTILES_DIM * NTILES_DIM)  // Total number of tiles
 
-#include <random>
+#include <cstring>
 #include "jtil/math/math_types.h"
 #include "jtil/math/common_optimization.h"
 #include "jtil/data_str/vector.h"
@@ -62,6 +62,8 @@ namespace math {
     float c_g;
     float kappa;
     bool verbose;  // Set to true for detailed output
+    // Random seed, each minimize() restarts from it so runs are reproducible
+    uint64_t seed;
 
   private:
     ObjectFuncParallelPtr obj_func_parallel_;
@@ -85,8 +87,6 @@ namespace math {
     SwarmNode** swarm_;
     SwarmNode** ordered_swarm_;
 
-    static MERSINE_TWISTER_ENG eng;
-    static UNIFORM_REAL_DISTRIBUTION dist_real;
     
     // ret = a + interp_val * (b - c)
     // float interpolateCoeff(const float a, const float interp_val, 
@@ -0,0 +1,77 @@
+//
+//  random.h
+//
+//  A small, fast and explicitly seeded random number generator (xoroshiro128+
+//  seeded through splitmix64).  Unlike the std engines it is cheap to create
+//  one per thread or per particle, so parallel code can draw numbers without
+//  sharing (or locking) a generator:
+//
+//    Rand rand(seed, particle_index);  // One independent stream per particle
+//    float r = rand.uniform();  // [0, 1)
+//    rand.normal(noise, 1024, 0, 0.1f);  // Fill a buffer
+//
+//  The same seed and stream always give the same sequence, on every platform
+//  (no std distribution is involved), including the batch functions whether
+//  or not they are built with SSE2.
+//
+
+#pragma once
+
+#include "jtil/math/math_types.h"  // for uint64_t
+
+namespace jtil {
+namespace math {
+
+  class Rand {
+  public:
+    explicit Rand(const uint64_t seed = 0, const uint64_t stream = 0);
+
+    // seed() - Restart the sequence.  Different streams of the same seed are
+    // statistically independent (their starting states are hashed apart).
+    void seed(const uint64_t seed, const uint64_t stream = 0);
+    // jump() - Advance by 2^64 draws, to split a stream into parts that are
+    // guaranteed not to overlap
+    void jump();
+
+    inline uint64_t next();
+    inline uint32_t nextU32() { return static_cast<uint32_t>(next() >> 32); }
+    inline float uniform();  // [0, 1)
+    inline float uniform(const float lo, const float hi);  // [lo, hi)
+    float normal();  // Mean 0, std dev 1
+    float normal(const float mean, const float std_dev);
+
+    // Batch versions (the fast way to get many numbers).  They take 2
+    // numbers from each 64 bit draw, so they don't give the same numbers as
+    // n calls to the scalar versions.
+    void uniform(float* dst, const uint32_t n, const float lo = 0,
+      const float hi = 1);
+    void normal(float* dst, const uint32_t n, const float mean = 0,
+      const float std_dev = 1);
+
+  private:
+    uint64_t s_[2];
+    float spare_normal_;
+    bool has_spare_normal_;
+  };
+
+  uint64_t Rand::next() {
+    const uint64_t s0 = s_[0];
+    uint64_t s1 = s_[1];
+    const uint64_t result = s0 + s1;
+    s1 ^= s0;
+    s_[0] = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+    s_[1] = (s1 << 37) | (s1 >> 27);
+    return result;
+  }
+
+  float Rand::uniform() {
+    // The top 24 bits (the low bits of xoroshiro128+ are weaker)
+    return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+  }
+
+  float Rand::uniform(const float lo, const float hi) {
+    return lo + (hi - lo) * uniform();
+  }
+
+};  // namespace math
+};  // namespace jtil
@@ -29,7 +29,7 @@ namespace math {
   public:
     Vec2();
     explicit Vec2(const T* data);
-    Vec2(const Vec2& data);
+    // The implicit copy constructor keeps Vec2 trivially copyable
     Vec2(const T x, const T y);
 
     // Getter methods
@@ -86,12 +86,6 @@ namespace math {
     m[1] = data[1];
   };
 
-  template <class T>
-  Vec2<T>::Vec2(const Vec2& data) {
-    m[0] = data.m[0];
-    m[1] = data.m[1];
-  };
-
   template <class T>
   Vec2<T>::Vec2(const T x, const T y) {
     m[0] = x;
@@ -34,7 +34,7 @@ namespace math {
   public:
     Vec3();
     explicit Vec3(const T* data);
-    Vec3(const Vec3& data);
+    // The implicit copy constructor keeps Vec3 trivially copyable
     Vec3(T x, T y, T z);
 
     // Getter methods
@@ -99,13 +99,6 @@ namespace math {
     m[2] = data[2];
   };
 
-  template <class T>
-  Vec3<T>::Vec3(const Vec3& data) {
-    m[0] = data.m[0];
-    m[1] = data.m[1];
-    m[2] = data.m[2];
-  };
-
   template <class T>
   Vec3<T>::Vec3(const T x, const T y, const T z) {
     m[0] = x;
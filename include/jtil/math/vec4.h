@@ -31,7 +31,7 @@ namespace math {
    public:
     Vec4();
     explicit Vec4(const T* data);
-    Vec4(const Vec4& data);
+    // The implicit copy constructor keeps Vec4 trivially copyable
     Vec4(const T x, const T y, const T z, const T w);
 
     // Getter methods
@@ -92,14 +92,6 @@ namespace math {
     m[3] = data[3];
   };
 
-  template <class T>
-  Vec4<T>::Vec4(const Vec4& data) {
-    m[0] = data.m[0];
-    m[1] = data.m[1];
-    m[2] = data.m[2];
-    m[3] = data.m[3];
-  };
-
   template <class T>
   Vec4<T>::Vec4(const T x, const T y, const T z, const T w) {
     m[0] = x;
@@ -22,6 +22,7 @@
 #include "jtil/math/math_types.h"
 #include "jtil/renderer/geometry/geometry.h"  // For GeometryType
 #include "jtil/renderer/texture/texture.h"  // For TEXTURE_WRAP_MODE
+#include "jtil/data_str/vector_fwd.h"
 
 struct aiScene;
 struct aiNode;
@@ -37,9 +38,7 @@ namespace Assimp { class Importer; }
 namespace jtil {
 namespace data_str {template <typename TFirst, typename TSecond> class Pair;}
 namespace data_str {template <class TKey, class TValue> class HashMapManaged;}
-namespace data_str {template <class TKey, class TValue> class HashMap;}
-namespace data_str {template <typename T> class VectorManaged;}
-namespace data_str {template <typename T> class Vector;}
+namespace data_str {template <class TKey, class TValue> class FlatHashMap;}
 
 namespace renderer {
 
@@ -164,7 +163,7 @@ namespace renderer {
     // The global scene graph and geometry pool used by the renderer
     GeometryInstance* scene_root_;
     data_str::HashMapManaged<std::string, Geometry*>* geom_;
-    data_str::HashMap<std::string, uint32_t>* bone_name_to_index_;
+    data_str::FlatHashMap<std::string, uint32_t>* bone_name_to_index_;
     data_str::VectorManaged<Bone*>* bones_;
     data_str::Vector<GeometryInstance*>* render_stack_;
 
@@ -8,9 +8,9 @@
 #pragma once
 
 #include "jtil/math/math_types.h"
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
-namespace data_str { template <typename T> class Vector; }
 
 namespace renderer {
 namespace mesh_simplification {
@@ -13,6 +13,7 @@
 #include "jtil/renderer/gl_include.h"
 #include "jtil/math/math_types.h"
 #include "jtil/data_str/pair.h"
+#include "jtil/data_str/vector_fwd.h"
 
 #define MAX_NUM_TEXTURE_UNITS 256
 //#define FORCE_STATE_SETTING  // Define to force all redundant state changes
@@ -23,7 +24,6 @@
 
 namespace jtil {
 
-namespace data_str { template <typename T> class VectorManaged; }
 namespace data_str { template <class TKey, class TValue> class HashMap; }
 
 namespace renderer {
@@ -7,11 +7,10 @@
 #pragma once
 
 #include "jtil/math/math_types.h"
+#include "jtil/data_str/vector_fwd.h"
 
 namespace jtil {
 
-namespace data_str { template <typename T> class Vector; }
-
 namespace renderer {
 
   class Frustum;
@@ -12,6 +12,7 @@
 #include "jtil/math/math_types.h"
 #include "jtil/windowing/window_cb.h"  // For CBFuncPtr types
 #include "jtil/windowing/window_interface.h"  // For WindowInterface class
+#include "jtil/data_str/vector_fwd.h"
 
 #ifndef BUFFER_OFFSET
 	#define BUFFER_OFFSET(bytes) ((GLubyte*) NULL + bytes)
@@ -21,7 +22,6 @@ namespace jtil {
 
 namespace clk { class Clk; }
 namespace settings { class SettingsManager; }
-namespace data_str { template <typename T> class VectorManaged; }
 namespace settings { class SettingsManager; }
 namespace windowing { class Window; }
 namespace ui { class UI; }
@@ -7,9 +7,11 @@
 #ifdef _WIN32
   #define INLINE __inline
   #define FORCEINLINE __forceinline
+  #define JTIL_NOINLINE __declspec(noinline)
 #else
   #define INLINE
   #define FORCEINLINE
+  #define JTIL_NOINLINE __attribute__((noinline))
 #endif
 
 #define pp_repeat(count, macro, data) pp_repeat_i(count, macro, data) 
@@ -9,12 +9,195 @@
 //  for C++11 since thread function inputs are required to be static.  Using
 //  these callback wrappers allows us to call a thread on a class's non-static
 //  member function.
+//
+//  MakeCallableOnce(&Target::func, obj, binds...) binds the first N arguments
+//  of func, the remaining arguments are passed to operator().  Once callbacks
+//  delete themselves after they are called, Many callbacks must be deleted by
+//  the caller.  This used to be a generated header (callback_instances.h, up
+//  to 8 arguments), it is now variadic so there is no limit.
+//
+//  Every MakeCallableXXX call allocates.  For small void() jobs on a
+//  ThreadPool use Task (task.h) instead, which is stored by value.
+//
 
 #pragma once
 
-#include "jtil/threading/callback_instances.h"
+#include <utility>  // For std::forward
+
+namespace jtil {
+namespace threading {
+
+  template <typename Res, typename... Args>
+  class Callback {
+  public:
+    virtual ~Callback() {}
+
+    virtual Res operator()(Args...) = 0;
+    virtual bool once() const = 0;
+  };
+
+  // A list of types
+  template <typename... T>
+  struct CallbackTypes {};
+
+  template <typename List>
+  struct CallbackTypesPop;
+  template <typename T0, typename... T>
+  struct CallbackTypesPop<CallbackTypes<T0, T...> > {
+    typedef T0 head;
+    typedef CallbackTypes<T...> tail;
+  };
+
+  template <typename List, typename T1>
+  struct CallbackTypesPush;
+  template <typename... T, typename T1>
+  struct CallbackTypesPush<CallbackTypes<T...>, T1> {
+    typedef CallbackTypes<T..., T1> type;
+  };
+
+  // Move the first N types of Rest onto the end of Bound
+  template <int N, typename Bound, typename Rest>
+  struct CallbackSplit {
+    typedef CallbackTypesPop<Rest> pop;
+    typedef CallbackSplit<N - 1,
+      typename CallbackTypesPush<Bound, typename pop::head>::type,
+      typename pop::tail> next;
+    typedef typename next::bound bound;
+    typedef typename next::unbound unbound;
+  };
+  template <typename Bound, typename Rest>
+  struct CallbackSplit<0, Bound, Rest> {
+    typedef Bound bound;
+    typedef Rest unbound;
+  };
+
+  // A compile time list of the integers 0 to N-1 (to unpack CallbackArgs)
+  template <int... I>
+  struct CallbackIndices {};
+  template <int N, int... I>
+  struct CallbackMakeIndices : CallbackMakeIndices<N - 1, N - 1, I...> {};
+  template <int... I>
+  struct CallbackMakeIndices<0, I...> {
+    typedef CallbackIndices<I...> type;
+  };
+
+  // Storage for bound arguments.  Unlike std::tuple it is trivially copyable
+  // when all the T are (which Task relies on).
+  template <typename... T>
+  struct CallbackArgs;
+  template <>
+  struct CallbackArgs<> {
+    CallbackArgs() { }
+  };
+  template <typename T0, typename... T>
+  struct CallbackArgs<T0, T...> {
+    CallbackArgs(T0 head, T... tail) : head(head), tail(tail...) { }
+    T0 head;
+    CallbackArgs<T...> tail;
+  };
+
+  template <int I, typename Args>
+  struct CallbackArgsGet;
+  template <typename T0, typename... T>
+  struct CallbackArgsGet<0, CallbackArgs<T0, T...> > {
+    typedef T0 type;
+    static inline type& get(CallbackArgs<T0, T...>& args) { return args.head; }
+  };
+  template <int I, typename T0, typename... T>
+  struct CallbackArgsGet<I, CallbackArgs<T0, T...> > {
+    typedef CallbackArgsGet<I - 1, CallbackArgs<T...> > next;
+    typedef typename next::type type;
+    static inline type& get(CallbackArgs<T0, T...>& args) {
+      return next::get(args.tail);
+    }
+  };
+
+  template <bool Once, typename Target, typename Res, typename Bound,
+    typename Unbound>
+  class Callable;
+
+  template <bool Once, typename Target, typename Res, typename... Bind,
+    typename... Args>
+  class Callable<Once, Target, Res, CallbackTypes<Bind...>,
+    CallbackTypes<Args...> > : public Callback<Res, Args...> {
+  public:
+    typedef Res(Target::*TargetFunc)(Bind..., Args...);
+
+    template <typename... B>
+    Callable(TargetFunc target_func, Target* obj, B&&... binds)
+      : target_func_(target_func), obj_(obj),
+        binds_(std::forward<B>(binds)...) { }
+
+    virtual ~Callable() {}
+
+    virtual Res operator()(Args... args) {
+      DeleteIfOnce deleter(this);
+      return call(typename CallbackMakeIndices<sizeof...(Bind)>::type(),
+        std::forward<Args>(args)...);
+    }
+
+    virtual bool once() const {
+      return Once;
+    }
+
+  private:
+    TargetFunc target_func_;  // not owned here
+    Target* obj_;             // not owned here
+    CallbackArgs<Bind...> binds_;
+
+    // Deletes the callback on the way out of operator() (after the return
+    // value has been constructed)
+    struct DeleteIfOnce {
+      explicit DeleteIfOnce(Callable* callable) : callable(callable) { }
+      ~DeleteIfOnce() {
+        if (Once) {
+          delete callable;
+        }
+      }
+      Callable* callable;
+    };
+
+    template <int... I>
+    inline Res call(CallbackIndices<I...>, Args... args) {
+      return ((*obj_).*target_func_)(
+        CallbackArgsGet<I, CallbackArgs<Bind...> >::get(binds_)...,
+        std::forward<Args>(args)...);
+    }
+  };
+
+  template <bool Once, typename Target, typename Res, typename Params,
+    int NumBound>
+  struct CallableType;
+  template <bool Once, typename Target, typename Res, typename... Params,
+    int NumBound>
+  struct CallableType<Once, Target, Res, CallbackTypes<Params...>, NumBound> {
+    typedef CallbackSplit<NumBound, CallbackTypes<>,
+      CallbackTypes<Params...> > split;
+    typedef Callable<Once, Target, Res, typename split::bound,
+      typename split::unbound> type;
+  };
+
+  template <typename Target, typename Res, typename... Params,
+    typename... Binds>
+  typename CallableType<true, Target, Res, CallbackTypes<Params...>,
+    sizeof...(Binds)>::type*
+  MakeCallableOnce(Res (Target::*f)(Params...), Target* obj,
+    Binds&&... binds) {
+    return new typename CallableType<true, Target, Res,
+      CallbackTypes<Params...>, sizeof...(Binds)>::type(f, obj,
+      std::forward<Binds>(binds)...);
+  }
+
+  template <typename Target, typename Res, typename... Params,
+    typename... Binds>
+  typename CallableType<false, Target, Res, CallbackTypes<Params...>,
+    sizeof...(Binds)>::type*
+  MakeCallableMany(Res (Target::*f)(Params...), Target* obj,
+    Binds&&... binds) {
+    return new typename CallableType<false, Target, Res,
+      CallbackTypes<Params...>, sizeof...(Binds)>::type(f, obj,
+      std::forward<Binds>(binds)...);
+  }
 
-// If you need more template arguments, you can generate a new 
-// callback_instances.h file by typing:
-// >> python callback_instances.py N
-// with N being the maximum number of arguments you want.  By default I have 8.
+};  // namespace threading
+};  // namespace jtil
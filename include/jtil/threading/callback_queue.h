@@ -5,6 +5,10 @@
 //
 //  This is a NON-THREADSAFE templatized queue of pointers used for storing the
 //  pending callbacks for execution in the class ThreadPool
+//
+//  Dequeued items are kept on a free list and reused by the next enqueue, so
+//  once the queue has reached its peak size it no longer allocates.  clear()
+//  releases everything.
 
 #pragma once
 
@@ -48,13 +52,17 @@ namespace threading {
   private:
     CallbackQueueItem<T>* head_;
     CallbackQueueItem<T>* tail_;
+    CallbackQueueItem<T>* free_;  // Singly linked list of unused items
     int num_elements_;
+
+    void release(CallbackQueueItem<T>* item);
   };
   
   template <typename T>
   CallbackQueue<T>::CallbackQueue() {
     head_ = NULL;
     tail_ = NULL;
+    free_ = NULL;
     num_elements_ = 0;
   }
   
@@ -71,6 +79,11 @@ namespace threading {
       head_ = head_->next;
       delete old_head;
     }
+    while (free_ != NULL) {
+      old_head = free_;
+      free_ = free_->next;
+      delete old_head;
+    }
     tail_ = NULL;
     num_elements_ = 0;
   }
@@ -82,7 +95,15 @@ namespace threading {
   
   template <typename T>
   void CallbackQueue<T>::enqueue(const T& newItem) {
-    CallbackQueueItem<T>* p_cur_item = new CallbackQueueItem<T>(newItem);
+    CallbackQueueItem<T>* p_cur_item;
+    if (free_ != NULL) {
+      p_cur_item = free_;
+      free_ = free_->next;
+      p_cur_item->next = NULL;
+      p_cur_item->data = newItem;
+    } else {
+      p_cur_item = new CallbackQueueItem<T>(newItem);
+    }
     if (head_ == NULL)
       head_ = p_cur_item;
     if (tail_ != NULL)
@@ -99,17 +120,23 @@ namespace threading {
     }
     T ret_val = head_->data;
     if (head_ == tail_) {  // one element left in the queue
-      delete head_;
+      release(head_);
       head_ = NULL;
       tail_ = NULL;
     } else {  // more than one element left in the queue
       CallbackQueueItem<T>* old_head = head_;
       head_ = head_->next;
-      delete old_head;
+      release(old_head);
     }
     num_elements_--;
     return ret_val;
   }
+
+  template <typename T>
+  void CallbackQueue<T>::release(CallbackQueueItem<T>* item) {
+    item->next = free_;
+    free_ = item;
+  }
   
   template <typename T>
   T CallbackQueue<T>::peak() {
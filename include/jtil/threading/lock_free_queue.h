@@ -0,0 +1,149 @@
+//
+//  lock_free_queue.h
+//
+//  A bounded, lock-free, multi-producer / multi-consumer FIFO queue.  This is
+//  Dmitry Vyukov's array based queue: every slot holds a sequence number that
+//  tells producers when the slot is free and consumers when it is full, so the
+//  only shared writes are one CAS on the enqueue (or dequeue) position.
+//
+//  Unlike CallbackQueue, nothing is allocated after construction.  enqueue()
+//  returns false when the queue is full and dequeue() returns false when it is
+//  empty; it is up to the owner to decide what to do in either case.
+//
+//  T should be cheap to copy (ie, pointers to tasks or worker indices).
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include "jtil/math/math_types.h"  // for uint32_t
+
+#define LOCK_FREE_QUEUE_CACHE_LINE_SIZE 64
+
+namespace jtil {
+namespace threading {
+
+  template <class T>
+  class LockFreeQueue {
+  public:
+    // capacity is rounded up to the nearest power of 2
+    explicit LockFreeQueue(const uint32_t capacity);
+    ~LockFreeQueue();
+
+    // Add to the tail of the queue, return false if the queue is full
+    bool enqueue(const T& item);
+
+    // Remove from the head of the queue, return false if the queue is empty
+    bool dequeue(T& item);
+
+    // Only a snapshot when other threads are using the queue
+    uint32_t size() const;
+    inline bool empty() const { return size() == 0; }
+    inline uint32_t capacity() const { return static_cast<uint32_t>(mask_+1); }
+
+  private:
+    struct Cell {
+      std::atomic<size_t> sequence;
+      T data;
+    };
+
+    typedef char CacheLinePad[LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+
+    CacheLinePad pad0_;
+    Cell* buffer_;
+    size_t mask_;
+    CacheLinePad pad1_;
+    std::atomic<size_t> enqueue_pos_;
+    CacheLinePad pad2_;
+    std::atomic<size_t> dequeue_pos_;
+    CacheLinePad pad3_;
+
+    // Non-copyable, non-assignable.
+    LockFreeQueue(const LockFreeQueue&);
+    LockFreeQueue& operator=(const LockFreeQueue&);
+  };
+
+  template <class T>
+  LockFreeQueue<T>::LockFreeQueue(const uint32_t capacity) {
+    size_t cap = 2;
+    while (cap < static_cast<size_t>(capacity)) {
+      cap <<= 1;
+    }
+    mask_ = cap - 1;
+    buffer_ = new Cell[cap];
+    for (size_t i = 0; i < cap; i++) {
+      buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  template <class T>
+  LockFreeQueue<T>::~LockFreeQueue() {
+    delete[] buffer_;
+  }
+
+  template <class T>
+  bool LockFreeQueue<T>::enqueue(const T& item) {
+    Cell* cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &buffer_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (dif == 0) {
+        // The slot is free: try to claim it
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+          std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // Full
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <class T>
+  bool LockFreeQueue<T>::dequeue(T& item) {
+    Cell* cell;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &buffer_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) -
+        static_cast<intptr_t>(pos + 1);
+      if (dif == 0) {
+        // The slot is full: try to claim it
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+          std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // Empty
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    item = cell->data;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <class T>
+  uint32_t LockFreeQueue<T>::size() const {
+    size_t deq = dequeue_pos_.load(std::memory_order_acquire);
+    size_t enq = enqueue_pos_.load(std::memory_order_acquire);
+    if (enq <= deq) {
+      return 0;
+    }
+    return static_cast<uint32_t>(enq - deq);
+  }
+
+};  // namespace threading
+};  // namespace jtil
@@ -0,0 +1,163 @@
+//
+//  parallel_for.h
+//
+//  The jobs behind ThreadPool::parallelFor() and ThreadPool::parallelReduce()
+//  (use those rather than these classes directly).
+//
+//  The range [begin, end) is split into chunks of 'grain' iterations.  A
+//  ParallelJobRef is added to the pool once per helper worker, and every
+//  helper (plus the calling thread) grabs chunks from the job's shared atomic
+//  counter until none are left.  So the work load-balances itself, and the
+//  loop still completes if every worker is busy (or the pool is stopped),
+//  since the calling thread will just run all the chunks itself.
+//
+//  The job is reference counted: helpers may be dequeued long after the loop
+//  has finished, so the last one out deletes it.  The helpers are once
+//  callbacks, so if the pool is stopped before they run its destructor
+//  deletes them (which releases their reference).
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include "jtil/threading/callback.h"
+
+namespace jtil {
+namespace threading {
+
+  // A helper's reference to a job
+  template <typename Job>
+  class ParallelJobRef : public Callback<void> {
+  public:
+    explicit ParallelJobRef(Job* job) : job_(job) { }
+    virtual ~ParallelJobRef() { job_->release(); }
+    virtual void operator()() {
+      job_->runChunks();
+      delete this;
+    }
+    virtual bool once() const { return true; }
+
+  private:
+    Job* job_;
+
+    // Non-copyable, non-assignable.
+    ParallelJobRef(const ParallelJobRef&);
+    ParallelJobRef& operator=(const ParallelJobRef&);
+  };
+
+  template <typename Func>
+  class ParallelForJob {
+  public:
+    ParallelForJob(const int begin, const int end, const int grain,
+      const int num_refs, const Func& fn);
+    virtual ~ParallelForJob() {}
+
+    // Calling thread: run chunks, wait for the helpers' chunks to finish and
+    // then release our reference.
+    void runAndWait();
+
+    // Run chunks until there are none left
+    void runChunks();
+    void release();
+
+  protected:
+    virtual void runChunk(const int chunk, const int b, const int e);
+
+    const Func& fn_;
+    const int begin_;
+    const int end_;
+    const int grain_;
+    const int num_chunks_;
+    std::atomic<int> next_chunk_;
+    std::atomic<int> chunks_done_;
+    std::atomic<int> num_refs_;
+    std::mutex done_lock_;
+    std::condition_variable done_cv_;
+
+    // Non-copyable, non-assignable.
+    ParallelForJob(const ParallelForJob&);
+    ParallelForJob& operator=(const ParallelForJob&);
+  };
+
+  // Every chunk stores its partial result, and the calling thread reduces
+  // them in chunk order.  So for a given grain the result is deterministic
+  // (even for non-associative ops like floating point addition).
+  template <typename T, typename Func>
+  class ParallelReduceJob : public ParallelForJob<Func> {
+  public:
+    ParallelReduceJob(const int begin, const int end, const int grain,
+      const int num_refs, const Func& fn, T* results);
+    virtual ~ParallelReduceJob() {}
+
+  protected:
+    virtual void runChunk(const int chunk, const int b, const int e);
+    T* results_;  // not owned here
+  };
+
+  template <typename Func>
+  ParallelForJob<Func>::ParallelForJob(const int begin, const int end,
+    const int grain, const int num_refs, const Func& fn) : fn_(fn),
+    begin_(begin), end_(end), grain_(grain),
+    num_chunks_((end - begin + grain - 1) / grain) {
+    next_chunk_.store(0);
+    chunks_done_.store(0);
+    num_refs_.store(num_refs);
+  }
+
+  template <typename Func>
+  void ParallelForJob<Func>::runAndWait() {
+    runChunks();
+    if (chunks_done_.load() < num_chunks_) {
+      std::unique_lock<std::mutex> unique_lock(done_lock_);
+      while (chunks_done_.load() < num_chunks_) {
+        done_cv_.wait(unique_lock);
+      }
+    }
+    release();
+  }
+
+  template <typename Func>
+  void ParallelForJob<Func>::runChunks() {
+    int chunk;
+    while ((chunk = next_chunk_.fetch_add(1)) < num_chunks_) {
+      const int b = begin_ + chunk * grain_;
+      const int e = (b + grain_) < end_ ? (b + grain_) : end_;
+      runChunk(chunk, b, e);
+      if (chunks_done_.fetch_add(1) + 1 == num_chunks_) {
+        std::unique_lock<std::mutex> unique_lock(done_lock_);
+        done_cv_.notify_all();
+      }
+    }
+  }
+
+  template <typename Func>
+  void ParallelForJob<Func>::runChunk(const int chunk, const int b,
+    const int e) {
+    static_cast<void>(chunk);
+    fn_(b, e);
+  }
+
+  template <typename Func>
+  void ParallelForJob<Func>::release() {
+    if (num_refs_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  template <typename T, typename Func>
+  ParallelReduceJob<T, Func>::ParallelReduceJob(const int begin,
+    const int end, const int grain, const int num_refs, const Func& fn,
+    T* results) : ParallelForJob<Func>(begin, end, grain, num_refs, fn),
+    results_(results) {
+  }
+
+  template <typename T, typename Func>
+  void ParallelReduceJob<T, Func>::runChunk(const int chunk, const int b,
+    const int e) {
+    results_[chunk] = this->fn_(b, e);
+  }
+
+};  // namespace threading
+};  // namespace jtil
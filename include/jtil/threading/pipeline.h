@@ -0,0 +1,446 @@
+//
+//  pipeline.h
+//
+//  A chain of stages (ie, capture -> downsample -> filter -> contours ->
+//  output) that frames flow through, run on a ThreadPool.  Up to
+//  'parallelism' frames can be in a stage at once, so a slow stage can be
+//  spread over several workers while the other stages keep working on the
+//  frames before and after it.
+//
+//  The frames are a fixed pool of 'num_buffers' Frame objects, allocated
+//  once and recycled: the source fills a free buffer, every stage works on
+//  it in place, and after the last stage it goes back to the pool.  So the
+//  number of buffers bounds the queues between the stages (and the latency):
+//  when every buffer is in use the source isn't called until one comes back.
+//
+//  Frames enter the pipeline in the order the source produced them.  A
+//  serial stage (parallelism 1) always sees them in that order, even after a
+//  parallel stage has finished them out of order (they wait in its queue).
+//  So end the pipeline with a serial stage if the output must be ordered.
+//
+//    Pipeline<DepthFrame> pipeline(&tp, 4);
+//    pipeline.setSource(MakeCallableMany(&App::capture, this));
+//    pipeline.addStage(MakeCallableMany(&App::filter, this), 3);
+//    pipeline.addStage(MakeCallableMany(&App::output, this));
+//    pipeline.start();
+//    ...
+//    pipeline.stop();  // Waits for the frames already captured
+//
+//  The source returns false at the end of the stream (wait() then returns
+//  once the last frame is out).  It is called on a pool worker, so a source
+//  that blocks (ie, waiting for the camera) keeps that worker busy.  The
+//  pipeline owns the callbacks, which must not be once callbacks, and not the
+//  ThreadPool, which must outlive it (and keep running while frames are in
+//  flight).  If the pool is stopped under it anyway, the frames it then
+//  rejects are dropped and the stream ends, so wait() and stop() still
+//  return (frames already queued on the pool when it stopped are lost with
+//  it, though).
+//
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "jtil/threading/callback.h"
+#include "jtil/threading/task.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/data_str/vector.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+namespace jtil {
+namespace threading {
+
+  struct PipelineStageStats {
+    uint64_t num_frames;  // Frames that finished the stage
+    int64_t busy_ns;  // Summed over the stage's concurrent calls
+    // Stages: time frames waited in the stage's queue (for a free slot or
+    // for an earlier frame).  Source: time it couldn't run because every
+    // buffer was in use (ie, back pressure from the stages).
+    int64_t stall_ns;
+
+    PipelineStageStats() { clear(); }
+    void clear() {
+      num_frames = 0;
+      busy_ns = 0;
+      stall_ns = 0;
+    }
+  };
+
+  struct PipelineStats {
+    int64_t elapsed_ns;  // Since start() (until stop())
+    uint64_t num_frames;  // Frames out of the last stage
+    PipelineStageStats source;
+    data_str::Vector<PipelineStageStats> stages;
+
+    PipelineStats() : elapsed_ns(0), num_frames(0) { }
+
+    // framesPerSecond() - Throughput of the pipeline, or of one stage
+    double framesPerSecond() const { return framesPerSecond(num_frames); }
+    double framesPerSecond(const uint64_t num) const {
+      if (elapsed_ns <= 0) {
+        return 0;
+      }
+      return 1e9 * static_cast<double>(num) / static_cast<double>(elapsed_ns);
+    }
+
+  private:
+    // Vector's copy constructor is shallow (see ThreadPoolStats)
+    PipelineStats(const PipelineStats&);
+  };
+
+  template <class Frame>
+  class Pipeline {
+  public:
+    Pipeline(ThreadPool* tp, const int num_buffers,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+    // ~Pipeline() - Calls stop() and deletes the callbacks
+    ~Pipeline();
+
+    // setSource() - 'source' fills the frame it's given, or returns false at
+    // the end of the stream
+    void setSource(Callback<bool, Frame*>* source);
+    // addStage() - Stages run in the order they were added.  Returns the
+    // stage's index.
+    int addStage(Callback<void, Frame*>* stage, const int parallelism = 1);
+
+    // start() - Start calling the source.  Returns without waiting.
+    void start();
+    // stop() - Stop calling the source and wait for the frames in flight
+    void stop();
+    // wait() - Wait for the source to end the stream (or for another thread
+    // to call stop()) and for the last frame to leave the pipeline
+    void wait();
+
+    void getStats(PipelineStats* stats) const;
+    inline int numBuffers() const { return num_buffers_; }
+    // buffer() - To preallocate the frames' storage before start()
+    inline Frame* buffer(const int i) { return &buffers_[i]; }
+
+  private:
+    struct QueueItem {
+      int buffer;
+      uint64_t seq;
+      int64_t enqueue_time_ns;
+    };
+
+    struct Stage {
+      Callback<void, Frame*>* fn;
+      int parallelism;
+      int num_active;
+      uint64_t next_seq;  // Serial stages: the next frame to run
+      data_str::Vector<QueueItem> queue;  // Unordered
+      PipelineStageStats stats;
+    };
+
+    ThreadPool* tp_;  // not owned here
+    const ThreadPoolPriority priority_;
+    const int num_buffers_;
+    Frame* buffers_;
+    data_str::Vector<int> free_buffers_;
+    Callback<bool, Frame*>* source_;
+    data_str::Vector<Stage*> stages_;
+
+    mutable std::mutex lock_;  // Protects everything below
+    std::condition_variable done_cv_;
+    bool feeding_;  // The source should be called
+    bool source_active_;
+    int num_in_flight_;  // Buffers out of free_buffers_
+    uint64_t next_seq_;
+    int64_t start_time_ns_;
+    int64_t stop_time_ns_;
+    int64_t source_stall_start_ns_;  // 0 unless waiting for a buffer
+    uint64_t num_frames_;
+    PipelineStageStats source_stats_;
+
+    static inline int64_t TimeNS() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void runSource(int buffer);
+    // The sequence number goes first so the Task's arguments pack tightly
+    void runStage(uint64_t seq, int stage, int buffer);
+    // schedule() - Start everything that can run.  REQUIRES: lock_ held
+    void schedule();
+    // dropFrame() - The pool rejected a task for the buffer: end the stream
+    // and recycle it.  REQUIRES: lock_ held
+    void dropFrame(const int buffer);
+    // dequeueRunnable() - Index into the stage's queue or -1.  REQUIRES: lock
+    int dequeueRunnable(const Stage* stage) const;
+    void enqueue(const int stage, const int buffer, const uint64_t seq,
+      const int64_t now_ns);  // REQUIRES: lock_ held
+    void waitDrained(std::unique_lock<std::mutex>& unique_lock);
+
+    // Non-copyable, non-assignable.
+    Pipeline(const Pipeline&);
+    Pipeline& operator=(const Pipeline&);
+  };
+
+  template <class Frame>
+  Pipeline<Frame>::Pipeline(ThreadPool* tp, const int num_buffers,
+    const ThreadPoolPriority priority) : tp_(tp), priority_(priority),
+    num_buffers_(num_buffers), source_(NULL) {
+    if (tp == NULL || num_buffers < 1) {
+      throw std::wruntime_error("Pipeline::Pipeline: Needs a ThreadPool and "
+        "at least one buffer");
+    }
+    buffers_ = new Frame[num_buffers_];
+    for (int i = num_buffers_ - 1; i >= 0; i--) {
+      free_buffers_.pushBack(i);
+    }
+    feeding_ = false;
+    source_active_ = false;
+    num_in_flight_ = 0;
+    next_seq_ = 0;
+    start_time_ns_ = 0;
+    stop_time_ns_ = 0;
+    source_stall_start_ns_ = 0;
+    num_frames_ = 0;
+  }
+
+  template <class Frame>
+  Pipeline<Frame>::~Pipeline() {
+    stop();
+    delete source_;
+    for (uint32_t i = 0; i < stages_.size(); i++) {
+      delete stages_[i]->fn;
+      delete stages_[i];
+    }
+    delete[] buffers_;
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::setSource(Callback<bool, Frame*>* source) {
+    if (source->once()) {
+      throw std::wruntime_error("Pipeline::setSource: source must not be a "
+        "once callback");
+    }
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    if (feeding_ || num_in_flight_ > 0) {
+      throw std::wruntime_error("Pipeline::setSource: Pipeline is running");
+    }
+    delete source_;
+    source_ = source;
+  }
+
+  template <class Frame>
+  int Pipeline<Frame>::addStage(Callback<void, Frame*>* stage_fn,
+    const int parallelism) {
+    if (stage_fn->once() || parallelism < 1) {
+      throw std::wruntime_error("Pipeline::addStage: stage must not be a "
+        "once callback and parallelism must be >= 1");
+    }
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    if (feeding_ || num_in_flight_ > 0) {
+      throw std::wruntime_error("Pipeline::addStage: Pipeline is running");
+    }
+    Stage* stage = new Stage();
+    stage->fn = stage_fn;
+    stage->parallelism = parallelism;
+    stage->num_active = 0;
+    stage->next_seq = 0;
+    stages_.pushBack(stage);
+    return static_cast<int>(stages_.size()) - 1;
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::start() {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    if (source_ == NULL || stages_.size() == 0) {
+      throw std::wruntime_error("Pipeline::start: Needs a source and at "
+        "least one stage");
+    }
+    if (feeding_ || num_in_flight_ > 0) {
+      throw std::wruntime_error("Pipeline::start: Already running");
+    }
+    if (tp_->stopped()) {
+      throw std::wruntime_error("Pipeline::start: ThreadPool is stopped");
+    }
+    next_seq_ = 0;
+    for (uint32_t i = 0; i < stages_.size(); i++) {
+      stages_[i]->next_seq = 0;
+      stages_[i]->stats.clear();
+    }
+    source_stats_.clear();
+    num_frames_ = 0;
+    start_time_ns_ = TimeNS();
+    stop_time_ns_ = 0;
+    source_stall_start_ns_ = 0;
+    feeding_ = true;
+    schedule();
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::stop() {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    feeding_ = false;
+    done_cv_.notify_all();  // Wake wait()
+    waitDrained(unique_lock);
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::wait() {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    while (feeding_) {
+      done_cv_.wait(unique_lock);
+    }
+    waitDrained(unique_lock);
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::waitDrained(
+    std::unique_lock<std::mutex>& unique_lock) {
+    while (num_in_flight_ > 0) {
+      done_cv_.wait(unique_lock);
+    }
+    if (stop_time_ns_ == 0 && start_time_ns_ != 0) {
+      stop_time_ns_ = TimeNS();
+    }
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::getStats(PipelineStats* stats) const {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    const int64_t end_ns = stop_time_ns_ != 0 ? stop_time_ns_ : TimeNS();
+    stats->elapsed_ns = start_time_ns_ != 0 ? end_ns - start_time_ns_ : 0;
+    stats->num_frames = num_frames_;
+    stats->source = source_stats_;
+    if (source_stall_start_ns_ != 0) {
+      stats->source.stall_ns += end_ns - source_stall_start_ns_;
+    }
+    stats->stages.clear();
+    for (uint32_t i = 0; i < stages_.size(); i++) {
+      stats->stages.pushBack(stages_[i]->stats);
+    }
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::runSource(int buffer) {
+    const int64_t start_ns = TimeNS();
+    const bool produced = (*source_)(&buffers_[buffer]);
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    const int64_t now_ns = TimeNS();
+    source_stats_.busy_ns += now_ns - start_ns;
+    source_active_ = false;
+    if (produced) {
+      source_stats_.num_frames++;
+      // The source is serial, so sequence numbers follow the capture order
+      enqueue(0, buffer, next_seq_++, now_ns);
+    } else {
+      feeding_ = false;  // End of the stream
+      free_buffers_.pushBack(buffer);
+      num_in_flight_--;
+    }
+    schedule();
+    // Notify with the lock held: a waiter may destroy the pipeline as soon as
+    // we release it
+    done_cv_.notify_all();
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::runStage(uint64_t seq, int stage_index, int buffer) {
+    Stage* stage = stages_[stage_index];
+    const int64_t start_ns = TimeNS();
+    (*stage->fn)(&buffers_[buffer]);
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    const int64_t now_ns = TimeNS();
+    stage->stats.busy_ns += now_ns - start_ns;
+    stage->stats.num_frames++;
+    stage->num_active--;
+    if (stage_index + 1 < static_cast<int>(stages_.size())) {
+      enqueue(stage_index + 1, buffer, seq, now_ns);
+    } else {
+      num_frames_++;
+      free_buffers_.pushBack(buffer);
+      num_in_flight_--;
+    }
+    schedule();
+    if (num_in_flight_ == 0) {
+      done_cv_.notify_all();
+    }
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::enqueue(const int stage, const int buffer,
+    const uint64_t seq, const int64_t now_ns) {
+    QueueItem item;
+    item.buffer = buffer;
+    item.seq = seq;
+    item.enqueue_time_ns = now_ns;
+    stages_[stage]->queue.pushBack(item);
+  }
+
+  template <class Frame>
+  int Pipeline<Frame>::dequeueRunnable(const Stage* stage) const {
+    // The queue holds at most num_buffers_ frames, so a scan is fine
+    int oldest = -1;
+    for (uint32_t i = 0; i < stage->queue.size(); i++) {
+      if (oldest < 0 || stage->queue[i].seq < stage->queue[oldest].seq) {
+        oldest = static_cast<int>(i);
+      }
+    }
+    if (oldest >= 0 && stage->parallelism == 1 &&
+      stage->queue[oldest].seq != stage->next_seq) {
+      return -1;  // An earlier frame is still upstream
+    }
+    return oldest;
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::schedule() {
+    const int64_t now_ns = TimeNS();
+    // Later stages first: they free buffers sooner
+    for (int s = static_cast<int>(stages_.size()) - 1; s >= 0; s--) {
+      Stage* stage = stages_[s];
+      while (stage->num_active < stage->parallelism) {
+        const int i = dequeueRunnable(stage);
+        if (i < 0) {
+          break;
+        }
+        const QueueItem item = stage->queue[i];
+        stage->queue[i] = stage->queue[stage->queue.size() - 1];
+        stage->queue.popBack();
+        stage->stats.stall_ns += now_ns - item.enqueue_time_ns;
+        stage->next_seq = item.seq + 1;
+        stage->num_active++;
+        if (!tp_->addTask(MakeTask(&Pipeline::runStage, this, item.seq, s,
+          item.buffer), priority_)) {
+          stage->num_active--;
+          dropFrame(item.buffer);
+        }
+      }
+    }
+    if (feeding_ && !source_active_) {
+      if (free_buffers_.size() == 0) {
+        if (source_stall_start_ns_ == 0) {
+          source_stall_start_ns_ = now_ns;
+        }
+      } else {
+        if (source_stall_start_ns_ != 0) {
+          source_stats_.stall_ns += now_ns - source_stall_start_ns_;
+          source_stall_start_ns_ = 0;
+        }
+        int buffer;
+        free_buffers_.popBack(buffer);
+        num_in_flight_++;
+        source_active_ = true;
+        if (!tp_->addTask(MakeTask(&Pipeline::runSource, this, buffer),
+          priority_)) {
+          source_active_ = false;
+          dropFrame(buffer);
+        }
+      }
+    }
+  }
+
+  template <class Frame>
+  void Pipeline<Frame>::dropFrame(const int buffer) {
+    feeding_ = false;
+    free_buffers_.pushBack(buffer);
+    num_in_flight_--;
+    done_cv_.notify_all();
+  }
+
+};  // namespace threading
+};  // namespace jtil
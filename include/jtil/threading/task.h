@@ -0,0 +1,148 @@
+//
+//  task.h
+//
+//  A void() job that is stored by value: the member function pointer, the
+//  object and the arguments live in a small inline buffer, so making, copying
+//  and running a Task never touches the heap.  ThreadPool::addTask(const
+//  Task&) copies it into one of the pool's preallocated TaskSlots.
+//
+//    tp.addTask(MakeTask(&Renderer::cullTile, this, tile_index));
+//
+//  Every argument of the member function must be bound (the bound values are
+//  copied, even for reference parameters).  The stored values must be
+//  trivially copyable (pointers, integers, floats, small PODs) and together
+//  with the member function pointer fit in TASK_STORAGE_SIZE bytes; both are
+//  checked at compile time.  MakeTask(functor) also works for any small,
+//  trivially copyable functor with a void operator()().
+//
+
+#pragma once
+
+#include <new>  // For placement new
+#include <type_traits>
+#include "jtil/threading/callback.h"
+#include "jtil/threading/lock_free_queue.h"
+#include "jtil/math/math_types.h"  // for int64_t
+
+// Room for a member function pointer (16 bytes on most ABIs), the object
+// pointer and three 8 byte arguments.
+#define TASK_STORAGE_SIZE 48
+
+namespace jtil {
+namespace threading {
+
+  class Task {
+  public:
+    Task() : invoke_(NULL) { }
+
+    inline void operator()() { invoke_(&storage_); }
+    inline bool empty() const { return invoke_ == NULL; }
+
+    // set() - Store a copy of 'fn' (see the requirements above)
+    template <typename Func>
+    void set(const Func& fn);
+
+  private:
+    typedef void (*InvokeFunc)(void* storage);
+
+    template <typename Func>
+    static void invoke(void* storage) {
+      (*static_cast<Func*>(storage))();
+    }
+
+    InvokeFunc invoke_;
+    union {  // Aligned for any of the stored types
+      void* align_ptr;
+      double align_double;
+      int64_t align_int;
+      char bytes[TASK_STORAGE_SIZE];
+    } storage_;
+  };
+
+  template <typename Func>
+  void Task::set(const Func& fn) {
+    static_assert(sizeof(Func) <= TASK_STORAGE_SIZE,
+      "Task: the function and its arguments are too big (TASK_STORAGE_SIZE)");
+    static_assert(std::is_trivially_copyable<Func>::value,
+      "Task: the function and its arguments must be trivially copyable");
+    new (&storage_) Func(fn);
+    invoke_ = &Task::invoke<Func>;
+  }
+
+  template <typename Target, typename Func, typename Args>
+  struct TaskMemberCall;
+
+  template <typename Target, typename Func, typename... Args>
+  struct TaskMemberCall<Target, Func, CallbackArgs<Args...> > {
+    template <typename... B>
+    TaskMemberCall(Func target_func, Target* obj, B&&... binds)
+      : target_func(target_func), obj(obj), args(std::forward<B>(binds)...) { }
+
+    inline void operator()() {
+      call(typename CallbackMakeIndices<sizeof...(Args)>::type());
+    }
+
+    template <int... I>
+    inline void call(CallbackIndices<I...>) {
+      ((*obj).*target_func)(
+        CallbackArgsGet<I, CallbackArgs<Args...> >::get(args)...);
+    }
+
+    Func target_func;
+    Target* obj;
+    CallbackArgs<Args...> args;
+  };
+
+  template <typename Target, typename Res, typename... Params,
+    typename... Binds>
+  Task MakeTask(Res (Target::*f)(Params...), Target* obj, Binds&&... binds) {
+    static_assert(sizeof...(Params) == sizeof...(Binds),
+      "MakeTask: every argument of the member function must be bound");
+    typedef TaskMemberCall<Target, Res (Target::*)(Params...),
+      CallbackArgs<typename std::decay<Params>::type...> > MemberCall;
+    Task task;
+    task.set(MemberCall(f, obj, std::forward<Binds>(binds)...));
+    return task;
+  }
+
+  template <typename Func>
+  Task MakeTask(const Func& fn) {
+    Task task;
+    task.set(fn);
+    return task;
+  }
+
+  // TaskSlot - A Callback<void> that holds a Task, so that a Task can travel
+  // through the pool's pointer based queues.  Slots that belong to a pool are
+  // returned to its free list when they are run.  Slots without a free list
+  // were heap allocated (because the pool ran out) and are once callbacks.
+  class TaskSlot : public Callback<void> {
+  public:
+    TaskSlot() : free_slots(NULL), enqueue_time_ns(0) { }
+    virtual ~TaskSlot() {}
+
+    virtual void operator()() {
+      // Copy the task out first so the slot can be reused while it runs
+      Task cur_task = task;
+      if (free_slots != NULL) {
+        free_slots->enqueue(this);
+      } else {
+        delete this;
+      }
+      cur_task();
+    }
+
+    virtual bool once() const { return free_slots == NULL; }
+
+    Task task;
+    LockFreeQueue<TaskSlot*>* free_slots;  // not owned here
+    int64_t enqueue_time_ns;  // Set by the pool when its stats are on
+
+  private:
+    // Non-copyable, non-assignable.
+    TaskSlot(const TaskSlot&);
+    TaskSlot& operator=(const TaskSlot&);
+  };
+
+};  // namespace threading
+};  // namespace jtil
@@ -0,0 +1,185 @@
+//
+//  task_group.h
+//
+//  TaskGroup and TaskGraph are thin layers on top of ThreadPool that add the
+//  synchronization addTask() doesn't have, without having to stop the pool.
+//
+//  TaskGroup - Tasks are run() on the pool and wait() blocks until every task
+//  in the group has finished.  then() registers a continuation that is added
+//  to the group (and so to the pool) once all the group's tasks are done.
+//  wait() runs any of the group's tasks that no worker has started yet on the
+//  calling thread, so it is safe to wait on a group from inside a task.
+//
+//  TaskGraph - A DAG of tasks that can be run any number of times (ie, once
+//  per frame).  Nodes are added with addNode(), addEdge(a, b) makes b wait
+//  for a, and run() starts all the nodes with no predecessors.  When a node
+//  finishes it releases its successors, and the last one to become ready is
+//  run directly on the same worker (rather than going back through the pool).
+//
+//  Neither class owns the ThreadPool, which must outlive them.  All of a
+//  group's (or graph's) tasks are added to the pool with the priority given
+//  to its constructor.
+//
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "jtil/threading/callback.h"
+#include "jtil/threading/callback_queue.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/data_str/vector.h"
+
+namespace jtil {
+namespace threading {
+
+  class TaskGroup;
+
+  // One run() request.  It is referenced by both the pool (through a
+  // TaskGroupItemRef) and the group's list of unstarted tasks, and whoever
+  // claims it first runs the task.
+  class TaskGroupItem {
+  public:
+    TaskGroupItem(TaskGroup* group, Callback<void>* task);
+
+    // Run the task if nobody else has, returns true if we ran it
+    bool claimAndRun();
+    void release();
+    inline bool claimed() const { return claimed_.load(); }
+
+  private:
+    TaskGroup* group_;  // not owned here
+    Callback<void>* task_;
+    std::atomic<bool> claimed_;
+    std::atomic<int> num_refs_;
+
+    // Non-copyable, non-assignable.
+    TaskGroupItem(const TaskGroupItem&);
+    TaskGroupItem& operator=(const TaskGroupItem&);
+  };
+
+  // The pool's reference to a TaskGroupItem.  It is a once callback so that
+  // the pool's destructor cleans it up if it is never run (ie, the group ran
+  // the task itself and then the pool was stopped).
+  class TaskGroupItemRef : public Callback<void> {
+  public:
+    explicit TaskGroupItemRef(TaskGroupItem* item) : item_(item) { }
+    virtual ~TaskGroupItemRef() { item_->release(); }
+    virtual void operator()() {
+      item_->claimAndRun();
+      delete this;
+    }
+    virtual bool once() const { return true; }
+
+  private:
+    TaskGroupItem* item_;
+
+    // Non-copyable, non-assignable.
+    TaskGroupItemRef(const TaskGroupItemRef&);
+    TaskGroupItemRef& operator=(const TaskGroupItemRef&);
+  };
+
+  class TaskGroup {
+  public:
+    explicit TaskGroup(ThreadPool* tp,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+    // ~TaskGroup() - Waits for the group's tasks to finish
+    ~TaskGroup();
+
+    // run() - Add a task to the group and request its execution on the pool.
+    // 'task' is deleted after execution if task->once() is true.
+    void run(Callback<void>* task);
+
+    // wait() - Block until every task in the group (and every continuation
+    // added with then()) has finished.  Unstarted tasks are run on the
+    // calling thread.  If the pool is stopped, this runs all of them.
+    void wait();
+
+    // then() - 'continuation' is run() once every task in the group has
+    // finished (including tasks added after this call), or immediately if
+    // the group is empty.
+    void then(Callback<void>* continuation);
+
+    int numPending() const;
+    inline ThreadPool* tp() const { return tp_; }
+    inline ThreadPoolPriority priority() const { return priority_; }
+
+  private:
+    friend class TaskGroupItem;
+
+    ThreadPool* tp_;  // not owned here
+    const ThreadPoolPriority priority_;
+    mutable std::mutex lock_;
+    std::condition_variable done_cv_;
+    int num_pending_;  // Tasks run() but not finished
+    CallbackQueue<TaskGroupItem*> unstarted_;  // Possibly already claimed
+    CallbackQueue<Callback<void>*> continuations_;
+
+    void taskDone();
+    TaskGroupItem* addItem(Callback<void>* task);  // REQUIRES: lock_ held
+    static void submit(ThreadPool* tp, const ThreadPoolPriority priority,
+      TaskGroupItem* item);
+
+    // Non-copyable, non-assignable.
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+  };
+
+  class TaskGraph {
+  public:
+    explicit TaskGraph(ThreadPool* tp,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+    // ~TaskGraph() - Waits for the current run to finish and deletes the
+    // node tasks
+    ~TaskGraph();
+
+    // addNode() - Returns the node's index.  The graph takes ownership of
+    // 'task' and runs it once per run() so task->once() must be false.
+    int addNode(Callback<void>* task);
+
+    // addEdge() - Node 'after' will not start until node 'before' finishes
+    void addEdge(const int before, const int after);
+
+    // run() - Start the graph (waiting for the previous run first).  Throws
+    // if the graph has a cycle.  Returns without waiting for the nodes.
+    void run();
+
+    // wait() - Block until every node of the current run has finished
+    void wait();
+
+    // then() - 'continuation' is run after every node of the current run
+    // has finished (and before wait() returns)
+    void then(Callback<void>* continuation);
+
+    inline uint32_t numNodes() const { return nodes_.size(); }
+
+  private:
+    class Node : public Callback<void> {
+    public:
+      Node(TaskGraph* graph, Callback<void>* task);
+      virtual ~Node();
+      virtual void operator()();
+      virtual bool once() const { return false; }  // Owned by the graph
+
+      TaskGraph* graph;
+      Callback<void>* task;
+      data_str::Vector<int> successors;
+      int num_predecessors;
+      std::atomic<int> num_waiting;  // Unfinished predecessors this run
+    };
+
+    TaskGroup group_;
+    data_str::Vector<Node*> nodes_;
+    data_str::Vector<int> roots_;
+    bool dirty_;  // Edges changed since roots_ was last built
+
+    void buildRoots();
+
+    // Non-copyable, non-assignable.
+    TaskGraph(const TaskGraph&);
+    TaskGraph& operator=(const TaskGraph&);
+  };
+
+};  // namespace threading
+};  // namespace jtil
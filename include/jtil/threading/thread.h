@@ -5,6 +5,11 @@
 //
 //  A simple wrapper around std::thread for spawning threads from a Callback<>
 //  
+//  Also has thin wrappers for the platform specific bits of thread placement
+//  (CPU topology, NUMA nodes and affinity).  Where the OS doesn't support
+//  something they degrade gracefully (ie, SetThreadAffinity returns false
+//  on OS X and every CPU is on NUMA node 0 when the node is unknown).
+//
 
 #pragma once
 
@@ -20,8 +25,28 @@ namespace threading {
   // If a thread cannot be created, this call will exit()
   std::thread MakeThread(threading::Callback<void>* body);
 
-  // Name the current thread.
+  // Name the current thread.  Linux only keeps the first 15 characters.
   void SetThreadName(const char* thread_name);
+
+  // GetNumCPUs() - The number of logical CPUs this process can run on
+  int GetNumCPUs();
+
+  // GetPhysicalCoreCPUs() - Writes one logical CPU per physical core (the
+  // first hardware thread of each core), grouped by socket.  Returns the
+  // number written, at most max_cpus.
+  int GetPhysicalCoreCPUs(int* cpus, const int max_cpus);
+
+  // GetCPUNumaNode() - The NUMA node of logical CPU 'cpu' (0 if unknown)
+  int GetCPUNumaNode(const int cpu);
+
+  // GetCurrentCPU() - The logical CPU the calling thread is running on, or
+  // -1 if unknown
+  int GetCurrentCPU();
+
+  // SetThreadAffinity() - Pin 'thread' to logical CPU 'cpu'.  Returns false
+  // if the OS doesn't support it or refused (ie, 'cpu' is not in the
+  // process' CPU set).
+  bool SetThreadAffinity(std::thread* thread, const int cpu);
   
   // Creates a void* equivilient of the std::thread::id class
   void* GetThreadID(std::thread* thread);
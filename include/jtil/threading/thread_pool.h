@@ -10,31 +10,159 @@
 //  It makes use of a small optimization where, new tasks will be handed 
 //  directly to idle threads if any are idle, otherwise it will be placed on the
 //  queue for execution (with appropriate overhead).
+//
+//  TP_WORK_STEALING mode replaces the single shared queue with a per-worker
+//  Chase-Lev deque.  Tasks added from inside a worker thread are pushed onto
+//  that worker's deque (and popped LIFO by the owner), tasks added from any
+//  other thread go onto the shared queue, and idle workers steal FIFO from a
+//  random victim before going to sleep.
+//
+//  TP_LOCK_FREE_QUEUE mode keeps a single FIFO but replaces the locked task
+//  and idle-worker queues with bounded lock-free queues (so neither addTask
+//  nor the worker dequeue take a shared lock or allocate).  New tasks are no
+//  longer handed directly to idle workers, instead one idle worker is woken 
+//  up to dequeue it.  If the task queue ever fills up, tasks overflow onto the
+//  (locked) shared queue.
+//
+//  addTask(const Task&) copies the task into one of the pool's preallocated
+//  TaskSlots (recycled through a lock-free free list), so unlike 
+//  MakeCallableOnce it does not allocate.  Only if more than 
+//  THREAD_POOL_NUM_TASK_SLOTS of them are in flight does a slot get
+//  allocated on the heap.
+//
+//  Every task goes into one of TP_NUM_PRIORITIES lanes.  Workers always take
+//  a task from the highest non-empty lane first (tasks within a lane keep the
+//  mode's usual order), so frame critical work does not queue up behind
+//  background jobs that are still waiting.  Optionally some workers can be
+//  reserved for the higher lanes: they never start a lower priority task, so
+//  a frame task can start even while every other worker is busy with a long
+//  background job.
+//
+//  ThreadPoolPlacement pins the workers to CPUs, either from an explicit list
+//  or one worker per physical core.  With numa_local_queues set, work
+//  stealing workers look for work on the deques of workers on their own NUMA
+//  node before crossing to another node.  Workers are named "TPWorker-<i>"
+//  so they can be told apart in a profiler / top.
+//
+//  setStatsEnabled(true) turns on per-worker counters (tasks run, busy, idle
+//  and steal time, enqueue-to-start latency and run time histograms), read
+//  with getStats().  Each worker only writes its own counters, so the cost
+//  is a few clock reads per task.
+//
+//  setElastic() (TP_SHARED_QUEUE only) lets the pool shrink to a minimum
+//  number of workers when idle and grow back (up to num_workers) when tasks
+//  start to back up, without having to stop and rebuild the pool.
+//
+//  addTasks() submits a batch (ie, the tiles of an image) for the cost of one
+//  lock acquisition and one round of wake-ups, rather than one per task.
+//
+//  parallelFor() and parallelReduce() are helpers for data parallel loops in
+//  any mode.  The calling thread takes part in the loop and only returns once
+//  every iteration has finished, so they are safe to call from inside a task.
 
 #pragma once
 
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include "jtil/threading/callback.h"
-#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/task.h"
 #include "jtil/threading/callback_queue.h"
+#include "jtil/threading/work_stealing_deque.h"
+#include "jtil/threading/lock_free_queue.h"
+#include "jtil/threading/parallel_for.h"
+#include "jtil/threading/thread_pool_stats.h"
+
+#define THREAD_POOL_LOCK_FREE_QUEUE_SIZE 4096  // TP_LOCK_FREE_QUEUE capacity
+#define THREAD_POOL_NUM_TASK_SLOTS 1024  // Preallocated slots for addTask(Task)
+#define THREAD_POOL_ADD_TASKS_BATCH_SIZE 64  // Stack buffer for Task batches
 
 namespace jtil {
 namespace threading {
+
+  typedef enum {
+    TP_SHARED_QUEUE,  // One queue shared between all workers (default)
+    TP_WORK_STEALING,  // Per-worker deques with random victim stealing
+    TP_LOCK_FREE_QUEUE,  // One bounded lock-free queue shared by all workers
+  } ThreadPoolMode;
+
+  typedef enum {
+    TP_PRIORITY_LOW,  // Background work (ie, asset loading)
+    TP_PRIORITY_NORMAL,  // Default
+    TP_PRIORITY_HIGH,  // Frame critical work
+    TP_NUM_PRIORITIES,
+  } ThreadPoolPriority;
+
+  typedef enum {
+    TP_AFFINITY_NONE,  // The OS places the workers (default)
+    TP_AFFINITY_CPU_LIST,  // Worker i is pinned to cpus[i % num_cpus]
+    TP_AFFINITY_PHYSICAL_CORES,  // Worker i to physical core i (wrapping)
+  } ThreadPoolAffinity;
+
+  // Workers beyond min_workers retire once they have been idle for
+  // idle_timeout_ms.  A retired worker is started again when a task is queued
+  // while more than grow_queue_depth tasks are waiting, or while the queue
+  // has not drained for grow_latency_us.  Only unreserved workers retire, so
+  // min_workers counts unreserved workers (and is at most num_workers minus
+  // the reserved ones).
+  struct ThreadPoolElastic {
+    ThreadPoolElastic() : min_workers(1), idle_timeout_ms(1000),
+      grow_queue_depth(4), grow_latency_us(1000) { }
+    int min_workers;
+    int idle_timeout_ms;
+    int grow_queue_depth;
+    int grow_latency_us;
+  };
+
+  struct ThreadPoolPlacement {
+    ThreadPoolPlacement() : affinity(TP_AFFINITY_NONE), cpus(NULL),
+      num_cpus(0), numa_local_queues(false) { }
+    ThreadPoolAffinity affinity;
+    const int* cpus;  // TP_AFFINITY_CPU_LIST only (copied, not owned here)
+    int num_cpus;
+    // TP_WORK_STEALING only (the other modes have no per worker queues).  A
+    // worker's node is the node of its CPU, so this needs pinned workers.
+    bool numa_local_queues;
+  };
   
   class ThreadPool {
   public:
     
-    explicit ThreadPool(const int num_workers);
+    // num_reserved_workers (optional) - TP_NUM_PRIORITIES entries, entry p is
+    // the number of workers that only run tasks of priority p or higher.  The
+    // TP_PRIORITY_LOW entry is ignored and at least one worker must be left
+    // unreserved (otherwise this throws).
+    // placement (optional) - Where to run the workers (default: anywhere).
+    explicit ThreadPool(const int num_workers, 
+      const ThreadPoolMode mode = TP_SHARED_QUEUE,
+      const int* num_reserved_workers = NULL,
+      const ThreadPoolPlacement* placement = NULL);
     
     // ~ThreadPool() REQUIRES: stop() have completed executing.
     ~ThreadPool();
     
     // addTask() - Requests the execution of 'task' on an undetermined worker 
-    // thread.
-    void addTask(Callback<void>* task);
+    // thread.  Returns false if stop() has already been called, in which
+    // case nothing is queued and 'task' is deleted if it's a once callback.
+    // (Tasks still queued when stop() is called are never run.)
+    bool addTask(Callback<void>* task,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+
+    // addTask() - Same as above but 'task' is copied into a preallocated slot
+    // (no heap allocation).  If it returns false the caller can run 'task'
+    // itself.
+    bool addTask(const Task& task,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
     
+    // addTasks() - Same as calling addTask() on each of the n tasks, but the
+    // pool's lock is taken (and idle workers are woken) once for the batch.
+    // Returns false if the pool was stopped before all of them were queued.
+    bool addTasks(Callback<void>** tasks, const int n,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+    bool addTasks(const Task* tasks, const int n,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+
     // Waits for all the workers to finish processing the ongoing tasks
     // and stop then stop the pool. This call may be issued from within
     // a worker thread itself.  Stop is blocking, and once stop is called, the
@@ -42,7 +170,7 @@ namespace threading {
     void stop();
     
     // Returns the current size of the dispatch queue (pending tasks waiting to
-    // be executed).
+    // be executed), over all priorities.
     int count() const;
     
     // If stop was called by another thread (potentially a thread in the thread
@@ -50,17 +178,60 @@ namespace threading {
     // other stop to finish.  Importantly, the wait does not busy wait!
     void waitForStopFinish();
 
+    // parallelFor() - Calls fn(b, e) on consecutive sub-ranges [b, e) of 
+    // [begin, end) that are at most 'grain' iterations long.  Set grain <= 0
+    // to have it chosen for you (roughly 4 chunks per thread).  fn must be
+    // safe to call concurrently, it is called as const (a lambda is fine).
+    // The helper tasks are added with 'priority'.
+    template <typename Func>
+    void parallelFor(const int begin, const int end, const int grain,
+      const Func& fn, const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+
+    // parallelReduce() - Returns reduce(...reduce(reduce(identity, r0), r1)
+    // ..., rn) where ri = fn(b, e) is the result for the i'th sub-range.
+    // Partial results are combined in range order on the calling thread, so
+    // for a fixed grain the result does not depend on the scheduling.
+    template <typename T, typename Func, typename Reduce>
+    T parallelReduce(const int begin, const int end, const int grain,
+      const T& identity, const Func& fn, const Reduce& reduce,
+      const ThreadPoolPriority priority = TP_PRIORITY_NORMAL);
+
     inline const int& num_workers() const { return num_workers_; }
+    inline const ThreadPoolMode& mode() const { return mode_; }
+    inline bool stopped() const { return stop_called_.load(); }
+    // workerPriority() - The lowest priority worker 'i' will run
+    inline ThreadPoolPriority workerPriority(const int i) const {
+      return worker_priority_[i];
+    }
+    // workerCPU() - The CPU worker 'i' is pinned to, or -1 if it isn't
+    inline int workerCPU(const int i) const { return worker_cpu_[i]; }
+    inline int workerNumaNode(const int i) const { return worker_node_[i]; }
+
+    // setElastic() - Let idle workers retire (and be restarted on demand).
+    // TP_SHARED_QUEUE only, throws otherwise.
+    void setElastic(const ThreadPoolElastic& elastic);
+    // numRunningWorkers() - Workers that haven't retired
+    int numRunningWorkers() const;
+
+    // setStatsEnabled() - Start (or stop) updating the worker counters.  Off
+    // by default.  The counters are kept while stats are off.
+    void setStatsEnabled(const bool enabled);
+    inline bool statsEnabled() const { return stats_enabled_.load(); }
+
+    // getStats() - Snapshot of the worker counters (from any thread).  Each
+    // counter is read atomically, but not all of them at the same instant.
+    void getStats(ThreadPoolStats* stats) const;
     
   private:
     mutable std::mutex queue_lock_;
     mutable std::mutex stop_finished_lock_;
-    CallbackQueue<Callback<void>*> callback_queue_;  // tasks waiting 4 execut.
+    // tasks waiting 4 execut. (one queue per priority)
+    CallbackQueue<Callback<void>*> callback_queues_[TP_NUM_PRIORITIES];
     std::thread* worker_ids_;
     Callback<void>* stopCB_once_;
     Callback<void>* stopCB_many_;
     int num_workers_;
-    bool stop_called_;
+    std::atomic<bool> stop_called_;
     bool stop_finished_;
     std::condition_variable stop_finished_cv_;
 
@@ -73,15 +244,190 @@ namespace threading {
     // New for ThreadPool
     std::condition_variable* worker_cvs_;  // Array of cv's - 1 for each worker
     Callback<void>** idle_worker_tasks_;
-    CallbackQueue<int> idle_worker_queue_;  // Queue of idle workers
+    // Queues of idle workers, by the lowest priority they will run
+    CallbackQueue<int> idle_worker_queues_[TP_NUM_PRIORITIES];
+    ThreadPoolPriority* worker_priority_;  // Per worker
+    bool has_reserved_workers_;
+    int num_reserved_workers_;
+    int* worker_cpu_;
+    int* worker_node_;
+
+    // TP_WORK_STEALING data
+    ThreadPoolMode mode_;
+    // One deque per worker per priority: [worker * TP_NUM_PRIORITIES + p]
+    WorkStealingDeque<Callback<void>*>** worker_deques_;
+    uint32_t* worker_rand_state_;  // xorshift state for victim selection
+    // Victims for each worker: [worker * (num_workers_ - 1) + i], the ones on
+    // the same NUMA node first
+    int* worker_steal_order_;
+    int* worker_num_local_;  // Victims on the same node
+    // Tasks queued but not yet started (per priority)
+    std::atomic<int> num_pending_[TP_NUM_PRIORITIES];
+    std::atomic<int> num_shared_pending_;  // Tasks in callback_queues_
+    std::atomic<int> num_sleeping_;  // Workers waiting on work_cv_
+    std::atomic<int> num_adding_;  // Lock-free adds stop() must wait for
+    std::condition_variable work_cv_;
+
+    // TP_LOCK_FREE_QUEUE data
+    LockFreeQueue<Callback<void>*>* lf_task_queues_[TP_NUM_PRIORITIES];
+    LockFreeQueue<int>* lf_idle_worker_queues_[TP_NUM_PRIORITIES];
+    std::mutex* worker_locks_;  // Only protect worker_woken_ and worker_cvs_
+    bool* worker_woken_;  // Taken off the idle queue by addTask
+    bool* worker_busy_;  // Running a task while still on the idle queue
+
+    // addTask(const Task&) data
+    TaskSlot* task_slots_;
+    LockFreeQueue<TaskSlot*>* free_task_slots_;
+
+    // Stats.  Only the worker writes its counters (with relaxed loads and
+    // stores rather than atomic increments), getStats() may read them from
+    // any thread.
+    struct WorkerCounters {
+      std::atomic<uint64_t> num_tasks;
+      std::atomic<uint64_t> num_steals;
+      std::atomic<int64_t> busy_ns;
+      std::atomic<int64_t> idle_ns;
+      std::atomic<int64_t> steal_ns;
+      std::atomic<uint64_t> num_latency_samples;
+      std::atomic<int64_t> latency_ns;
+      std::atomic<uint64_t> run_time[THREAD_POOL_HISTOGRAM_NUM_BUCKETS];
+      std::atomic<uint64_t> latency[THREAD_POOL_HISTOGRAM_NUM_BUCKETS];
+      char padding[64];  // Keep the next worker's counters off our lines
+    };
+    // Elastic data (TP_SHARED_QUEUE), protected by queue_lock_
+    bool elastic_enabled_;
+    ThreadPoolElastic elastic_;
+    bool* worker_running_;  // false once a worker has retired
+    bool* worker_idle_;  // On one of the idle_worker_queues_
+    int num_running_workers_;
+    int64_t backlog_start_ns_;  // When the queue last became non-empty
+
+    std::atomic<bool> stats_enabled_;
+    WorkerCounters* worker_counters_;
     
+    void initPlacement(const ThreadPoolPlacement* placement);
+    void initWorkerThread(const int thread_index);
+    void runTask(const int thread_index, Callback<void>* task);
+    TaskSlot* poolTaskSlot(Callback<void>* task) const;
+    int64_t statsStart() const;  // 0 if stats are off
+    void statsAddIdle(const int thread_index, const int64_t start_ns);
     // This is the main worker thread:
     void workerMain(const int thread_index);  
+    void workerMainWorkStealing(const int thread_index);
+    bool addTasksWorkStealing(Callback<void>** tasks, const int n,
+      const ThreadPoolPriority priority);
+    bool beginLockFreeAdd();  // false if stopped, else end with num_adding_--
+    void notifyWorkStealing(const int n);  // REQUIRES: queue_lock_ held
+    Callback<void>* findTaskWorkStealing(const int thread_index,
+      int* priority);
+    int numPendingWorkStealing(const int min_priority) const;
+    void workerMainLockFree(const int thread_index);
+    bool addTasksLockFree(Callback<void>** tasks, const int n,
+      const ThreadPoolPriority priority);
+    Callback<void>* findTaskLockFree(const int min_priority);
+    bool dequeueIdleWorkerLockFree(const int priority, int& worker);
+    void wakeIdleWorkersLockFree(const int priority, const int n);
+    // REQUIRES: queue_lock_ held
+    Callback<void>* dequeueShared(const int min_priority);
+    int dequeueIdleWorker(const int priority);
+    void removeIdleWorker(const int thread_index);
+    bool canRetire(const int thread_index) const;
+    bool hasRunningWorker(const int priority) const;
+    // Both return the retired thread they replaced (if any), for the caller
+    // to join once it has released queue_lock_
+    std::thread growIfBacklogged(const int priority);
+    std::thread startWorker(const int thread_index);
     
+    TaskSlot* getTaskSlot(const Task& task);
+    // rejectTasks() - Deletes the once callbacks and frees the slots of tasks
+    // that were added after stop()
+    void rejectTasks(Callback<void>** tasks, const int n);
+    template <typename Job>
+    void addJobRefs(Job* job, const int num_refs,
+      const ThreadPoolPriority priority);
+    int parallelGrain(const int begin, const int end, const int grain) const;
+    int parallelNumHelpers(const int num_chunks) const;
+
     // Non-copyable, non-assignable.
     ThreadPool(const ThreadPool&);
     ThreadPool& operator=(const ThreadPool&);
   };
+
+  inline int ThreadPool::parallelGrain(const int begin, const int end,
+    const int grain) const {
+    if (grain > 0) {
+      return grain;
+    }
+    const int num_chunks = 4 * (num_workers_ + 1);
+    const int auto_grain = (end - begin + num_chunks - 1) / num_chunks;
+    return auto_grain > 0 ? auto_grain : 1;
+  }
+
+  inline int ThreadPool::parallelNumHelpers(const int num_chunks) const {
+    if (stop_called_) {
+      return 0;  // Nobody would run the helpers: do everything on this thread
+    }
+    // The calling thread does one share of the work
+    return (num_chunks - 1) < num_workers_ ? (num_chunks - 1) : num_workers_;
+  }
+
+  template <typename Job>
+  void ThreadPool::addJobRefs(Job* job, const int num_refs,
+    const ThreadPoolPriority priority) {
+    Callback<void>* refs[THREAD_POOL_ADD_TASKS_BATCH_SIZE];
+    for (int i = 0; i < num_refs; i += THREAD_POOL_ADD_TASKS_BATCH_SIZE) {
+      int batch_size = num_refs - i;
+      if (batch_size > THREAD_POOL_ADD_TASKS_BATCH_SIZE) {
+        batch_size = THREAD_POOL_ADD_TASKS_BATCH_SIZE;
+      }
+      for (int j = 0; j < batch_size; j++) {
+        refs[j] = new ParallelJobRef<Job>(job);
+      }
+      addTasks(refs, batch_size, priority);
+    }
+  }
+
+  template <typename Func>
+  void ThreadPool::parallelFor(const int begin, const int end, 
+    const int grain, const Func& fn, const ThreadPoolPriority priority) {
+    if (end <= begin) {
+      return;
+    }
+    const int chunk_size = parallelGrain(begin, end, grain);
+    const int num_chunks = (end - begin + chunk_size - 1) / chunk_size;
+    const int num_helpers = parallelNumHelpers(num_chunks);
+    if (num_helpers == 0) {
+      fn(begin, end);
+      return;
+    }
+    ParallelForJob<Func>* job = new ParallelForJob<Func>(begin, end, 
+      chunk_size, num_helpers + 1, fn);
+    addJobRefs<ParallelForJob<Func> >(job, num_helpers, priority);
+    job->runAndWait();
+  }
+
+  template <typename T, typename Func, typename Reduce>
+  T ThreadPool::parallelReduce(const int begin, const int end, 
+    const int grain, const T& identity, const Func& fn, 
+    const Reduce& reduce, const ThreadPoolPriority priority) {
+    if (end <= begin) {
+      return identity;
+    }
+    const int chunk_size = parallelGrain(begin, end, grain);
+    const int num_chunks = (end - begin + chunk_size - 1) / chunk_size;
+    const int num_helpers = parallelNumHelpers(num_chunks);
+    T* results = new T[num_chunks];
+    ParallelReduceJob<T, Func>* job = new ParallelReduceJob<T, Func>(begin, 
+      end, chunk_size, num_helpers + 1, fn, results);
+    addJobRefs<ParallelForJob<Func> >(job, num_helpers, priority);
+    job->runAndWait();
+    T ret_val = identity;
+    for (int i = 0; i < num_chunks; i++) {
+      ret_val = reduce(ret_val, results[i]);
+    }
+    delete[] results;
+    return ret_val;
+  }
   
 };  // namespace threading
 };  // namespace jtil
@@ -0,0 +1,170 @@
+//
+//  thread_pool_stats.h
+//
+//  Snapshots of the ThreadPool's (optional) per-worker counters, returned by
+//  ThreadPool::getStats().  Counters only ever increase, so to look at one
+//  frame take a snapshot at the start and subtract it from one at the end.
+//
+//  All times are in nanoseconds.  Enqueue-to-start latency is only known for
+//  tasks added by value (addTask(const Task&)), since the pool has nowhere
+//  to keep the enqueue time of a raw Callback pointer.
+//
+
+#pragma once
+
+#include "jtil/math/math_types.h"  // for int64_t
+#include "jtil/data_str/vector.h"
+
+// Bucket i counts samples in [2^i, 2^(i+1)) microseconds (bucket 0 also has
+// everything under 1us and the last bucket everything above)
+#define THREAD_POOL_HISTOGRAM_NUM_BUCKETS 24
+
+namespace jtil {
+namespace threading {
+
+  struct ThreadPoolHistogram {
+    uint64_t buckets[THREAD_POOL_HISTOGRAM_NUM_BUCKETS];
+
+    ThreadPoolHistogram() { clear(); }
+
+    void clear() {
+      for (int i = 0; i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; i++) {
+        buckets[i] = 0;
+      }
+    }
+
+    static inline int bucket(const int64_t time_ns) {
+      int64_t time_us = time_ns / 1000;
+      int i = 0;
+      while (time_us > 1 && i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS - 1) {
+        time_us >>= 1;
+        i++;
+      }
+      return i;
+    }
+
+    uint64_t count() const {
+      uint64_t num = 0;
+      for (int i = 0; i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; i++) {
+        num += buckets[i];
+      }
+      return num;
+    }
+
+    // percentileUS() - An upper bound (the bucket's upper edge) on the p'th
+    // percentile (0 <= p <= 1), in microseconds.  0 if there are no samples.
+    double percentileUS(const double p) const {
+      const uint64_t num = count();
+      if (num == 0) {
+        return 0;
+      }
+      uint64_t target = static_cast<uint64_t>(p * static_cast<double>(num));
+      target = target < 1 ? 1 : (target > num ? num : target);
+      uint64_t sum = 0;
+      int i = 0;
+      for (; i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS - 1; i++) {
+        sum += buckets[i];
+        if (sum >= target) {
+          break;
+        }
+      }
+      return static_cast<double>(static_cast<int64_t>(2) << i);
+    }
+
+    void add(const ThreadPoolHistogram& other) {
+      for (int i = 0; i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; i++) {
+        buckets[i] += other.buckets[i];
+      }
+    }
+
+    void subtract(const ThreadPoolHistogram& earlier) {
+      for (int i = 0; i < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; i++) {
+        buckets[i] -= earlier.buckets[i];
+      }
+    }
+  };
+
+  struct ThreadPoolWorkerStats {
+    uint64_t num_tasks;  // Tasks run
+    uint64_t num_steals;  // TP_WORK_STEALING: tasks taken from other workers
+    int64_t busy_ns;  // Running tasks
+    int64_t idle_ns;  // Asleep, waiting for work
+    int64_t steal_ns;  // TP_WORK_STEALING: searching other workers' deques
+    uint64_t num_latency_samples;
+    int64_t latency_ns;  // Total enqueue-to-start time of those samples
+    ThreadPoolHistogram run_time;
+    ThreadPoolHistogram latency;  // Enqueue to start
+
+    ThreadPoolWorkerStats() { clear(); }
+
+    void clear() {
+      num_tasks = 0;
+      num_steals = 0;
+      busy_ns = 0;
+      idle_ns = 0;
+      steal_ns = 0;
+      num_latency_samples = 0;
+      latency_ns = 0;
+      run_time.clear();
+      latency.clear();
+    }
+
+    void add(const ThreadPoolWorkerStats& other) {
+      num_tasks += other.num_tasks;
+      num_steals += other.num_steals;
+      busy_ns += other.busy_ns;
+      idle_ns += other.idle_ns;
+      steal_ns += other.steal_ns;
+      num_latency_samples += other.num_latency_samples;
+      latency_ns += other.latency_ns;
+      run_time.add(other.run_time);
+      latency.add(other.latency);
+    }
+
+    void subtract(const ThreadPoolWorkerStats& earlier) {
+      num_tasks -= earlier.num_tasks;
+      num_steals -= earlier.num_steals;
+      busy_ns -= earlier.busy_ns;
+      idle_ns -= earlier.idle_ns;
+      steal_ns -= earlier.steal_ns;
+      num_latency_samples -= earlier.num_latency_samples;
+      latency_ns -= earlier.latency_ns;
+      run_time.subtract(earlier.run_time);
+      latency.subtract(earlier.latency);
+    }
+
+    // meanLatencyUS() - 0 if there are no samples
+    double meanLatencyUS() const {
+      if (num_latency_samples == 0) {
+        return 0;
+      }
+      return 1e-3 * static_cast<double>(latency_ns) /
+        static_cast<double>(num_latency_samples);
+    }
+  };
+
+  struct ThreadPoolStats {
+    int queue_depth;  // count() when the snapshot was taken
+    data_str::Vector<ThreadPoolWorkerStats> workers;
+    ThreadPoolWorkerStats total;  // Sum over the workers
+
+    ThreadPoolStats() : queue_depth(0) { }
+
+    // subtract() - Turn this snapshot into the difference from 'earlier'
+    // (taken from the same pool)
+    void subtract(const ThreadPoolStats& earlier) {
+      for (uint32_t i = 0; i < workers.size() && i < earlier.workers.size();
+        i++) {
+        workers[i].subtract(earlier.workers[i]);
+      }
+      total.subtract(earlier.total);
+    }
+
+  private:
+    // Vector's copy constructor is shallow: fill snapshots with
+    // ThreadPool::getStats() (or copy them with operator=) instead
+    ThreadPoolStats(const ThreadPoolStats&);
+  };
+
+};  // namespace threading
+};  // namespace jtil
@@ -0,0 +1,189 @@
+//
+//  work_stealing_deque.h
+//
+//  A Chase-Lev work stealing deque.  The owner thread pushes and pops from the
+//  bottom (LIFO) while any number of thief threads steal from the top (FIFO).
+//  The implementation follows: "Correct and Efficient Work-Stealing for Weak
+//  Memory Models", Le, Pop, Cohen & Zappa Nardelli, PPoPP 2013.
+//
+//  T must be a trivially copyable type (ie, pointers to tasks).  The circular
+//  array grows when full, but old arrays are not released until the deque is
+//  destroyed (a thief may still be reading from them).
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "jtil/math/math_types.h"  // for uint32_t
+
+#define WORK_STEALING_DEQUE_DEFAULT_SIZE 256  // Must be a power of 2
+
+namespace jtil {
+namespace threading {
+
+  template <class T>
+  class WorkStealingDeque {
+  public:
+    explicit WorkStealingDeque(const uint32_t capacity =
+      WORK_STEALING_DEQUE_DEFAULT_SIZE);
+    ~WorkStealingDeque();
+
+    // push() - Add to the bottom of the deque.  Owner thread only.
+    void push(const T& item);
+
+    // pop() - Remove from the bottom of the deque.  Owner thread only.
+    // Returns false if the deque is empty.
+    bool pop(T& item);
+
+    // steal() - Remove from the top of the deque.  Any thread.  Returns false
+    // if the deque is empty OR if we lost a race with another thief (or the
+    // owner) for the last element.
+    bool steal(T& item);
+
+    // size() - Only a snapshot (may be stale by the time it returns)
+    int64_t size() const;
+    inline bool empty() const { return size() <= 0; }
+
+  private:
+    struct Array {
+      explicit Array(const int64_t capacity);
+      ~Array();
+      inline T get(const int64_t i) const {
+        return buffer[i & mask].load(std::memory_order_relaxed);
+      }
+      inline void put(const int64_t i, const T& item) {
+        buffer[i & mask].store(item, std::memory_order_relaxed);
+      }
+      Array* grow(const int64_t bottom, const int64_t top) const;
+
+      int64_t capacity;
+      int64_t mask;
+      std::atomic<T>* buffer;
+      Array* prev;  // Retired arrays (released in the deque destructor)
+    };
+
+    std::atomic<int64_t> top_;
+    std::atomic<int64_t> bottom_;
+    std::atomic<Array*> array_;
+
+    // Non-copyable, non-assignable.
+    WorkStealingDeque(const WorkStealingDeque&);
+    WorkStealingDeque& operator=(const WorkStealingDeque&);
+  };
+
+  template <class T>
+  WorkStealingDeque<T>::Array::Array(const int64_t capacity) {
+    this->capacity = capacity;
+    mask = capacity - 1;
+    buffer = new std::atomic<T>[static_cast<size_t>(capacity)];
+    prev = NULL;
+  }
+
+  template <class T>
+  WorkStealingDeque<T>::Array::~Array() {
+    delete[] buffer;
+  }
+
+  template <class T>
+  typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::Array::grow(
+    const int64_t bottom, const int64_t top) const {
+    Array* new_array = new Array(capacity * 2);
+    for (int64_t i = top; i < bottom; i++) {
+      new_array->put(i, get(i));
+    }
+    return new_array;
+  }
+
+  template <class T>
+  WorkStealingDeque<T>::WorkStealingDeque(const uint32_t capacity) {
+    // Round the capacity up to the nearest power of 2
+    int64_t cap = 1;
+    while (cap < static_cast<int64_t>(capacity)) {
+      cap <<= 1;
+    }
+    top_.store(0, std::memory_order_relaxed);
+    bottom_.store(0, std::memory_order_relaxed);
+    array_.store(new Array(cap), std::memory_order_relaxed);
+  }
+
+  template <class T>
+  WorkStealingDeque<T>::~WorkStealingDeque() {
+    Array* a = array_.load(std::memory_order_relaxed);
+    while (a != NULL) {
+      Array* prev = a->prev;
+      delete a;
+      a = prev;
+    }
+  }
+
+  template <class T>
+  void WorkStealingDeque<T>::push(const T& item) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Array* a = array_.load(std::memory_order_relaxed);
+    if (b - t > a->capacity - 1) {  // Full --> Grow the array
+      Array* new_array = a->grow(b, t);
+      new_array->prev = a;
+      array_.store(new_array, std::memory_order_release);
+      a = new_array;
+    }
+    a->put(b, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  template <class T>
+  bool WorkStealingDeque<T>::pop(T& item) {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    bool ret_val = true;
+    if (t <= b) {
+      // Non-empty
+      item = a->get(b);
+      if (t == b) {
+        // Last element, we have to race the thieves for it
+        if (!top_.compare_exchange_strong(t, t + 1,
+          std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          ret_val = false;  // Lost the race
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {
+      // Empty
+      ret_val = false;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return ret_val;
+  }
+
+  template <class T>
+  bool WorkStealingDeque<T>::steal(T& item) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t < b) {
+      // Non-empty
+      Array* a = array_.load(std::memory_order_consume);
+      item = a->get(t);
+      if (!top_.compare_exchange_strong(t, t + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;  // Lost the race
+      }
+      return true;
+    }
+    return false;
+  }
+
+  template <class T>
+  int64_t WorkStealingDeque<T>::size() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b - t;
+  }
+
+};  // namespace threading
+};  // namespace jtil
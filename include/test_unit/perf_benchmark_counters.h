@@ -0,0 +1,52 @@
+//
+//  perf_benchmark_counters.h
+//
+//  Reports the hardware performance counters (jtil::debug::PerfCounters) of
+//  every BENCHMARK run, per iteration.  In the test's main():
+//
+//    tests::PerfBenchmarkCounters perf_counters;
+//    tests::TestRegistry::getInstance()->setBenchmarkCounters(&perf_counters);
+//    int ret_val = RUN_TESTS(argc, argv);
+//
+//  Counters that are unavailable (see perf_counters.h) are left out.
+//
+
+#pragma once
+
+#include "test_unit/test_unit.h"
+#include "jtil/debug_util/perf_counters.h"
+
+namespace tests {
+
+class PerfBenchmarkCounters : public BenchmarkCounters {
+ public:
+  PerfBenchmarkCounters() {}
+  virtual ~PerfBenchmarkCounters() {}
+
+  virtual void start() {
+    counters_.read(&start_);
+  }
+
+  virtual void stop(BenchmarkState* state) {
+    jtil::debug::PerfCounterValues end;
+    counters_.read(&end);
+    for (int i = 0; i < jtil::debug::PERF_NUM_COUNTERS; i++) {
+      if (start_.valid[i] && end.valid[i] &&
+          end.counts[i] >= start_.counts[i]) {
+        state->setCounter(jtil::debug::PerfCounters::name(
+          static_cast<jtil::debug::PerfCounter>(i)),
+          static_cast<double>(end.counts[i] - start_.counts[i]));
+      }
+    }
+  }
+
+ private:
+  jtil::debug::PerfCounters counters_;  // Of the thread running the tests
+  jtil::debug::PerfCounterValues start_;
+
+  // Non-copyable, non-assignable.
+  PerfBenchmarkCounters(const PerfBenchmarkCounters&);
+  PerfBenchmarkCounters& operator=(const PerfBenchmarkCounters&);
+};
+
+}  // namespace tests
@@ -3,14 +3,44 @@
 //
 //  Created by Alberto Lerner, then edited by Jonathan Tompson on 4/26/12.
 //
+//  BENCHMARK(group, name) cases run with the TESTs.  The body must run its
+//  timed loop state.iterations() times:
+//
+//    BENCHMARK(Vector, PushBack) {
+//      Vector<int> vec;
+//      for (uint64_t i = 0; i < state.iterations(); i++) {
+//        vec.pushBack(static_cast<int>(i));
+//      }
+//      tests::DoNotOptimize(vec);
+//    }
+//
+//  The body is called with a doubling number of iterations until one run
+//  takes --benchmark_min_ms, then run --benchmark_warmup more times untimed
+//  and --benchmark_reps times timed.  The min / median / p99 / mean of the
+//  time per iteration are printed, and saved as JSON to --benchmark_json (if
+//  given).  The body can also report its own totals with state.setCounter(),
+//  and TestRegistry::setBenchmarkCounters() adds counters read around every
+//  run (see test_unit/perf_benchmark_counters.h for hardware counters).  They
+//  are reported per iteration (median over the repetitions).
+//
 
 #pragma once
 
+#include <stdlib.h>  // atof, atoi
+#include <stdint.h>
 #include <unordered_map>
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <utility>
 #include <vector>
 #include "test_unit/param_map.h"
+#if defined(_MSC_VER)
+  #include <intrin.h>  // _ReadWriteBarrier
+#endif
 
 extern bool TESTS_exit_on_fatal;
 extern bool TESTS_has_fatal_message;
@@ -49,6 +79,140 @@ class TestCase {
   int    errors_;
 };
 
+// DoNotOptimize() - Forces 'value' to be computed (and stored, if it's in
+// memory) even if it's never read.  ClobberMemory() - Forces all pending
+// writes to memory.
+#if defined(_MSC_VER)
+__declspec(noinline) void BenchmarkUseCharPointer(char const volatile*) {}
+
+template <class T>
+inline void DoNotOptimize(const T& value) {
+  BenchmarkUseCharPointer(&reinterpret_cast<char const volatile&>(value));
+  _ReadWriteBarrier();
+}
+
+inline void ClobberMemory() {
+  _ReadWriteBarrier();
+}
+#elif defined(__clang__)
+template <class T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <class T>
+inline void DoNotOptimize(T& value) {
+  asm volatile("" : "+r,m"(value) : : "memory");
+}
+#else
+// GCC can drop the store of 'value' when given the choice of a register
+// (seen with -fsanitize=address), so always pass it in memory
+template <class T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+template <class T>
+inline void DoNotOptimize(T& value) {
+  asm volatile("" : "+m"(value) : : "memory");
+}
+
+inline void ClobberMemory() {
+  asm volatile("" : : : "memory");
+}
+#endif
+
+class BenchmarkState {
+ public:
+  explicit BenchmarkState(const uint64_t iterations)
+    : iterations_(iterations), items_per_iteration_(0) {}
+
+  uint64_t iterations() const { return iterations_; }
+
+  // setItemsPerIteration() - Optional, to also report items per second
+  void setItemsPerIteration(const double items) {
+    items_per_iteration_ = items;
+  }
+  double itemsPerIteration() const { return items_per_iteration_; }
+
+  // setCounter() - Optional, the total of 'name' over all the iterations
+  void setCounter(const string& name, const double total) {
+    for (size_t i = 0; i < counters_.size(); i++) {
+      if (counters_[i].first == name) {
+        counters_[i].second = total;
+        return;
+      }
+    }
+    counters_.push_back(std::make_pair(name, total));
+  }
+  const vector<std::pair<string, double> >& counters() const {
+    return counters_;
+  }
+
+ private:
+  uint64_t iterations_;
+  double   items_per_iteration_;
+  vector<std::pair<string, double> > counters_;
+};
+
+// Counters read around every benchmark run, see
+// TestRegistry::setBenchmarkCounters()
+class BenchmarkCounters {
+ public:
+  virtual ~BenchmarkCounters() {}
+  virtual void start() = 0;
+  // stop() - Report the counts since start() with state->setCounter()
+  virtual void stop(BenchmarkState* state) = 0;
+};
+
+struct BenchmarkResult {
+  string   group;
+  string   name;
+  uint64_t iterations;  // Per repetition
+  int      repetitions;
+  double   min_ns;  // Per iteration
+  double   median_ns;
+  double   p99_ns;
+  double   mean_ns;
+  double   items_per_sec;  // From the median, 0 if not set
+  vector<std::pair<string, double> > counters;  // Median per iteration
+
+  // computeStats() - Fills in the statistics from the time per iteration of
+  // each repetition (which are sorted)
+  void computeStats(vector<double>* ns_per_iteration,
+    const double items_per_iteration);
+};
+
+void BenchmarkResult::computeStats(vector<double>* ns_per_iteration,
+  const double items_per_iteration) {
+  vector<double>& ns = *ns_per_iteration;
+  repetitions = static_cast<int>(ns.size());
+  min_ns = median_ns = p99_ns = mean_ns = items_per_sec = 0;
+  if (ns.empty()) {
+    return;
+  }
+  std::sort(ns.begin(), ns.end());
+  const size_t n = ns.size();
+  min_ns = ns[0];
+  median_ns = n % 2 == 1 ? ns[n / 2] : 0.5 * (ns[n / 2 - 1] + ns[n / 2]);
+  // Nearest rank
+  const size_t p99_rank = (99 * n + 99) / 100;
+  p99_ns = ns[std::max<size_t>(p99_rank, 1) - 1];
+  for (size_t i = 0; i < n; i++) {
+    mean_ns += ns[i];
+  }
+  mean_ns /= static_cast<double>(n);
+  if (items_per_iteration > 0 && median_ns > 0) {
+    items_per_sec = items_per_iteration * 1e9 / median_ns;
+  }
+}
+
+struct BenchmarkSettings {
+  double min_time_ms;  // Of one repetition
+  int    warmup_runs;
+  int    repetitions;
+};
+
 class TestRegistry {
  public:
   ~TestRegistry() {}
@@ -58,22 +222,87 @@ class TestRegistry {
   TestCase* registerCase(TestCase* test);
   int runAndResetWithArgs(int argc, char* argv[]);
 
+  const BenchmarkSettings& benchmarkSettings() const {
+    return benchmark_settings_;
+  }
+  // setBenchmarkCounters() - Read 'counters' around every benchmark run
+  // (NULL to stop).  Not owned here.
+  void setBenchmarkCounters(BenchmarkCounters* counters) {
+    benchmark_counters_ = counters;
+  }
+  BenchmarkCounters* benchmarkCounters() const { return benchmark_counters_; }
+  void addBenchmarkResult(const BenchmarkResult& result) {
+    benchmark_results_.push_back(result);
+  }
+
  private:
   typedef vector<TestCase*> Tests;
 
   static TestRegistry*      instance_;
   Tests                     tests_;    // owned by this
   ParamMap                  args_;     // --case to be run
+  BenchmarkSettings         benchmark_settings_;
+  vector<BenchmarkResult>   benchmark_results_;
+  BenchmarkCounters*        benchmark_counters_;  // not owned here
 
   void runListCases(int* errors);
   void runSomeCases(int* errors, const string& cases);
+  void readBenchmarkSettings();
+  bool saveBenchmarkJSON(const string& filename) const;
 
   TestRegistry();
 };
 
-TestRegistry::TestRegistry() {
+TestRegistry::TestRegistry() : benchmark_counters_(NULL) {
   args_.addParam("case", "all", "csv list of test cases to run");
   args_.addParam("listcases", "false", "list the test cases for this test");
+  args_.addParam("benchmark_min_ms", "2",
+    "minimum time of one benchmark repetition");
+  args_.addParam("benchmark_warmup", "2", "untimed runs before timing");
+  args_.addParam("benchmark_reps", "30", "timed runs per benchmark");
+  args_.addParam("benchmark_json", "", "file to save benchmark results to");
+  readBenchmarkSettings();
+}
+
+void TestRegistry::readBenchmarkSettings() {
+  string value;
+  args_.getParam("benchmark_min_ms", &value);
+  benchmark_settings_.min_time_ms = std::max(atof(value.c_str()), 0.0);
+  args_.getParam("benchmark_warmup", &value);
+  benchmark_settings_.warmup_runs = std::max(atoi(value.c_str()), 0);
+  args_.getParam("benchmark_reps", &value);
+  benchmark_settings_.repetitions = std::max(atoi(value.c_str()), 1);
+}
+
+bool TestRegistry::saveBenchmarkJSON(const string& filename) const {
+  std::ofstream file(filename.c_str(), std::ios::out);
+  if (!file.is_open()) {
+    std::cout << "Cannot open benchmark output file: " << filename
+              << std::endl;
+    return false;
+  }
+  file << std::setprecision(6);
+  file << "{\n  \"benchmarks\": [";
+  for (size_t i = 0; i < benchmark_results_.size(); i++) {
+    const BenchmarkResult& r = benchmark_results_[i];
+    file << (i == 0 ? "\n" : ",\n");
+    file << "    {\"group\": \"" << r.group << "\", \"name\": \""
+         << r.name << "\", \"iterations\": " << r.iterations
+         << ", \"repetitions\": " << r.repetitions
+         << ", \"min_ns\": " << r.min_ns
+         << ", \"median_ns\": " << r.median_ns
+         << ", \"p99_ns\": " << r.p99_ns
+         << ", \"mean_ns\": " << r.mean_ns
+         << ", \"items_per_second\": " << r.items_per_sec
+         << ", \"counters\": {";
+    for (size_t j = 0; j < r.counters.size(); j++) {
+      file << (j == 0 ? "" : ", ") << "\"" << r.counters[j].first << "\": "
+           << r.counters[j].second;
+    }
+    file << "}}";
+  }
+  file << "\n  ]\n}\n";
+  return true;
 }
 
 TestRegistry* TestRegistry::instance_ = NULL;
@@ -151,6 +380,7 @@ int TestRegistry::runAndResetWithArgs(int argc, char* argv[]) {
     errors += 1 /* one error, parsing */;
     exit = true;
   }
+  readBenchmarkSettings();
 
   // Check if we just want to learn the names of the test's cases.
   string list_only;
@@ -167,6 +397,11 @@ int TestRegistry::runAndResetWithArgs(int argc, char* argv[]) {
   if (!exit && args_.getParam("case", &cases)) {
     runSomeCases(&errors, cases);
     exit = true;
+    string json;
+    if (args_.getParam("benchmark_json", &json) && !json.empty() &&
+        !saveBenchmarkJSON(json)) {
+      errors++;
+    }
   }
 
   for (Tests::const_iterator it = tests_.begin(); it != tests_.end(); ++it) {
@@ -180,6 +415,115 @@ int TestRegistry::runAndResetWithArgs(int argc, char* argv[]) {
   return errors;
 }
 
+// The base class of BENCHMARK cases.  testBody() runs the harness.
+class BenchmarkCase : public TestCase {
+ public:
+  virtual void testBody();
+  virtual void benchmarkBody(BenchmarkState& state) = 0;
+
+ protected:
+  BenchmarkCase(const string& group, const string& name)
+    : TestCase(group, name) {}
+
+ private:
+  // Returns the wall time of one run in ns
+  double run(BenchmarkState* state);
+};
+
+double BenchmarkCase::run(BenchmarkState* state) {
+  BenchmarkCounters* counters =
+    TestRegistry::getInstance()->benchmarkCounters();
+  if (counters != NULL) {
+    counters->start();
+  }
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  benchmarkBody(*state);
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  if (counters != NULL) {
+    counters->stop(state);
+  }
+  return static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+}
+
+void BenchmarkCase::testBody() {
+  const BenchmarkSettings& settings =
+    TestRegistry::getInstance()->benchmarkSettings();
+  const double min_time_ns = settings.min_time_ms * 1e6;
+  const uint64_t max_iterations = static_cast<uint64_t>(1) << 40;
+
+  // Grow the iteration count until one run is long enough (jump straight
+  // to the estimate once a run is long enough to be timed reliably)
+  uint64_t iterations = 1;
+  BenchmarkState first_state(iterations);
+  double time_ns = run(&first_state);
+  while (errors() == 0 && time_ns < min_time_ns &&
+         iterations < max_iterations) {
+    uint64_t next = iterations * 2;
+    if (time_ns > min_time_ns / 10) {
+      next = static_cast<uint64_t>(1.2 * min_time_ns / time_ns *
+        static_cast<double>(iterations)) + 1;
+    }
+    iterations = std::min(std::max(next, iterations + 1), max_iterations);
+    BenchmarkState state(iterations);
+    time_ns = run(&state);
+  }
+  if (errors() > 0) {
+    return;
+  }
+
+  for (int i = 0; i < settings.warmup_runs; i++) {
+    BenchmarkState state(iterations);
+    run(&state);
+  }
+  vector<double> ns_per_iteration;
+  vector<BenchmarkState> states;
+  for (int i = 0; i < settings.repetitions; i++) {
+    states.push_back(BenchmarkState(iterations));
+    ns_per_iteration.push_back(run(&states.back()) /
+      static_cast<double>(iterations));
+  }
+
+  BenchmarkResult result;
+  result.group = group();
+  result.name = name();
+  result.iterations = iterations;
+  result.computeStats(&ns_per_iteration, states.back().itemsPerIteration());
+  // The counters reported by the last repetition, median of all of them
+  const vector<std::pair<string, double> >& names = states.back().counters();
+  for (size_t c = 0; c < names.size(); c++) {
+    vector<double> per_iteration;
+    for (size_t i = 0; i < states.size(); i++) {
+      const vector<std::pair<string, double> >& cs = states[i].counters();
+      for (size_t j = 0; j < cs.size(); j++) {
+        if (cs[j].first == names[c].first) {
+          per_iteration.push_back(cs[j].second /
+            static_cast<double>(iterations));
+        }
+      }
+    }
+    BenchmarkResult stats;
+    stats.computeStats(&per_iteration, 0);
+    result.counters.push_back(std::make_pair(names[c].first,
+      stats.median_ns));
+  }
+  std::ios::fmtflags flags = std::cout.flags();
+  std::cout << std::setprecision(4) << iterations << " x "
+            << result.repetitions << " reps, ns per iteration: min "
+            << result.min_ns << ", median " << result.median_ns << ", p99 "
+            << result.p99_ns;
+  if (result.items_per_sec > 0) {
+    std::cout << ", items/sec " << result.items_per_sec;
+  }
+  for (size_t c = 0; c < result.counters.size(); c++) {
+    std::cout << ", " << result.counters[c].first << " "
+              << result.counters[c].second;
+  }
+  std::cout << " ";
+  std::cout.flags(flags);
+  TestRegistry::getInstance()->addBenchmarkResult(result);
+}
+
 }  // namespace base
 
 #define EXPECT_TRUE(a) \
@@ -272,6 +616,33 @@ private: \
   \
   void TEST_CLASS_NAME(test_group, test_name)::testBody()
 
+#define BENCHMARK(test_group, test_name) \
+class TEST_CLASS_NAME(test_group, test_name) : public tests::BenchmarkCase { \
+public: \
+  TEST_CLASS_NAME(test_group, test_name)(); \
+  virtual void benchmarkBody(tests::BenchmarkState& state); \
+  virtual void clear(); \
+private: \
+  static TestCase* me_; \
+}; \
+  \
+  tests::TestCase* TEST_CLASS_NAME(test_group, test_name)::me_ = \
+  tests::TestRegistry::getInstance()->registerCase( \
+  new TEST_CLASS_NAME(test_group, test_name)); \
+  \
+  TEST_CLASS_NAME(test_group, test_name)::\
+  TEST_CLASS_NAME(test_group, test_name)() \
+  : BenchmarkCase(# test_group, # test_name) {} \
+  \
+  void TEST_CLASS_NAME(test_group, test_name)::clear() { \
+  TestCase* me = me_; \
+  me_ = NULL; \
+  delete me; \
+} \
+  \
+  void TEST_CLASS_NAME(test_group, test_name)::benchmarkBody( \
+  tests::BenchmarkState& state)
+
 #define RUN_TESTS(argc, argv) \
   (tests::TestRegistry::getInstance()->runAndResetWithArgs(argc, argv))
 
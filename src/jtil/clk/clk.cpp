@@ -0,0 +1,99 @@
+#include "jtil/clk/clk.h"
+#if defined(CLK_HAS_TSC) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+namespace jtil {
+namespace clk {
+
+  Clk::Clk(const ClkSource source) {
+    source_ = CLK_SOURCE_OS;
+    ticks_per_sec_ = OSTicksPerSec();
+    if (source == CLK_SOURCE_TSC) {
+      const uint64_t tsc_ticks_per_sec = TSCTicksPerSec();
+      if (tsc_ticks_per_sec != 0) {
+        source_ = CLK_SOURCE_TSC;
+        ticks_per_sec_ = tsc_ticks_per_sec;
+      }
+    }
+    secs_per_tick_ = 1.0 / static_cast<double>(ticks_per_sec_);
+    start_ticks_ = getTicks();
+  }
+
+#if defined(__APPLE_CC__)
+  mach_timebase_info_data_t Clk::MachTimebase() {
+    mach_timebase_info_data_t timebase;
+    (void) mach_timebase_info(&timebase);
+    return timebase;
+  }
+#endif
+
+  uint64_t Clk::OSTicksPerSec() {
+#if defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
+    static const uint64_t ticks_per_sec = QPCFrequency();
+    return ticks_per_sec;
+#else
+    return 1000000000ull;  // OSTicks() are already in ns
+#endif
+  }
+
+#if defined( __WIN32__ ) || defined( _WIN32 ) || defined( WIN32 )
+  uint64_t Clk::QPCFrequency() {
+    __int64 freq;
+    QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&freq));
+    return static_cast<uint64_t>(freq);
+  }
+#endif
+
+  uint64_t Clk::TSCTicksPerSec() {
+    // C++11 guarantees this is initialized once, even with many threads
+    static const uint64_t ticks_per_sec = CalibrateTSC();
+    return ticks_per_sec;
+  }
+
+  uint64_t Clk::CalibrateTSC() {
+#if defined(CLK_HAS_TSC)
+    // The TSC only ticks at a constant rate (independent of frequency
+    // scaling and sleep states) if CPUID.80000007H:EDX[8] is set
+    unsigned int regs[4] = {0, 0, 0, 0};
+#if defined(__GNUC__)
+    if (__get_cpuid_max(0x80000000, NULL) < 0x80000007) {
+      return 0;
+    }
+    __get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+#else
+    int max_regs[4];
+    __cpuid(max_regs, 0x80000000);
+    if (static_cast<unsigned int>(max_regs[0]) < 0x80000007) {
+      return 0;
+    }
+    __cpuid(reinterpret_cast<int*>(regs), 0x80000007);
+#endif
+    if ((regs[3] & (1 << 8)) == 0) {
+      return 0;
+    }
+
+    // Count TSC ticks over a busy wait of CLK_TSC_CALIBRATION_MS on the OS
+    // clock
+    const uint64_t os_ticks_per_sec = OSTicksPerSec();
+    const uint64_t os_wait = os_ticks_per_sec * CLK_TSC_CALIBRATION_MS / 1000;
+    const uint64_t os0 = OSTicks();
+    const uint64_t tsc0 = __rdtsc();
+    uint64_t os1;
+    do {
+      os1 = OSTicks();
+    } while (os1 - os0 < os_wait);
+    const uint64_t tsc1 = __rdtsc();
+    if (tsc1 <= tsc0) {
+      return 0;
+    }
+    const double ticks_per_sec = static_cast<double>(tsc1 - tsc0) *
+      static_cast<double>(os_ticks_per_sec) / static_cast<double>(os1 - os0);
+    return static_cast<uint64_t>(ticks_per_sec + 0.5);
+#else
+    return 0;
+#endif
+  }
+
+};  // namespace clk
+};  // namespace jtil
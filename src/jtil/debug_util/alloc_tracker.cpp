@@ -0,0 +1,626 @@
+#if defined(__linux__)
+  #include <malloc.h>  // malloc_usable_size
+  #include <execinfo.h>  // backtrace
+  #include <signal.h>  // raise
+  #include <stdlib.h>
+  #include <string.h>  // strcmp
+#endif
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <algorithm>
+#include "jtil/debug_util/alloc_tracker.h"
+
+namespace jtil {
+namespace debug {
+
+  AllocStats::AllocStats() {
+    clear();
+  }
+
+  void AllocStats::clear() {
+    num_allocs = 0;
+    num_frees = 0;
+    bytes_allocated = 0;
+    bytes_freed = 0;
+    peak_bytes = 0;
+  }
+
+#if defined(__linux__) && defined(JTIL_ALLOC_TRACKER)
+
+  // Everything below is used from inside malloc / operator new, so it must
+  // not allocate (the globals are constant-initialized PODs and atomics, so
+  // they are also safe to use before static constructors run).
+
+  // Per thread state (POD, for __thread)
+  struct AllocThreadState {
+    int in_hook;  // Set while the tracker itself runs (no recursion)
+    uint64_t num_allocs;
+    uint64_t num_frees;
+    uint64_t bytes_allocated;
+    uint64_t bytes_freed;
+    int num_scopes;
+    int64_t scope_peak[ALLOC_TRACKER_MAX_SCOPE_DEPTH];  // Of the net bytes
+  };
+
+  struct AllocCallSite {
+    void* frames[ALLOC_TRACKER_STACK_DEPTH];
+    int num_frames;  // 0 if the slot is empty
+    uint64_t num_allocs;
+    uint64_t bytes;
+  };
+
+  struct AllocTagTotals {
+    const char* tag;
+    uint64_t num_scopes;
+    uint64_t num_allocs;
+    uint64_t num_frees;
+    uint64_t bytes_allocated;
+    uint64_t bytes_freed;
+    int64_t peak_bytes;  // Max over the scopes
+  };
+
+  static __thread AllocThreadState thread_state_;
+  static std::atomic<bool> enabled_(false);
+  static std::atomic<bool> call_sites_enabled_(false);
+  static std::atomic<uint64_t> num_allocs_(0);
+  static std::atomic<uint64_t> num_frees_(0);
+  static std::atomic<uint64_t> bytes_allocated_(0);
+  static std::atomic<uint64_t> bytes_freed_(0);
+  static std::atomic<int64_t> live_bytes_(0);
+  static std::atomic<int64_t> peak_bytes_(0);
+  static std::atomic<uint64_t> break_alloc_(0);
+  static std::atomic<uint64_t> num_untagged_(0);  // Live table was full
+
+  // The blocks allocated while enabled and not freed yet.  Only their frees
+  // are counted, so a block allocated before enable() and freed after it
+  // can't cancel out one that leaked.  Open addressing with linear probing,
+  // split in shards (each with its own lock) to cut the contention.
+  #define ALLOC_TRACKER_LIVE_SHARD_BITS 4
+  #define ALLOC_TRACKER_LIVE_SHARDS (1 << ALLOC_TRACKER_LIVE_SHARD_BITS)
+  #define ALLOC_TRACKER_LIVE_SHARD_SIZE \
+    (ALLOC_TRACKER_MAX_LIVE >> ALLOC_TRACKER_LIVE_SHARD_BITS)
+  static std::mutex live_locks_[ALLOC_TRACKER_LIVE_SHARDS];
+  static void* live_slots_[ALLOC_TRACKER_LIVE_SHARDS]
+    [ALLOC_TRACKER_LIVE_SHARD_SIZE];
+  static uint32_t live_num_[ALLOC_TRACKER_LIVE_SHARDS];  // Protected by lock
+  static std::atomic<uint64_t> num_live_blocks_(0);  // Over every shard
+
+  static std::mutex call_sites_lock_;
+  static AllocCallSite call_sites_[ALLOC_TRACKER_MAX_CALL_SITES];
+  static int num_call_sites_ = 0;  // Protected by call_sites_lock_
+  static AllocCallSite other_call_sites_;  // Once the table is full
+
+  static std::mutex tags_lock_;
+  static AllocTagTotals tags_[ALLOC_TRACKER_MAX_TAGS];
+  static int num_tags_ = 0;  // Protected by tags_lock_
+
+  // Frames of the tracker to skip: RecordCallSite, RecordAlloc and the
+  // operator new / malloc that called it
+  #define ALLOC_TRACKER_SKIP_FRAMES 3
+
+  static __attribute__((noinline)) void RecordCallSite(const uint64_t size) {
+    void* frames[ALLOC_TRACKER_STACK_DEPTH + ALLOC_TRACKER_SKIP_FRAMES];
+    const int num = backtrace(frames,
+      ALLOC_TRACKER_STACK_DEPTH + ALLOC_TRACKER_SKIP_FRAMES) -
+      ALLOC_TRACKER_SKIP_FRAMES;
+    if (num <= 0) {
+      return;
+    }
+    void** site = frames + ALLOC_TRACKER_SKIP_FRAMES;
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < num; i++) {
+      hash = (hash ^ reinterpret_cast<uint64_t>(site[i])) * 1099511628211ull;
+    }
+    std::lock_guard<std::mutex> lock(call_sites_lock_);
+    uint32_t index = static_cast<uint32_t>(hash ^ (hash >> 32)) %
+      ALLOC_TRACKER_MAX_CALL_SITES;
+    for (int probe = 0; probe < ALLOC_TRACKER_MAX_CALL_SITES; probe++) {
+      AllocCallSite& cur = call_sites_[index];
+      if (cur.num_frames == 0) {
+        if (num_call_sites_ >= ALLOC_TRACKER_MAX_CALL_SITES * 3 / 4) {
+          break;
+        }
+        num_call_sites_++;
+        cur.num_frames = num;
+        std::copy(site, site + num, cur.frames);
+      }
+      if (cur.num_frames == num && std::equal(site, site + num, cur.frames)) {
+        cur.num_allocs++;
+        cur.bytes += size;
+        return;
+      }
+      index = (index + 1) % ALLOC_TRACKER_MAX_CALL_SITES;
+    }
+    other_call_sites_.num_allocs++;
+    other_call_sites_.bytes += size;
+  }
+
+  static uint32_t LiveSlot(const void* ptr, uint32_t* shard) {
+    const uint64_t hash = (reinterpret_cast<uint64_t>(ptr) >> 4) *
+      11400714819323198485ull;
+    *shard = static_cast<uint32_t>(hash >> (64 -
+      ALLOC_TRACKER_LIVE_SHARD_BITS));
+    return static_cast<uint32_t>(hash >> 16) &
+      (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1);
+  }
+
+  // TagBlock() - false if the table is full
+  static bool TagBlock(void* ptr) {
+    uint32_t shard;
+    uint32_t i = LiveSlot(ptr, &shard);
+    std::lock_guard<std::mutex> lock(live_locks_[shard]);
+    if (live_num_[shard] >= ALLOC_TRACKER_LIVE_SHARD_SIZE * 3 / 4) {
+      return false;
+    }
+    void** slots = live_slots_[shard];
+    while (slots[i] != NULL && slots[i] != ptr) {
+      i = (i + 1) & (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1);
+    }
+    if (slots[i] == NULL) {
+      slots[i] = ptr;
+      live_num_[shard]++;
+      num_live_blocks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // UntagBlock() - false if ptr wasn't tagged
+  static bool UntagBlock(void* ptr) {
+    if (num_live_blocks_.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
+    uint32_t shard;
+    uint32_t i = LiveSlot(ptr, &shard);
+    std::lock_guard<std::mutex> lock(live_locks_[shard]);
+    void** slots = live_slots_[shard];
+    while (slots[i] != ptr) {
+      if (slots[i] == NULL) {
+        return false;
+      }
+      i = (i + 1) & (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1);
+    }
+    // Shift the following entries back into the hole when their probe
+    // sequence passes through it (no tombstones)
+    uint32_t hole = i;
+    uint32_t j = i;
+    while (true) {
+      j = (j + 1) & (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1);
+      if (slots[j] == NULL) {
+        break;
+      }
+      uint32_t home_shard;
+      const uint32_t home = LiveSlot(slots[j], &home_shard);
+      if (((j - home) & (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1)) >=
+        ((j - hole) & (ALLOC_TRACKER_LIVE_SHARD_SIZE - 1))) {
+        slots[hole] = slots[j];
+        hole = j;
+      }
+    }
+    slots[hole] = NULL;
+    live_num_[shard]--;
+    num_live_blocks_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  static __attribute__((noinline)) void RecordAlloc(void* ptr) {
+    if (ptr == NULL || !enabled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    AllocThreadState& ts = thread_state_;
+    if (ts.in_hook > 0) {
+      return;
+    }
+    ts.in_hook++;
+    if (!TagBlock(ptr)) {
+      num_untagged_.fetch_add(1, std::memory_order_relaxed);
+      ts.in_hook--;
+      return;
+    }
+    const uint64_t size = malloc_usable_size(ptr);
+    const uint64_t alloc_num =
+      num_allocs_.fetch_add(1, std::memory_order_relaxed) + 1;
+    bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+    const int64_t live = live_bytes_.fetch_add(static_cast<int64_t>(size),
+      std::memory_order_relaxed) + static_cast<int64_t>(size);
+    int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes_.compare_exchange_weak(peak, live,
+      std::memory_order_relaxed)) {
+    }
+    ts.num_allocs++;
+    ts.bytes_allocated += size;
+    const int64_t net = static_cast<int64_t>(ts.bytes_allocated) -
+      static_cast<int64_t>(ts.bytes_freed);
+    for (int i = 0; i < ts.num_scopes; i++) {
+      ts.scope_peak[i] = std::max(ts.scope_peak[i], net);
+    }
+    if (alloc_num == break_alloc_.load(std::memory_order_relaxed)) {
+      raise(SIGTRAP);
+    }
+    if (call_sites_enabled_.load(std::memory_order_relaxed)) {
+      RecordCallSite(size);
+    }
+    ts.in_hook--;
+  }
+
+  // RecordFreeSize() - For a block UntagBlock() found
+  static void RecordFreeSize(const uint64_t size) {
+    AllocThreadState& ts = thread_state_;
+    num_frees_.fetch_add(1, std::memory_order_relaxed);
+    bytes_freed_.fetch_add(size, std::memory_order_relaxed);
+    live_bytes_.fetch_sub(static_cast<int64_t>(size),
+      std::memory_order_relaxed);
+    ts.num_frees++;
+    ts.bytes_freed += size;
+  }
+
+  // RecordFree() - Also after disable(), for the blocks allocated before it
+  static void RecordFree(void* ptr) {
+    if (ptr != NULL && UntagBlock(ptr)) {
+      RecordFreeSize(malloc_usable_size(ptr));
+    }
+  }
+
+  static void GetThreadStats(AllocStats* stats) {
+    const AllocThreadState& ts = thread_state_;
+    stats->num_allocs = ts.num_allocs;
+    stats->num_frees = ts.num_frees;
+    stats->bytes_allocated = ts.bytes_allocated;
+    stats->bytes_freed = ts.bytes_freed;
+    stats->peak_bytes = 0;
+  }
+
+  void AllocTracker::enable(const bool call_sites) {
+    if (call_sites) {
+      // The first backtrace() loads libgcc, which allocates
+      void* frames[1];
+      backtrace(frames, 1);
+    }
+    call_sites_enabled_.store(call_sites);
+    enabled_.store(true);
+  }
+
+  void AllocTracker::disable() {
+    enabled_.store(false);
+    call_sites_enabled_.store(false);
+  }
+
+  bool AllocTracker::enabled() {
+    return enabled_.load();
+  }
+
+  bool AllocTracker::supported() {
+    return true;
+  }
+
+  void AllocTracker::getStats(AllocStats* stats) {
+    stats->num_allocs = num_allocs_.load();
+    stats->num_frees = num_frees_.load();
+    stats->bytes_allocated = bytes_allocated_.load();
+    stats->bytes_freed = bytes_freed_.load();
+    stats->peak_bytes = peak_bytes_.load();
+  }
+
+  int64_t AllocTracker::liveAllocations() {
+    return static_cast<int64_t>(num_allocs_.load()) -
+      static_cast<int64_t>(num_frees_.load());
+  }
+
+  void AllocTracker::breakOnAllocation(const uint64_t alloc_num) {
+    break_alloc_.store(alloc_num);
+  }
+
+  void AllocTracker::clear() {
+    {
+      std::lock_guard<std::mutex> lock(call_sites_lock_);
+      for (int i = 0; i < ALLOC_TRACKER_MAX_CALL_SITES; i++) {
+        call_sites_[i].num_frames = 0;
+        call_sites_[i].num_allocs = 0;
+        call_sites_[i].bytes = 0;
+      }
+      num_call_sites_ = 0;
+      other_call_sites_.num_allocs = 0;
+      other_call_sites_.bytes = 0;
+    }
+    std::lock_guard<std::mutex> lock(tags_lock_);
+    num_tags_ = 0;
+  }
+
+  static bool CallSiteMoreBytes(const AllocCallSite* a,
+    const AllocCallSite* b) {
+    return a->bytes > b->bytes;
+  }
+
+  void AllocTracker::printReport(std::ostream& out, const int max_call_sites) {
+    // Don't count the report itself
+    AllocThreadState& ts = thread_state_;
+    ts.in_hook++;
+    AllocStats stats;
+    getStats(&stats);
+    out << "Allocations: " << stats.num_allocs << " (" <<
+      stats.bytes_allocated << " bytes), frees: " << stats.num_frees << " (" <<
+      stats.bytes_freed << " bytes), peak: " << stats.peak_bytes <<
+      " bytes" << std::endl;
+    const uint64_t num_untagged = num_untagged_.load();
+    if (num_untagged > 0) {
+      out << "  (live table full) " << num_untagged <<
+        " allocs not counted" << std::endl;
+    }
+    {
+      std::lock_guard<std::mutex> lock(tags_lock_);
+      for (int i = 0; i < num_tags_; i++) {
+        const AllocTagTotals& t = tags_[i];
+        out << "  " << t.tag << ": " << t.num_scopes << " scopes, " <<
+          t.num_allocs << " allocs (" << t.bytes_allocated << " bytes), " <<
+          t.num_frees << " frees (" << t.bytes_freed << " bytes), peak " <<
+          t.peak_bytes << " bytes" << std::endl;
+      }
+    }
+    if (max_call_sites > 0 && num_call_sites_ > 0) {
+      std::lock_guard<std::mutex> lock(call_sites_lock_);
+      const AllocCallSite** sorted = new const AllocCallSite*[num_call_sites_];
+      int num_sorted = 0;
+      for (int i = 0; i < ALLOC_TRACKER_MAX_CALL_SITES; i++) {
+        if (call_sites_[i].num_frames > 0) {
+          sorted[num_sorted++] = &call_sites_[i];
+        }
+      }
+      std::sort(sorted, sorted + num_sorted, CallSiteMoreBytes);
+      out << "Top call sites by bytes:" << std::endl;
+      for (int i = 0; i < num_sorted && i < max_call_sites; i++) {
+        const AllocCallSite& site = *sorted[i];
+        out << "  " << site.num_allocs << " allocs (" << site.bytes <<
+          " bytes)" << std::endl;
+        char** symbols = backtrace_symbols(site.frames, site.num_frames);
+        for (int j = 0; j < site.num_frames; j++) {
+          out << "    ";
+          if (symbols != NULL) {
+            out << symbols[j];
+          } else {
+            out << site.frames[j];
+          }
+          out << std::endl;
+        }
+        free(symbols);
+      }
+      if (other_call_sites_.num_allocs > 0) {
+        out << "  (table full) " << other_call_sites_.num_allocs <<
+          " allocs (" << other_call_sites_.bytes << " bytes)" << std::endl;
+      }
+      delete[] sorted;
+    }
+    ts.in_hook--;
+  }
+
+  AllocScope::AllocScope(const char* tag) : tag_(tag) {
+    GetThreadStats(&start_);
+    AllocThreadState& ts = thread_state_;
+    if (ts.num_scopes < ALLOC_TRACKER_MAX_SCOPE_DEPTH) {
+      depth_ = ts.num_scopes++;
+      ts.scope_peak[depth_] = static_cast<int64_t>(start_.bytes_allocated) -
+        static_cast<int64_t>(start_.bytes_freed);
+    } else {
+      depth_ = -1;
+    }
+  }
+
+  AllocScope::~AllocScope() {
+    const AllocStats cur = stats();
+    if (depth_ >= 0) {
+      thread_state_.num_scopes = depth_;
+    }
+    std::lock_guard<std::mutex> lock(tags_lock_);
+    int i = 0;
+    while (i < num_tags_ && strcmp(tags_[i].tag, tag_) != 0) {
+      i++;
+    }
+    if (i == num_tags_) {
+      if (num_tags_ == ALLOC_TRACKER_MAX_TAGS) {
+        return;
+      }
+      AllocTagTotals& t = tags_[num_tags_++];
+      t.tag = tag_;
+      t.num_scopes = t.num_allocs = t.num_frees = 0;
+      t.bytes_allocated = t.bytes_freed = 0;
+      t.peak_bytes = 0;
+    }
+    AllocTagTotals& t = tags_[i];
+    t.num_scopes++;
+    t.num_allocs += cur.num_allocs;
+    t.num_frees += cur.num_frees;
+    t.bytes_allocated += cur.bytes_allocated;
+    t.bytes_freed += cur.bytes_freed;
+    t.peak_bytes = std::max(t.peak_bytes, cur.peak_bytes);
+  }
+
+  AllocStats AllocScope::stats() const {
+    AllocStats cur;
+    GetThreadStats(&cur);
+    cur.num_allocs -= start_.num_allocs;
+    cur.num_frees -= start_.num_frees;
+    cur.bytes_allocated -= start_.bytes_allocated;
+    cur.bytes_freed -= start_.bytes_freed;
+    if (depth_ >= 0) {
+      cur.peak_bytes = thread_state_.scope_peak[depth_] -
+        (static_cast<int64_t>(start_.bytes_allocated) -
+        static_cast<int64_t>(start_.bytes_freed));
+    }
+    return cur;
+  }
+
+#else  // __linux__ && JTIL_ALLOC_TRACKER
+
+  void AllocTracker::enable(const bool call_sites) {
+    static_cast<void>(call_sites);
+  }
+  void AllocTracker::disable() { }
+  bool AllocTracker::enabled() { return false; }
+  bool AllocTracker::supported() { return false; }
+  void AllocTracker::getStats(AllocStats* stats) { stats->clear(); }
+  int64_t AllocTracker::liveAllocations() { return 0; }
+  void AllocTracker::breakOnAllocation(const uint64_t alloc_num) {
+    static_cast<void>(alloc_num);
+  }
+  void AllocTracker::clear() { }
+  void AllocTracker::printReport(std::ostream& out,
+    const int max_call_sites) {
+    static_cast<void>(max_call_sites);
+    out << "Allocations: not tracked in this build" << std::endl;
+  }
+
+  AllocScope::AllocScope(const char* tag) : tag_(tag), depth_(-1) { }
+  AllocScope::~AllocScope() { }
+  AllocStats AllocScope::stats() const { return AllocStats(); }
+
+#endif  // __linux__ && JTIL_ALLOC_TRACKER
+
+};  // namespace debug
+};  // namespace jtil
+
+#if defined(__linux__) && defined(JTIL_ALLOC_TRACKER)
+
+// The replacement operator new / delete (and malloc / free with
+// JTIL_TRACK_MALLOC).  Keep them out of the jtil namespace.
+
+using jtil::debug::RecordAlloc;
+using jtil::debug::RecordFree;
+using jtil::debug::RecordFreeSize;
+using jtil::debug::TagBlock;
+using jtil::debug::UntagBlock;
+
+#if defined(JTIL_TRACK_MALLOC)
+  #define ALLOC_TRACKER_NEW_RECORD(ptr)  // malloc records it
+  #define ALLOC_TRACKER_DELETE_RECORD(ptr)
+#else
+  #define ALLOC_TRACKER_NEW_RECORD(ptr) RecordAlloc(ptr)
+  #define ALLOC_TRACKER_DELETE_RECORD(ptr) RecordFree(ptr)
+#endif
+
+__attribute__((noinline)) void* operator new(size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  void* ptr;
+  while ((ptr = malloc(size)) == NULL) {
+    std::new_handler handler = std::set_new_handler(NULL);
+    std::set_new_handler(handler);
+    if (handler == NULL) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+  ALLOC_TRACKER_NEW_RECORD(ptr);
+  return ptr;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+__attribute__((noinline)) void* operator new(size_t size,
+  const std::nothrow_t&) noexcept {
+  try {
+    return operator new(size);
+  } catch (...) {
+    return NULL;
+  }
+}
+
+__attribute__((noinline)) void* operator new[](size_t size,
+  const std::nothrow_t&) noexcept {
+  try {
+    return operator new(size);
+  } catch (...) {
+    return NULL;
+  }
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+  ALLOC_TRACKER_DELETE_RECORD(ptr);
+  free(ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void* ptr) noexcept {
+  operator delete(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr,
+  const std::nothrow_t&) noexcept {
+  operator delete(ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void* ptr,
+  const std::nothrow_t&) noexcept {
+  operator delete(ptr);
+}
+
+#if defined(JTIL_TRACK_MALLOC)
+// glibc's own entry points, which the replacements forward to
+extern "C" {
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t num, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void* __libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void* ptr);
+
+  __attribute__((noinline)) void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    RecordAlloc(ptr);
+    return ptr;
+  }
+
+  __attribute__((noinline)) void* calloc(size_t num, size_t size) {
+    void* ptr = __libc_calloc(num, size);
+    RecordAlloc(ptr);
+    return ptr;
+  }
+
+  __attribute__((noinline)) void* realloc(void* ptr, size_t size) {
+    if (ptr == NULL) {
+      return malloc(size);
+    }
+    // ptr can't be read once realloc succeeds
+    const bool tagged = UntagBlock(ptr);
+    const uint64_t old_size = tagged ? malloc_usable_size(ptr) : 0;
+    void* new_ptr = __libc_realloc(ptr, size);
+    if (new_ptr == NULL && size > 0) {
+      if (tagged) {
+        TagBlock(ptr);  // Still ours
+      }
+      return NULL;
+    }
+    if (tagged) {
+      RecordFreeSize(old_size);
+    }
+    RecordAlloc(new_ptr);
+    return new_ptr;
+  }
+
+  __attribute__((noinline)) void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    RecordAlloc(ptr);
+    return ptr;
+  }
+
+  __attribute__((noinline)) void* aligned_alloc(size_t alignment,
+    size_t size) {
+    return memalign(alignment, size);
+  }
+
+  int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 ||
+      (alignment & (alignment - 1)) != 0) {
+      return 22;  // EINVAL
+    }
+    *ptr = memalign(alignment, size);
+    return *ptr == NULL && size > 0 ? 12 : 0;  // ENOMEM
+  }
+
+  void free(void* ptr) {
+    RecordFree(ptr);
+    __libc_free(ptr);
+  }
+}
+#endif  // JTIL_TRACK_MALLOC
+
+#endif  // __linux__ && JTIL_ALLOC_TRACKER
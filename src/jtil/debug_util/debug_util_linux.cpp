@@ -0,0 +1,43 @@
+#if defined(__linux__)
+
+#include <stdlib.h>  // atexit
+#include <iostream>
+#include "jtil/debug_util/alloc_tracker.h"
+#include "jtil/debug_util/debug_util.h"
+
+namespace jtil {
+namespace debug {
+
+  // Only the allocations made after EnableMemoryLeakChecks() are seen, so
+  // the report at exit lists what is still live rather than a true leak list
+  static void ReportLiveAllocations() {
+    const int64_t num_live = AllocTracker::liveAllocations();
+    if (num_live > 0) {
+      std::cerr << "WARNING: " << num_live << " allocation(s) still live at "
+        << "exit" << std::endl;
+      AllocTracker::printReport(std::cerr);
+    }
+  }
+
+  void EnableMemoryLeakChecks() {
+    if (!AllocTracker::enabled()) {
+      atexit(ReportLiveAllocations);
+    }
+    AllocTracker::enable();
+  }
+
+  void EnableAggressiveMemoryLeakChecks() {
+    if (!AllocTracker::enabled()) {
+      atexit(ReportLiveAllocations);
+    }
+    AllocTracker::enable(true);  // Also report the call sites
+  }
+
+  void SetBreakPointOnAlocation(int alloc_num) {
+    AllocTracker::breakOnAllocation(static_cast<uint64_t>(alloc_num));
+  }
+
+}  // namespace debug
+}  // namespace jtil
+
+#endif  // __linux__
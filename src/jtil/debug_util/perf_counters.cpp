@@ -0,0 +1,157 @@
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <string.h>  // memset
+#endif
+#include "jtil/debug_util/perf_counters.h"
+
+namespace jtil {
+namespace debug {
+
+  static const char* perf_counter_names_[PERF_NUM_COUNTERS] = {
+    "cycles",
+    "instructions",
+    "llc_misses",
+    "branch_misses",
+    "task_clock_ns",
+  };
+
+  PerfCounterValues::PerfCounterValues() {
+    clear();
+  }
+
+  void PerfCounterValues::clear() {
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+      counts[i] = 0;
+      valid[i] = false;
+    }
+  }
+
+  double PerfCounterValues::ipc() const {
+    if (!valid[PERF_CYCLES] || !valid[PERF_INSTRUCTIONS] ||
+      counts[PERF_CYCLES] == 0) {
+      return 0;
+    }
+    return static_cast<double>(counts[PERF_INSTRUCTIONS]) /
+      static_cast<double>(counts[PERF_CYCLES]);
+  }
+
+#if defined(__linux__)
+  static int OpenCounter(const PerfCounter counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    switch (counter) {
+    case PERF_CYCLES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case PERF_INSTRUCTIONS:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case PERF_LLC_MISSES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case PERF_BRANCH_MISSES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    default:
+      attr.type = PERF_TYPE_SOFTWARE;
+      attr.config = PERF_COUNT_SW_TASK_CLOCK;
+      break;
+    }
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+      PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Allowed at the default perf_event_paranoid level
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1,
+      0));
+  }
+#endif
+
+  PerfCounters::PerfCounters() {
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+#if defined(__linux__)
+      fds_[i] = OpenCounter(static_cast<PerfCounter>(i));
+#else
+      fds_[i] = -1;
+#endif
+    }
+  }
+
+  PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+      if (fds_[i] >= 0) {
+        close(fds_[i]);
+      }
+    }
+#endif
+  }
+
+  void PerfCounters::read(PerfCounterValues* values) const {
+    values->clear();
+#if defined(__linux__)
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+      uint64_t buf[3];  // value, time enabled, time running
+      if (fds_[i] < 0 || ::read(fds_[i], buf, sizeof(buf)) !=
+        static_cast<ssize_t>(sizeof(buf))) {
+        continue;
+      }
+      if (buf[2] == 0) {
+        // Never scheduled on the PMU (ie, too many counters in use)
+        continue;
+      }
+      values->counts[i] = buf[0];
+      if (buf[2] < buf[1]) {
+        values->counts[i] = static_cast<uint64_t>(static_cast<double>(buf[0])
+          * static_cast<double>(buf[1]) / static_cast<double>(buf[2]));
+      }
+      values->valid[i] = true;
+    }
+#endif
+  }
+
+  bool PerfCounters::available(const PerfCounter counter) const {
+    return fds_[counter] >= 0;
+  }
+
+  bool PerfCounters::anyAvailable() const {
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+      if (fds_[i] >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const char* PerfCounters::name(const PerfCounter counter) {
+    return perf_counter_names_[counter];
+  }
+
+  PerfScope::PerfScope(const PerfCounters* counters,
+    PerfCounterValues* total) : counters_(counters), total_(total) {
+    counters_->read(&start_);
+  }
+
+  PerfScope::~PerfScope() {
+    PerfCounterValues end;
+    counters_->read(&end);
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+      // Scaled counts of a multiplexed counter can step back a little
+      if (start_.valid[i] && end.valid[i] &&
+        end.counts[i] >= start_.counts[i]) {
+        total_->counts[i] += end.counts[i] - start_.counts[i];
+        total_->valid[i] = true;
+      }
+    }
+  }
+
+};  // namespace debug
+};  // namespace jtil
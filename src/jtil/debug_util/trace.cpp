@@ -0,0 +1,259 @@
+#include <string.h>  // strncpy
+#include <algorithm>  // std::min
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include "jtil/debug_util/trace.h"
+#include "jtil/clk/clk.h"
+#include "jtil/data_str/vector.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+#if defined(WIN32) || defined(_WIN32)
+  #define THREAD_LOCAL __declspec(thread)
+#else
+  #define THREAD_LOCAL __thread
+#endif
+
+#define TRACE_THREAD_NAME_SIZE 32
+
+namespace jtil {
+namespace debug {
+
+  using clk::Clk;
+
+  // The fields are atomics (relaxed, so plain loads and stores on x86) so
+  // that writeChromeJSON() can copy a buffer while its thread writes to it
+  struct TraceEvent {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> ticks_type;  // ticks << 1 | TraceEventType
+  };
+
+  // Single writer (its thread), any number of readers
+  struct TraceBuffer {
+    TraceEvent events[TRACE_BUFFER_SIZE];
+    std::atomic<uint64_t> head;  // Events written so far
+    int tid;
+    std::string name;  // Protected by registry_lock_
+  };
+
+  std::atomic<bool> Trace::recording_(false);
+
+  static std::atomic<uint64_t> start_ticks_(0);
+  static std::atomic<uint64_t> stop_ticks_(0);  // 0 while recording
+  static std::mutex registry_lock_;
+  // Frees the buffers when the process exits (after every thread that
+  // traced has finished)
+  class TraceBuffers : public data_str::Vector<TraceBuffer*> {
+  public:
+    ~TraceBuffers() {
+      for (uint32_t i = 0; i < size(); i++) {
+        delete (*this)[i];
+      }
+    }
+  };
+  static TraceBuffers buffers_;  // Protected by registry_lock_
+  // The buffers of the threads that have exited, for the next threads that
+  // trace to reuse (so retired pool threads don't each keep one)
+  static data_str::Vector<TraceBuffer*> free_buffers_;  // registry_lock_
+  static THREAD_LOCAL TraceBuffer* cur_buffer_ = NULL;
+  static THREAD_LOCAL bool cur_thread_exited_ = false;
+  static THREAD_LOCAL char cur_thread_name_[TRACE_THREAD_NAME_SIZE] = "";
+
+  // Hands the thread's buffer back when the thread exits
+  class TraceThreadExit {
+  public:
+    TraceThreadExit() : buffer(NULL) { }
+    ~TraceThreadExit() {
+      cur_thread_exited_ = true;  // No new buffer from later destructors
+      cur_buffer_ = NULL;
+      if (buffer != NULL) {
+        std::lock_guard<std::mutex> lock(registry_lock_);
+        free_buffers_.pushBack(buffer);
+      }
+    }
+    TraceBuffer* buffer;
+  };
+  static thread_local TraceThreadExit thread_exit_;
+
+  static TraceBuffer* RegisterThread() {
+    std::lock_guard<std::mutex> lock(registry_lock_);
+    TraceBuffer* buffer;
+    if (free_buffers_.size() > 0) {
+      // The old thread's events stay (under this thread's tid) until they
+      // are overwritten
+      free_buffers_.popBack(buffer);
+    } else {
+      buffer = new TraceBuffer();
+      buffer->head.store(0);
+      buffer->tid = static_cast<int>(buffers_.size()) + 1;
+      buffers_.pushBack(buffer);
+    }
+    buffer->name = cur_thread_name_;
+    cur_buffer_ = buffer;
+    thread_exit_.buffer = buffer;
+    return buffer;
+  }
+
+  static inline void Record(const char* name, const TraceEventType type) {
+    TraceBuffer* buffer = cur_buffer_;
+    if (buffer == NULL) {
+      if (cur_thread_exited_) {
+        return;
+      }
+      buffer = RegisterThread();
+    }
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[head & (TRACE_BUFFER_SIZE - 1)];
+    // A reader that sees any of the stores below also sees head >= 'head'
+    // (see CopyEvents())
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.ticks_type.store((Clk::OSTicks() << 1) | type,
+      std::memory_order_relaxed);
+    buffer->head.store(head + 1, std::memory_order_release);
+  }
+
+  void Trace::begin(const char* name) {
+    Record(name, TRACE_BEGIN);
+  }
+
+  void Trace::end(const char* name) {
+    Record(name, TRACE_END);
+  }
+
+  void Trace::start() {
+    stop_ticks_.store(0);
+    start_ticks_.store(Clk::OSTicks());
+    recording_.store(true);
+  }
+
+  void Trace::stop() {
+    recording_.store(false);
+    stop_ticks_.store(Clk::OSTicks());
+  }
+
+  void Trace::setThreadName(const char* name) {
+    strncpy(cur_thread_name_, name, TRACE_THREAD_NAME_SIZE - 1);
+    cur_thread_name_[TRACE_THREAD_NAME_SIZE - 1] = '\0';
+    if (cur_buffer_ != NULL) {
+      std::lock_guard<std::mutex> lock(registry_lock_);
+      cur_buffer_->name = cur_thread_name_;
+    }
+  }
+
+  // Copies the events still in the buffer to 'names' and 'ticks_types' (of
+  // TRACE_BUFFER_SIZE) and returns how many, oldest first.  Events the
+  // writer overwrote during the copy are dropped.
+  static uint64_t CopyEvents(const TraceBuffer* buffer, const char** names,
+    uint64_t* ticks_types) {
+    const uint64_t head = buffer->head.load(std::memory_order_acquire);
+    const uint64_t first = head > TRACE_BUFFER_SIZE ?
+      head - TRACE_BUFFER_SIZE : 0;
+    for (uint64_t i = first; i < head; i++) {
+      const TraceEvent& event = buffer->events[i & (TRACE_BUFFER_SIZE - 1)];
+      names[i - first] = event.name.load(std::memory_order_relaxed);
+      ticks_types[i - first] =
+        event.ticks_type.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The writer may be part way through event 'new_head', which overwrites
+    // event new_head - TRACE_BUFFER_SIZE
+    const uint64_t new_head = buffer->head.load(std::memory_order_relaxed);
+    const uint64_t first_valid = new_head + 1 > TRACE_BUFFER_SIZE ?
+      new_head + 1 - TRACE_BUFFER_SIZE : 0;
+    if (first_valid <= first) {
+      return head - first;
+    }
+    const uint64_t num_dropped =
+      std::min<uint64_t>(first_valid, head) - first;
+    for (uint64_t i = num_dropped; i < head - first; i++) {
+      names[i - num_dropped] = names[i];
+      ticks_types[i - num_dropped] = ticks_types[i];
+    }
+    return head - first - num_dropped;
+  }
+
+  static void WriteJSONString(std::ostream& out, const char* str) {
+    out << '"';
+    for (const char* c = str; *c != '\0'; c++) {
+      if (*c == '"' || *c == '\\') {
+        out << '\\' << *c;
+      } else if (static_cast<unsigned char>(*c) < 0x20) {
+        out << ' ';
+      } else {
+        out << *c;
+      }
+    }
+    out << '"';
+  }
+
+  void Trace::writeChromeJSON(std::ostream& out) {
+    const uint64_t start_ticks = start_ticks_.load();
+    uint64_t stop_ticks = stop_ticks_.load();
+    if (stop_ticks == 0) {
+      stop_ticks = Clk::OSTicks();
+    }
+    const double us_per_tick = 1e6 /
+      static_cast<double>(Clk::OSTicksPerSec());
+    const char** names = new const char*[TRACE_BUFFER_SIZE];
+    uint64_t* ticks_types = new uint64_t[TRACE_BUFFER_SIZE];
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[";
+    bool first_event = true;
+    std::lock_guard<std::mutex> lock(registry_lock_);
+    for (uint32_t b = 0; b < buffers_.size(); b++) {
+      const TraceBuffer* buffer = buffers_[b];
+      if (!buffer->name.empty()) {
+        out << (first_event ? "\n" : ",\n");
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+          << buffer->tid << ",\"args\":{\"name\":";
+        WriteJSONString(out, buffer->name.c_str());
+        out << "}}";
+        first_event = false;
+      }
+      const uint64_t num_events = CopyEvents(buffer, names, ticks_types);
+      // Keep the begin events in [start, stop] and their end events (which
+      // may come after stop)
+      int depth = 0;
+      for (uint64_t i = 0; i < num_events; i++) {
+        const uint64_t ticks = ticks_types[i] >> 1;
+        const bool is_begin = (ticks_types[i] & 1) == TRACE_BEGIN;
+        if (is_begin) {
+          if (ticks < start_ticks || ticks > stop_ticks) {
+            continue;
+          }
+          depth++;
+        } else {
+          if (depth == 0) {
+            continue;  // Its begin event was dropped
+          }
+          depth--;
+        }
+        out << (first_event ? "\n" : ",\n");
+        out << "{\"name\":";
+        WriteJSONString(out, names[i]);
+        out << ",\"ph\":\"" << (is_begin ? 'B' : 'E') << "\",\"ts\":"
+          << static_cast<double>(ticks - start_ticks) * us_per_tick
+          << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+        first_event = false;
+      }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    out.flags(flags);
+    delete[] names;
+    delete[] ticks_types;
+  }
+
+  void Trace::saveChromeJSON(const std::string& filename) {
+    std::ofstream file(filename.c_str(), std::ios::out);
+    if (!file.is_open()) {
+      throw std::wruntime_error(std::string("Trace::saveChromeJSON() - "
+        "ERROR: Cannot open output file:") + filename);
+    }
+    writeChromeJSON(file);
+    file.close();
+  }
+
+};  // namespace debug
+};  // namespace jtil
@@ -0,0 +1,488 @@
+#include <string.h>  // For strerror
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "jtil/file_io/async_io.h"
+#include "jtil/threading/thread.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/task.h"
+#include "jtil/exceptions/wruntime_error.h"
+#if !defined(_WIN32)
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/stat.h>
+#endif
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <linux/io_uring.h>
+#endif
+
+namespace jtil {
+namespace file_io {
+
+  using threading::Callback;
+  using threading::MakeCallableOnce;
+  using threading::MakeTask;
+
+  AsyncIORequest::AsyncIORequest(AsyncIO* io, const std::string& filename,
+    Callback<void, AsyncIORequest*>* on_complete) : io_(io),
+    filename_(filename), on_complete_(on_complete), data_(NULL), size_(0),
+    offset_(0), fd_(-1), prefetching_(false), done_(false) {
+  }
+
+  AsyncIORequest::~AsyncIORequest() {
+    wait();
+    delete[] data_;
+  }
+
+  void AsyncIORequest::wait() {
+    std::unique_lock<std::mutex> unique_lock(io_->done_lock_);
+    while (!done_) {
+      io_->done_cv_.wait(unique_lock);
+    }
+  }
+
+  bool AsyncIORequest::done() const {
+    std::unique_lock<std::mutex> unique_lock(io_->done_lock_);
+    return done_;
+  }
+
+  uint8_t* AsyncIORequest::releaseData() {
+    uint8_t* data = data_;
+    data_ = NULL;
+    return data;
+  }
+
+#if defined(__linux__)
+  // The raw io_uring interface (liburing isn't a dependency): the submission
+  // and completion rings are shared with the kernel through mmap
+  struct AsyncIO::Uring {
+    int fd;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    io_uring_sqe* sqes;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    io_uring_cqe* cqes;
+    void* sq_ptr;
+    size_t sq_size;
+    void* cq_ptr;  // == sq_ptr if the kernel maps both rings together
+    size_t cq_size;
+    size_t sqes_size;
+    unsigned num_to_submit;
+    AsyncIORequest* in_flight[ASYNC_IO_URING_DEPTH];
+    int num_in_flight;
+  };
+
+  AsyncIO::Uring* AsyncIO::createUring() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    const int fd = static_cast<int>(syscall(__NR_io_uring_setup,
+      ASYNC_IO_URING_DEPTH, &params));
+    if (fd < 0) {
+      return NULL;
+    }
+    Uring* uring = new Uring();
+    uring->fd = fd;
+    uring->sq_size = params.sq_off.array + params.sq_entries *
+      sizeof(unsigned);
+    uring->cq_size = params.cq_off.cqes + params.cq_entries *
+      sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      uring->sq_size = std::max<size_t>(uring->sq_size, uring->cq_size);
+      uring->cq_size = uring->sq_size;
+    }
+    uring->sq_ptr = mmap(NULL, uring->sq_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    uring->cq_ptr = single_mmap ? uring->sq_ptr : mmap(NULL, uring->cq_size,
+      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+      IORING_OFF_CQ_RING);
+    uring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (uring->sq_ptr == MAP_FAILED || uring->cq_ptr == MAP_FAILED ||
+      sqes == MAP_FAILED) {
+      if (sqes != MAP_FAILED) {
+        munmap(sqes, uring->sqes_size);
+      }
+      if (uring->cq_ptr != MAP_FAILED && !single_mmap) {
+        munmap(uring->cq_ptr, uring->cq_size);
+      }
+      if (uring->sq_ptr != MAP_FAILED) {
+        munmap(uring->sq_ptr, uring->sq_size);
+      }
+      ::close(fd);
+      delete uring;
+      return NULL;
+    }
+    char* sq = static_cast<char*>(uring->sq_ptr);
+    uring->sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    uring->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    uring->sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    uring->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    uring->sqes = static_cast<io_uring_sqe*>(sqes);
+    char* cq = static_cast<char*>(uring->cq_ptr);
+    uring->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    uring->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    uring->cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    uring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    uring->num_to_submit = 0;
+    uring->num_in_flight = 0;
+    return uring;
+  }
+
+  void AsyncIO::destroyUring(Uring* uring) {
+    if (uring == NULL) {
+      return;
+    }
+    munmap(uring->sqes, uring->sqes_size);
+    if (uring->cq_ptr != uring->sq_ptr) {
+      munmap(uring->cq_ptr, uring->cq_size);
+    }
+    munmap(uring->sq_ptr, uring->sq_size);
+    ::close(uring->fd);
+    delete uring;
+  }
+#endif
+
+  AsyncIO::AsyncIO(const int num_threads, threading::ThreadPool* tp,
+    const AsyncIOBackend backend) : tp_(tp), backend_(backend),
+    num_threads_(num_threads), stop_(false), num_pending_(0) {
+    if (num_threads < 1) {
+      throw std::wruntime_error("AsyncIO::AsyncIO: num_threads < 1");
+    }
+    if (backend_ == ASYNC_IO_URING) {
+      // Fall back to pread if the kernel won't give us a ring
+#if defined(__linux__)
+      Uring* probe = createUring();
+      if (probe == NULL) {
+        backend_ = ASYNC_IO_PREAD;
+      }
+      destroyUring(probe);
+#else
+      backend_ = ASYNC_IO_PREAD;
+#endif
+    }
+    threads_ = new std::thread[num_threads_];
+    for (int i = 0; i < num_threads_; i++) {
+      threads_[i] = threading::MakeThread(MakeCallableOnce(
+        &AsyncIO::threadMain, this, i));
+    }
+  }
+
+  AsyncIO::~AsyncIO() {
+    std::unique_lock<std::mutex> queue_lock(queue_lock_);
+    stop_ = true;
+    queue_cv_.notify_all();
+    queue_lock.unlock();
+    for (int i = 0; i < num_threads_; i++) {
+      threads_[i].join();
+    }
+    delete[] threads_;
+    // Callbacks may still be running on the pool
+    std::unique_lock<std::mutex> done_lock(done_lock_);
+    while (num_pending_ > 0) {
+      done_cv_.wait(done_lock);
+    }
+  }
+
+  AsyncIORequest* AsyncIO::read(const std::string& filename,
+    Callback<void, AsyncIORequest*>* on_complete) {
+    AsyncIORequest* request = new AsyncIORequest(this, filename, on_complete);
+    std::unique_lock<std::mutex> done_lock(done_lock_);
+    num_pending_++;
+    done_lock.unlock();
+    std::unique_lock<std::mutex> queue_lock(queue_lock_);
+    queue_.enqueue(request);
+    prefetch_queue_.enqueue(request);
+    queue_cv_.notify_one();
+    return request;
+  }
+
+  AsyncIORequest* AsyncIO::dequeue(const bool block) {
+    std::unique_lock<std::mutex> unique_lock(queue_lock_);
+    while (queue_.empty()) {
+      if (stop_ || !block) {
+        return NULL;
+      }
+      queue_cv_.wait(unique_lock);
+    }
+    AsyncIORequest* request = queue_.dequeue();
+    if (!prefetch_queue_.empty() && prefetch_queue_.peak() == request) {
+      prefetch_queue_.dequeue();
+    }
+    // Another thread may still be opening it for us (see readAheadQueued)
+    while (request->prefetching_) {
+      prefetch_cv_.wait(unique_lock);
+    }
+    return request;
+  }
+
+  void AsyncIO::threadMain(int thread_index) {
+    std::stringstream ss;
+    ss << "AsyncIO-" << thread_index;
+    threading::SetThreadName(ss.str().c_str());
+#if defined(__linux__)
+    if (backend_ == ASYNC_IO_URING) {
+      Uring* uring = createUring();
+      if (uring != NULL) {
+        uringMain(uring);  // Returns early if the ring stops working
+        destroyUring(uring);
+      }
+    }
+#endif
+    AsyncIORequest* request;
+    while ((request = dequeue(true)) != NULL) {
+      readAheadQueued();
+      readPread(request);
+      finish(request);
+    }
+  }
+
+  void AsyncIO::readAheadQueued() {
+#if defined(__linux__)
+    // Open the next few queued files and let the kernel start reading them
+    // into the page cache while we read this one.  prefetch_queue_ is the
+    // tail of queue_ that hasn't been opened yet, so the window (the first
+    // ASYNC_IO_READ_AHEAD queued requests) is found in O(1).  The files are
+    // opened outside the lock: a thread that dequeues one of these requests
+    // meanwhile waits for its fd in dequeue().  The buffers are allocated
+    // by whoever reads the request.
+    AsyncIORequest* requests[ASYNC_IO_READ_AHEAD];
+    int fds[ASYNC_IO_READ_AHEAD];
+    int num_requests = 0;
+    std::unique_lock<std::mutex> unique_lock(queue_lock_);
+    while (!prefetch_queue_.empty() &&
+      queue_.size() - prefetch_queue_.size() < ASYNC_IO_READ_AHEAD) {
+      requests[num_requests] = prefetch_queue_.dequeue();
+      requests[num_requests]->prefetching_ = true;
+      num_requests++;
+    }
+    if (num_requests == 0) {
+      return;
+    }
+    unique_lock.unlock();
+    for (int i = 0; i < num_requests; i++) {
+      // filename_ never changes and the request can't finish while
+      // prefetching_ is set
+      fds[i] = ::open(requests[i]->filename_.c_str(), O_RDONLY);
+      if (fds[i] >= 0) {
+        posix_fadvise(fds[i], 0, 0, POSIX_FADV_WILLNEED);
+      }
+    }
+    unique_lock.lock();
+    for (int i = 0; i < num_requests; i++) {
+      requests[i]->fd_ = fds[i];  // If it failed open() will say why
+      requests[i]->prefetching_ = false;
+    }
+    prefetch_cv_.notify_all();
+#endif
+  }
+
+#if !defined(_WIN32)
+  bool AsyncIO::open(AsyncIORequest* request) {
+    if (request->fd_ < 0) {  // Unless readAheadQueued() opened it
+      request->fd_ = ::open(request->filename_.c_str(), O_RDONLY);
+    }
+    struct stat st;
+    if (request->fd_ < 0 || fstat(request->fd_, &st) != 0) {
+      request->error_ = std::string("AsyncIO: Cannot open file ") +
+        request->filename_ + ": " + strerror(errno);
+      close(request);
+      return false;
+    }
+    request->size_ = static_cast<uint64_t>(st.st_size);
+    request->data_ = new uint8_t[request->size_ + 1];
+    request->data_[request->size_] = 0;
+#if defined(__linux__)
+    posix_fadvise(request->fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    return true;
+  }
+
+  void AsyncIO::close(AsyncIORequest* request) {
+    if (request->fd_ >= 0) {
+      ::close(request->fd_);
+      request->fd_ = -1;
+    }
+  }
+
+  void AsyncIO::readPread(AsyncIORequest* request) {
+    if (!open(request)) {
+      return;
+    }
+    while (request->offset_ < request->size_) {
+      uint64_t num = request->size_ - request->offset_;
+      num = num < ASYNC_IO_CHUNK_SIZE ? num : ASYNC_IO_CHUNK_SIZE;
+      const ssize_t ret = pread(request->fd_,
+        request->data_ + request->offset_, static_cast<size_t>(num),
+        static_cast<off_t>(request->offset_));
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret <= 0) {
+        request->error_ = std::string("AsyncIO: Cannot read file ") +
+          request->filename_ + ": " + (ret < 0 ? strerror(errno) :
+          "unexpected end of file");
+        break;
+      }
+      request->offset_ += static_cast<uint64_t>(ret);
+    }
+    close(request);
+  }
+#else
+  void AsyncIO::readPread(AsyncIORequest* request) {
+    std::ifstream file(request->filename_.c_str(),
+      std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+      request->error_ = std::string("AsyncIO: Cannot open file ") +
+        request->filename_;
+      return;
+    }
+    request->size_ = static_cast<uint64_t>(file.tellg());
+    request->data_ = new uint8_t[request->size_ + 1];
+    request->data_[request->size_] = 0;
+    file.seekg(0);
+    while (request->offset_ < request->size_ && file.good()) {
+      uint64_t num = request->size_ - request->offset_;
+      num = num < ASYNC_IO_CHUNK_SIZE ? num : ASYNC_IO_CHUNK_SIZE;
+      file.read(reinterpret_cast<char*>(request->data_ + request->offset_),
+        static_cast<std::streamsize>(num));
+      request->offset_ += static_cast<uint64_t>(file.gcount());
+    }
+    if (request->offset_ < request->size_) {
+      request->error_ = std::string("AsyncIO: Cannot read file ") +
+        request->filename_;
+    }
+  }
+#endif
+
+#if defined(__linux__)
+  bool AsyncIO::uringSubmitRead(Uring* uring, AsyncIORequest* request) {
+    const unsigned tail = *uring->sq_tail;
+    const unsigned head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head > *uring->sq_mask) {
+      return false;  // Full (can't happen: one read per request in flight)
+    }
+    const unsigned index = tail & *uring->sq_mask;
+    io_uring_sqe* sqe = &uring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    uint64_t num = request->size_ - request->offset_;
+    num = num < ASYNC_IO_CHUNK_SIZE ? num : ASYNC_IO_CHUNK_SIZE;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = request->fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(request->data_ + request->offset_);
+    sqe->len = static_cast<uint32_t>(num);
+    sqe->off = request->offset_;
+    sqe->user_data = reinterpret_cast<uint64_t>(request);
+    uring->sq_array[index] = index;
+    __atomic_store_n(uring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    uring->num_to_submit++;
+    return true;
+  }
+
+  void AsyncIO::uringMain(Uring* uring) {
+    while (true) {
+      // Start as many files as we have room for, only blocking for a new
+      // request when nothing is in flight
+      while (uring->num_in_flight < ASYNC_IO_URING_DEPTH) {
+        AsyncIORequest* request = dequeue(uring->num_in_flight == 0);
+        if (request == NULL) {
+          break;
+        }
+        if (!open(request) || request->size_ == 0) {
+          close(request);
+          finish(request);
+          continue;
+        }
+        uringSubmitRead(uring, request);
+        uring->in_flight[uring->num_in_flight++] = request;
+      }
+      if (uring->num_in_flight == 0) {
+        return;  // Stopped and the queue is empty
+      }
+
+      const int ret = static_cast<int>(syscall(__NR_io_uring_enter, uring->fd,
+        uring->num_to_submit, 1, IORING_ENTER_GETEVENTS, NULL, 0));
+      if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        // The ring is broken: fail what's in flight and go back to pread
+        for (int i = 0; i < uring->num_in_flight; i++) {
+          AsyncIORequest* request = uring->in_flight[i];
+          request->error_ = std::string("AsyncIO: io_uring_enter failed: ") +
+            strerror(errno);
+          close(request);
+          finish(request);
+        }
+        uring->num_in_flight = 0;
+        return;
+      }
+      if (ret > 0) {
+        uring->num_to_submit -= static_cast<unsigned>(ret);
+      }
+
+      unsigned head = *uring->cq_head;
+      const unsigned tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++) {
+        const io_uring_cqe* cqe = &uring->cqes[head & *uring->cq_mask];
+        AsyncIORequest* request =
+          reinterpret_cast<AsyncIORequest*>(cqe->user_data);
+        const int res = cqe->res;
+        if (res == -EINTR || res == -EAGAIN) {
+          uringSubmitRead(uring, request);  // Try again
+          continue;
+        }
+        if (res > 0) {
+          request->offset_ += static_cast<uint64_t>(res);
+          if (request->offset_ < request->size_) {
+            uringSubmitRead(uring, request);  // Next chunk
+            continue;
+          }
+        } else {
+          request->error_ = std::string("AsyncIO: Cannot read file ") +
+            request->filename_ + ": " + (res < 0 ? strerror(-res) :
+            "unexpected end of file");
+        }
+        for (int i = 0; i < uring->num_in_flight; i++) {
+          if (uring->in_flight[i] == request) {
+            uring->in_flight[i] = uring->in_flight[--uring->num_in_flight];
+            break;
+          }
+        }
+        close(request);
+        finish(request);
+      }
+      __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+    }
+  }
+#endif
+
+  void AsyncIO::finish(AsyncIORequest* request) {
+    // If the pool has been stopped it rejects the task: run it here instead
+    if (request->on_complete_ == NULL || tp_ == NULL ||
+      !tp_->addTask(MakeTask(&AsyncIO::complete, this, request))) {
+      complete(request);
+    }
+  }
+
+  void AsyncIO::complete(AsyncIORequest* request) {
+    if (request->on_complete_ != NULL) {
+      Callback<void, AsyncIORequest*>* on_complete = request->on_complete_;
+      request->on_complete_ = NULL;
+      (*on_complete)(request);  // Deletes itself if it's a once callback
+    }
+    // Notify with the lock held: the request (and the service) may be
+    // destroyed as soon as a waiter sees done_
+    std::unique_lock<std::mutex> unique_lock(done_lock_);
+    request->done_ = true;
+    num_pending_--;
+    done_cv_.notify_all();
+  }
+
+};  // namespace file_io
+};  // namespace jtil
@@ -33,6 +33,16 @@ namespace marching_squares {
     curr = MAX_UINT32;
   }
 
+  Contour::Contour(const Contour& a) {
+    this->v1 = a.v1;
+    this->next = a.next;
+    this->prev = a.prev;
+    this->cost = a.cost;
+    this->curr = a.curr;
+    this->contour_index = a.contour_index;
+    // Don't copy the heap index, length and angle (see operator=)
+  }
+
   Contour& Contour::operator= (const Contour& a) {
     if (this == &a) {
       return *this;
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 #include "jtil/math/common_optimization.h"
 
 using std::cout;
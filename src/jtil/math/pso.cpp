@@ -1,5 +1,5 @@
 #include <cstring>
-#include <random>
+#include <limits>
 #include <stdexcept>
 #include <iostream>
 #include "jtil/math/pso.h"
@@ -14,9 +14,6 @@ using std::runtime_error;
 namespace jtil {
 namespace math {
 
-  MERSINE_TWISTER_ENG PSO::eng;
-  UNIFORM_REAL_DISTRIBUTION PSO::dist_real(0, 1);
-
   PSO::PSO(const uint32_t num_coeffs, const int swarm_size) {
     num_coeffs_ = num_coeffs;
     if (swarm_size > 0) {
@@ -47,6 +44,7 @@ namespace math {
     phi_g = 1.3f;  // Recommended by "An Off-The-Shelf PSO"
 
     verbose = false;
+    seed = 0;
   }
 
   PSO::~PSO() {
@@ -70,7 +68,9 @@ namespace math {
     const ObjectiveFuncPtr obj_func, 
     const CoeffUpdateFuncPtr coeff_update_func) {
 
-    eng.seed();
+    for (uint32_t i = 0; i < swarm_size_; i++) {
+      swarm_[i]->rand.seed(seed, i);
+    }
     if (verbose) {
       cout << "Starting PSO optimization..." << endl;
     }
@@ -91,9 +91,9 @@ namespace math {
 
     // Stochasticly sample for the other particles
     for (uint32_t j = 0; j < num_coeffs_; j++) {
-      UNIFORM_REAL_DISTRIBUTION c_dist(c_lo_[j], c_hi_[j]);
       for (uint32_t i = 1; i < swarm_size_; i++) {
-        float uniform_rand_num = c_dist(eng);  // [c_lo_, c_hi_)
+        // [c_lo_, c_hi_)
+        float uniform_rand_num = swarm_[i]->rand.uniform(c_lo_[j], c_hi_[j]);
         swarm_[i]->pos[j] = uniform_rand_num;
       }
     }
@@ -116,10 +116,10 @@ namespace math {
 
     // Initialize random velocity to Uniform(-2*radius_c, 2*radius_c)
     for (uint32_t j = 0; j < num_coeffs_; j++) {
-      UNIFORM_REAL_DISTRIBUTION c_dist(-2 * fabsf(radius_c[j]),
-        2 * fabsf(radius_c[j]));
+      const float rad = 2 * fabsf(radius_c[j]);
       for (uint32_t i = 0; i < swarm_size_; i++) {
-        float uniform_rand_num = c_dist(eng);  // [-2*radius_c, 2*radius_c)
+        // [-2*radius_c, 2*radius_c)
+        float uniform_rand_num = swarm_[i]->rand.uniform(-rad, rad);
         swarm_[i]->vel[j] = uniform_rand_num;
       }
     }
@@ -149,8 +149,8 @@ namespace math {
         SwarmNode* cur_node = swarm_[i];
         // For each dimension d:
         for (uint32_t d = 0; d < num_coeffs_; d++) {
-          float r_p = dist_real(eng);  // [0,1)
-          float r_g = dist_real(eng);  // [0,1)
+          float r_p = cur_node->rand.uniform();  // [0,1)
+          float r_g = cur_node->rand.uniform();  // [0,1)
           // Update the velocity
           cur_node->vel[d] = kappa_ * (cur_node->vel[d] + 
             (phi_p * r_p * (cur_node->best_pos[d] - cur_node->pos[d])) + 
@@ -1,5 +1,5 @@
 #include <cstring>
-#include <random>
+#include <limits>
 #include <stdexcept>
 #include <iostream>
 #include "jtil/math/pso_parallel.h"
@@ -14,9 +14,6 @@ using std::runtime_error;
 namespace jtil {
 namespace math {
 
-  MERSINE_TWISTER_ENG PSOParallel::eng;
-  UNIFORM_REAL_DISTRIBUTION PSOParallel::dist_real(0, 1);
-
   PSOParallel::PSOParallel(uint32_t num_coeffs, int swarm_size, int ntiles) :
     num_coeffs_(num_coeffs), ntiles_(ntiles) {
     if (swarm_size > 0) {
@@ -70,6 +67,7 @@ namespace math {
     tiled_residues.resize(ntiles_);
 
     verbose = false;
+    seed = 0;
   }
 
   PSOParallel::~PSOParallel() {
@@ -100,7 +98,9 @@ namespace math {
     obj_func_parallel_ = obj_func;
     coeff_update_func_ = coeff_update_func;
 
-    eng.seed();
+    for (uint32_t i = 0; i < swarm_size_; i++) {
+      swarm_[i]->rand.seed(seed, i);
+    }
     float phi = c_p + c_g;
     if (phi <= 4) {
       throw std::runtime_error("ERROR: kappa_ = phi_p + phi_g <= 4!");
@@ -126,9 +126,9 @@ namespace math {
 
     // Stochasticly sample for the other particles
     for (uint32_t j = 0; j < num_coeffs_; j++) {
-      UNIFORM_REAL_DISTRIBUTION c_dist(c_lo_[j], c_hi_[j]);
       for (uint32_t i = 1; i < swarm_size_; i++) {
-        float uniform_rand_num = c_dist(eng);  // [c_lo_, c_hi_)
+        // [c_lo_, c_hi_)
+        float uniform_rand_num = swarm_[i]->rand.uniform(c_lo_[j], c_hi_[j]);
         swarm_[i]->pos[j] = uniform_rand_num;
       }
     }
@@ -158,9 +158,10 @@ namespace math {
 
     // Initialize random velocity to Uniform(-vel_max_, vel_max_)
     for (uint32_t j = 0; j < num_coeffs_; j++) {
-      UNIFORM_REAL_DISTRIBUTION c_dist(-vel_max_[j], vel_max_[j]);
       for (uint32_t i = 0; i < swarm_size_; i++) {
-        float uniform_rand_num = c_dist(eng);  // [-2*radius_c, 2*radius_c)
+        // [-vel_max_, vel_max_)
+        float uniform_rand_num = swarm_[i]->rand.uniform(-vel_max_[j],
+          vel_max_[j]);
         swarm_[i]->vel[j] = uniform_rand_num;
       }
     }
@@ -224,8 +225,8 @@ namespace math {
         float c_g = C - c_p;
         // For each dimension d:
         for (uint32_t d = 0; d < num_coeffs_; d++) {
-          float r_p = dist_real(eng);  // [0,1)
-          float r_g = dist_real(eng);  // [0,1)
+          float r_p = cur_node->rand.uniform();  // [0,1)
+          float r_g = cur_node->rand.uniform();  // [0,1)
           float delta_p = calcDisplacement(cur_node->best_pos[d], 
             cur_node->pos[d], angle_coeffs_[d]);
           float delta_g = calcDisplacement(best_pos_global_[d], 
@@ -245,8 +246,8 @@ namespace math {
         // PSO UPDATE
         // For each dimension d:
         for (uint32_t d = 0; d < num_coeffs_; d++) {
-          float r_p = dist_real(eng);  // [0,1)
-          float r_g = dist_real(eng);  // [0,1)
+          float r_p = cur_node->rand.uniform();  // [0,1)
+          float r_g = cur_node->rand.uniform();  // [0,1)
           float delta_p = calcDisplacement(cur_node->best_pos[d], 
             cur_node->pos[d], angle_coeffs_[d]);
           float delta_g = calcDisplacement(best_pos_global_[d], 
@@ -274,13 +275,13 @@ namespace math {
         if (num_iterations < max_iterations - 1) {
           // For each dimension d:
           for (uint32_t d = 0; d < num_coeffs_; d++) {
-            float rand = dist_real(eng);  // [0,1)
+            float rand = cur_node->rand.uniform();  // [0,1)
             // With some probability, preterb the position of the d-th coeff
             // using Uniform(c_lo_, c_hi_)
             if (rand <= Pr) {
               // The paper version --> Completely new position (kinda silly)
               // cur_node->pos(d) =
-              //   (preturb_rad * (c_hi_(d) - c_lo_(d))) * dist_real(eng) + c_lo_(d);  
+              //   (preturb_rad * (c_hi_(d) - c_lo_(d))) * cur_node->rand.uniform() + c_lo_(d);  
 
               // My version --> Preturb away from where the particle is now
               rand = rand * 2.0f - 1.0f;  // [-1, 1]
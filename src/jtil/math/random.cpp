@@ -0,0 +1,140 @@
+#include <math.h>
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define RAND_USE_SSE2
+#endif
+#include "jtil/math/random.h"
+
+#define RAND_FLOAT_SCALE (1.0f / 16777216.0f)  // 2^-24
+#define RAND_TWO_PI 6.28318530717958647692f
+
+namespace jtil {
+namespace math {
+
+  // splitmix64, used to spread the seed over the state
+  static uint64_t SplitMix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  // The two 24 bit floats in [0, 1) of one 64 bit draw
+  static inline float HighFloat(const uint64_t x) {
+    return static_cast<float>(x >> 40) * RAND_FLOAT_SCALE;
+  }
+
+  static inline float MidFloat(const uint64_t x) {
+    return static_cast<float>((x >> 16) & 0xffffff) * RAND_FLOAT_SCALE;
+  }
+
+  // Box-Muller: two independent normals from one 64 bit draw
+  static inline void NormalPair(const uint64_t x, float* a, float* b) {
+    const float u1 = HighFloat(x) + RAND_FLOAT_SCALE;  // (0, 1], for log
+    const float theta = RAND_TWO_PI * MidFloat(x);
+    const float r = sqrtf(-2.0f * logf(u1));
+    *a = r * cosf(theta);
+    *b = r * sinf(theta);
+  }
+
+  Rand::Rand(const uint64_t seed, const uint64_t stream) {
+    this->seed(seed, stream);
+  }
+
+  void Rand::seed(const uint64_t seed, const uint64_t stream) {
+    uint64_t x = seed;
+    uint64_t y = stream;
+    x = SplitMix64(&x) ^ SplitMix64(&y);
+    s_[0] = SplitMix64(&x);
+    s_[1] = SplitMix64(&x);
+    if (s_[0] == 0 && s_[1] == 0) {
+      s_[0] = 1;  // The all zero state is a fixed point
+    }
+    has_spare_normal_ = false;
+    spare_normal_ = 0;
+  }
+
+  void Rand::jump() {
+    static const uint64_t jump_poly[2] = {0xdf900294d8f554a5ull,
+      0x170865df4b3201fcull};
+    uint64_t s0 = 0;
+    uint64_t s1 = 0;
+    for (int i = 0; i < 2; i++) {
+      for (int b = 0; b < 64; b++) {
+        if (jump_poly[i] & (1ull << b)) {
+          s0 ^= s_[0];
+          s1 ^= s_[1];
+        }
+        next();
+      }
+    }
+    s_[0] = s0;
+    s_[1] = s1;
+    has_spare_normal_ = false;
+  }
+
+  float Rand::normal() {
+    if (has_spare_normal_) {
+      has_spare_normal_ = false;
+      return spare_normal_;
+    }
+    float ret;
+    NormalPair(next(), &ret, &spare_normal_);
+    has_spare_normal_ = true;
+    return ret;
+  }
+
+  float Rand::normal(const float mean, const float std_dev) {
+    return mean + std_dev * normal();
+  }
+
+  void Rand::uniform(float* dst, const uint32_t n, const float lo,
+    const float hi) {
+    const float range = hi - lo;
+    uint32_t i = 0;
+#ifdef RAND_USE_SSE2
+    // Convert and scale 4 floats (2 draws) at a time
+    const __m128i mask = _mm_set1_epi64x(0xffffff);
+    const __m128 scale = _mm_set1_ps(RAND_FLOAT_SCALE);
+    const __m128 lo4 = _mm_set1_ps(lo);
+    const __m128 range4 = _mm_set1_ps(range);
+    for (; i + 4 <= n; i += 4) {
+      const uint64_t x0 = next();
+      const uint64_t x1 = next();
+      const __m128i x = _mm_set_epi64x(static_cast<int64_t>(x1),
+        static_cast<int64_t>(x0));
+      const __m128i high = _mm_srli_epi64(x, 40);
+      const __m128i mid = _mm_and_si128(_mm_srli_epi64(x, 16), mask);
+      // 32 bit lanes: high(x0), mid(x0), high(x1), mid(x1)
+      const __m128i bits = _mm_or_si128(high, _mm_slli_epi64(mid, 32));
+      const __m128 u = _mm_mul_ps(_mm_cvtepi32_ps(bits), scale);
+      _mm_storeu_ps(dst + i, _mm_add_ps(lo4, _mm_mul_ps(range4, u)));
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+      const uint64_t x = next();
+      dst[i] = lo + range * HighFloat(x);
+      dst[i + 1] = lo + range * MidFloat(x);
+    }
+    if (i < n) {
+      dst[i] = lo + range * HighFloat(next());
+    }
+  }
+
+  void Rand::normal(float* dst, const uint32_t n, const float mean,
+    const float std_dev) {
+    uint32_t i = 0;
+    float a, b;
+    for (; i + 2 <= n; i += 2) {
+      NormalPair(next(), &a, &b);
+      dst[i] = mean + std_dev * a;
+      dst[i + 1] = mean + std_dev * b;
+    }
+    if (i < n) {
+      NormalPair(next(), &a, &b);
+      dst[i] = mean + std_dev * a;
+    }
+  }
+
+};  // namespace math
+};  // namespace jtil
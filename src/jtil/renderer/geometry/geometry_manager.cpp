@@ -10,6 +10,7 @@
 #include "jtil/data_str/hash_map.h"
 #include "jtil/data_str/hash_set.h"
 #include "jtil/data_str/hash_map_managed.h"
+#include "jtil/data_str/flat_hash_map.h"
 #include "jtil/data_str/hash_funcs.h"  // For HashString
 #include "jtil/renderer/geometry/geometry.h"
 #include "jtil/renderer/geometry/geometry_instance.h"
@@ -28,6 +29,7 @@
 #include "jtil/fastlz/fastlz_helper.h"
 #include "jtil/settings/settings_manager.h"
 #include "jtil/renderer/renderer.h"
+#include "jtil/debug_util/trace.h"
 
 #define WHITE_TEXTURE "resource_files/white.tga"
 
@@ -49,7 +51,7 @@ using data_str::Vector;
 using data_str::VectorManaged;
 using data_str::Pair;
 using data_str::HashMapManaged;
-using data_str::HashMap;
+using data_str::FlatHashMap;
 using data_str::HashSet;
 using ucl::UCLHelper;
 using fastlz::FastlzHelper;
@@ -72,7 +74,7 @@ namespace renderer {
       &data_str::HashString);
     geom_ = new HashMapManaged<string, Geometry*>(GM_START_HM_SIZE, 
       &data_str::HashString);
-    bone_name_to_index_ = new HashMap<string, uint32_t>(GM_START_HM_SIZE, 
+    bone_name_to_index_ = new FlatHashMap<string, uint32_t>(GM_START_HM_SIZE,
       &data_str::HashString);
     bones_ = new VectorManaged<Bone*>();
     render_stack_ = new Vector<GeometryInstance*>();
@@ -1977,7 +1979,7 @@ void GeometryManager::createAssimpImporter(Assimp::Importer*& importer,
   
   void GeometryManager::saveModelBonesToJBinFile(std::ofstream& file, 
     const GeometryInstance* model) {
-    HashMap<string, uint32_t> bone_name2ind(GM_START_HM_SIZE, 
+    FlatHashMap<string, uint32_t> bone_name2ind(GM_START_HM_SIZE,
       data_str::HashString);
     Vector<Bone*> bones_in_tree;
     // Collect all the bones in the file
@@ -2034,6 +2036,7 @@ void GeometryManager::createAssimpImporter(Assimp::Importer*& importer,
 
   GeometryInstance* GeometryManager::loadModelFromJBinFile(
     const string& path, const string& filename) {
+    JTIL_TRACE_SCOPE("GeometryManager::loadModelFromJBinFile");
     // Open a filestream for writing
     string full_path;
     if (path.at(path.length()-1) != '/' && path.at(path.length()-1) != '\\') {
@@ -2074,6 +2077,11 @@ void GeometryManager::createAssimpImporter(Assimp::Importer*& importer,
   void GeometryManager::loadModelMeshesFromJBinFile(std::ifstream& file) {
     uint32_t n_meshes;
     file.read(reinterpret_cast<char*>(&n_meshes), sizeof(n_meshes));
+    {
+      // Size the name table once, rather than rehashing as meshes come in
+      std::lock_guard<std::recursive_mutex> lock(data_lock_);
+      geom_->reserve(geom_->count() + n_meshes);
+    }
 
     // Temporary read buffer...  Avoid lots of dynamic memory allocations if
     // there are 1000s of nodes it might be slow.
@@ -2187,6 +2195,7 @@ void GeometryManager::createAssimpImporter(Assimp::Importer*& importer,
     // First comes the number of nodes
     uint32_t n_bones;
     file.read(reinterpret_cast<char*>(&n_bones), sizeof(n_bones));
+    bone_name_to_index_->reserve(bone_name_to_index_->count() + n_bones);
 
     // Temporary read buffer...  Avoid lots of dynamic memory allocations if
     // there are 1000s of nodes it might be slow.
@@ -27,6 +27,7 @@
 #include "jtil/math/math_types.h"
 #include "jtil/math/perlin_noise.h"
 #include "jtil/clk/clk.h"
+#include "jtil/debug_util/trace.h"
 #include "jtil/threading/thread.h"
 #include "jtil/threading/callback.h"
 
@@ -209,6 +210,7 @@ namespace renderer {
   }
 
   void Renderer::renderFrame() {    
+    JTIL_TRACE_SCOPE("Renderer::renderFrame");
     t0_ = t1_;
     t1_ = clk_->getTime();
     float dt = (float)(t1_-t0_);
@@ -217,32 +219,46 @@ namespace renderer {
     GLState::verifyOpenGLState();
 #endif
 
-    ui_->update(dt);
+    {
+      JTIL_TRACE_SCOPE("Renderer::update");
+      ui_->update(dt);
 
-    // Update camera parameters
-    updateCameraFOVScreenSize();  // SettingsManager may have changed them
-    camera_->updateView();
-    updateFlashlight(dt);  // Before updateLights but after updateView!
+      // Update camera parameters
+      updateCameraFOVScreenSize();  // SettingsManager may have changed them
+      camera_->updateView();
+      updateFlashlight(dt);  // Before updateLights but after updateView!
 
-    // Update all heirachical matrices (for renderable geometry)
-    updateMatrices();  
-    updateBoundingVolumes();
+      // Update all heirachical matrices (for renderable geometry)
+      updateMatrices();  
+      updateBoundingVolumes();
 
-    lighting_->updateLights();  // Lights need valid camera view at this point
+      lighting_->updateLights();  // Lights need valid camera view here
 
-    fitCameraNearFarToObjects();  // must update camera view matrix first!
-    camera_->updateProjection();  // near/far is tightly fitted to world bounds  
-    lighting_->updateLightsPVW();  // camera project must have been updated
-
-    g_buffer_->renderGBuffer();  // Renders to g-buffer texture
+      fitCameraNearFarToObjects();  // must update camera view matrix first!
+      camera_->updateProjection();  // near/far is tightly fitted to world
+      lighting_->updateLightsPVW();  // camera project must have been updated
+    }
 
-    lighting_->renderLighting();  // Renders to light accumulation texture
+    {
+      JTIL_TRACE_SCOPE("Renderer::renderGBuffer");
+      g_buffer_->renderGBuffer();  // Renders to g-buffer texture
+    }
 
-    post_processing_->renderPostProcessing(dt);
+    {
+      JTIL_TRACE_SCOPE("Renderer::renderLighting");
+      lighting_->renderLighting();  // Renders to light accumulation texture
+    }
 
-    renderOutputFrameToScreen();
+    {
+      JTIL_TRACE_SCOPE("Renderer::renderPostProcessing");
+      post_processing_->renderPostProcessing(dt);
+      renderOutputFrameToScreen();
+    }
 
-    ui_->renderFrame();  // Draw UI last (on top)
+    {
+      JTIL_TRACE_SCOPE("Renderer::renderUI");
+      ui_->renderFrame();  // Draw UI last (on top)
+    }
 
     // Make sure we're single or double buffering
     bool double_buffering;
@@ -250,7 +266,10 @@ namespace renderer {
     if (wnd_->getDoubleBuffering() != double_buffering) {
       wnd_->setDoubleBuffering(double_buffering);
     }
-    wnd_->swapBackBuffer();
+    {
+      JTIL_TRACE_SCOPE("Renderer::swapBackBuffer");
+      wnd_->swapBackBuffer();
+    }
 
     // Reload the renderer only when it's a good time to do so.
     if (reload_renderer_) {
@@ -473,12 +473,9 @@ namespace renderer {
       std::cout << geom_shader_->filename();
     }
     std::cout << std::endl;
-    const Pair<string, GLStateElem*>* table = uniforms_->table();
-    const bool* bucket_full = uniforms_->bucket_full();
-    for (uint32_t i = 0; i < uniforms_->size(); i++) {
-      if (bucket_full[i]) {
-        std::cout << table[i].first << std::endl;
-      }
+    HashMapManaged<string, GLStateElem*>::const_iterator it;
+    for (it = uniforms_->begin(); it != uniforms_->end(); ++it) {
+      std::cout << it->first << std::endl;
     }
   }
 
@@ -0,0 +1,251 @@
+#include "jtil/threading/task_group.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+namespace jtil {
+namespace threading {
+
+  using data_str::Vector;
+
+  TaskGroupItem::TaskGroupItem(TaskGroup* group, Callback<void>* task) :
+    group_(group), task_(task) {
+    claimed_.store(false);
+    num_refs_.store(2);  // The pool and the group's unstarted_ list
+  }
+
+  bool TaskGroupItem::claimAndRun() {
+    if (claimed_.exchange(true)) {
+      return false;
+    }
+    // The group can't be destroyed until taskDone() has returned
+    (*task_)();
+    group_->taskDone();
+    return true;
+  }
+
+  void TaskGroupItem::release() {
+    if (num_refs_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  TaskGroup::TaskGroup(ThreadPool* tp, const ThreadPoolPriority priority) :
+    tp_(tp), priority_(priority), num_pending_(0) {
+  }
+
+  TaskGroup::~TaskGroup() {
+    wait();
+  }
+
+  TaskGroupItem* TaskGroup::addItem(Callback<void>* task) {
+    // Items that a worker has already claimed are only kept alive by this
+    // list, so drop them from the head (wait() would otherwise be the only
+    // thing that cleans them up).
+    while (!unstarted_.empty() && unstarted_.peak()->claimed()) {
+      unstarted_.dequeue()->release();
+    }
+    TaskGroupItem* item = new TaskGroupItem(this, task);
+    num_pending_++;
+    unstarted_.enqueue(item);
+    return item;
+  }
+
+  // Static: once lock_ is released a waiter may run the item and destroy the
+  // group, so the caller must not touch 'this' anymore.
+  void TaskGroup::submit(ThreadPool* tp, const ThreadPoolPriority priority,
+    TaskGroupItem* item) {
+    if (tp->stopped()) {
+      item->release();  // The pool will never run it, wait() will
+    } else {
+      tp->addTask(new TaskGroupItemRef(item), priority);
+    }
+  }
+
+  void TaskGroup::run(Callback<void>* task) {
+    ThreadPool* tp = tp_;
+    const ThreadPoolPriority priority = priority_;
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    TaskGroupItem* item = addItem(task);
+    unique_lock.unlock();
+    submit(tp, priority, item);
+  }
+
+  void TaskGroup::then(Callback<void>* continuation) {
+    ThreadPool* tp = tp_;
+    const ThreadPoolPriority priority = priority_;
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    if (num_pending_ > 0) {
+      continuations_.enqueue(continuation);
+      return;
+    }
+    TaskGroupItem* item = addItem(continuation);
+    unique_lock.unlock();
+    submit(tp, priority, item);
+  }
+
+  void TaskGroup::taskDone() {
+    ThreadPool* tp = tp_;
+    const ThreadPoolPriority priority = priority_;
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    num_pending_--;
+    if (num_pending_ > 0) {
+      return;
+    }
+    if (continuations_.empty()) {
+      // Notify with the lock held: once wait() sees num_pending_ == 0 the
+      // group may be destroyed, so we must not touch it after unlocking.
+      done_cv_.notify_all();
+      return;
+    }
+    Vector<TaskGroupItem*> items(static_cast<uint32_t>(continuations_.size()));
+    while (!continuations_.empty()) {
+      items.pushBack(addItem(continuations_.dequeue()));
+    }
+    done_cv_.notify_all();  // Waiters may want to help
+    unique_lock.unlock();
+    for (uint32_t i = 0; i < items.size(); i++) {
+      submit(tp, priority, items[i]);
+    }
+  }
+
+  void TaskGroup::wait() {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    while (true) {
+      if (!unstarted_.empty()) {
+        TaskGroupItem* item = unstarted_.dequeue();
+        unique_lock.unlock();
+        item->claimAndRun();
+        item->release();
+        unique_lock.lock();
+      } else if (num_pending_ > 0) {
+        done_cv_.wait(unique_lock);
+      } else {
+        break;
+      }
+    }
+  }
+
+  int TaskGroup::numPending() const {
+    std::unique_lock<std::mutex> unique_lock(lock_);
+    return num_pending_;
+  }
+
+  TaskGraph::Node::Node(TaskGraph* graph, Callback<void>* task) :
+    graph(graph), task(task), num_predecessors(0) {
+    num_waiting.store(0);
+  }
+
+  TaskGraph::Node::~Node() {
+    delete task;
+  }
+
+  void TaskGraph::Node::operator()() {
+    Node* cur = this;
+    while (cur != NULL) {
+      (*cur->task)();
+      // Release the successors.  All but the last ready one go back to the
+      // pool, the last one runs here (we are still part of the group, so
+      // wait() can't return early).
+      Node* next = NULL;
+      for (uint32_t i = 0; i < cur->successors.size(); i++) {
+        Node* succ = graph->nodes_[cur->successors[i]];
+        if (succ->num_waiting.fetch_sub(1) == 1) {
+          if (next != NULL) {
+            graph->group_.run(next);
+          }
+          next = succ;
+        }
+      }
+      cur = next;
+    }
+  }
+
+  TaskGraph::TaskGraph(ThreadPool* tp, const ThreadPoolPriority priority) :
+    group_(tp, priority), dirty_(true) {
+  }
+
+  TaskGraph::~TaskGraph() {
+    wait();
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      delete nodes_[i];
+    }
+  }
+
+  int TaskGraph::addNode(Callback<void>* task) {
+    if (task->once()) {
+      throw std::wruntime_error("TaskGraph::addNode: task must not be a "
+        "once callback (the graph runs it every run() call)");
+    }
+    nodes_.pushBack(new Node(this, task));
+    dirty_ = true;
+    return static_cast<int>(nodes_.size()) - 1;
+  }
+
+  void TaskGraph::addEdge(const int before, const int after) {
+    const int num_nodes = static_cast<int>(nodes_.size());
+    if (before < 0 || before >= num_nodes || after < 0 || after >= num_nodes) {
+      throw std::wruntime_error("TaskGraph::addEdge: Node out of bounds");
+    }
+    nodes_[before]->successors.pushBack(after);
+    nodes_[after]->num_predecessors++;
+    dirty_ = true;
+  }
+
+  void TaskGraph::buildRoots() {
+    roots_.clear();
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      if (nodes_[i]->num_predecessors == 0) {
+        roots_.pushBack(static_cast<int>(i));
+      }
+    }
+
+    // Kahn's algorithm: if a topological sort doesn't reach every node then
+    // the rest are on (or behind) a cycle and would never run.
+    Vector<int> num_waiting(nodes_.size());
+    Vector<int> ready(nodes_.size());
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      num_waiting.pushBack(nodes_[i]->num_predecessors);
+    }
+    for (uint32_t i = 0; i < roots_.size(); i++) {
+      ready.pushBack(roots_[i]);
+    }
+    uint32_t num_visited = 0;
+    while (ready.size() > 0) {
+      int cur;
+      ready.popBack(cur);
+      num_visited++;
+      const Vector<int>& successors = nodes_[cur]->successors;
+      for (uint32_t i = 0; i < successors.size(); i++) {
+        if (--num_waiting[successors[i]] == 0) {
+          ready.pushBack(successors[i]);
+        }
+      }
+    }
+    if (num_visited != nodes_.size()) {
+      throw std::wruntime_error("TaskGraph::run: The graph has a cycle");
+    }
+    dirty_ = false;
+  }
+
+  void TaskGraph::run() {
+    wait();
+    if (dirty_) {
+      buildRoots();
+    }
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      nodes_[i]->num_waiting.store(nodes_[i]->num_predecessors);
+    }
+    for (uint32_t i = 0; i < roots_.size(); i++) {
+      group_.run(nodes_[roots_[i]]);
+    }
+  }
+
+  void TaskGraph::wait() {
+    group_.wait();
+  }
+
+  void TaskGraph::then(Callback<void>* continuation) {
+    group_.then(continuation);
+  }
+
+};  // namespace threading
+};  // namespace jtil
@@ -6,10 +6,16 @@
   #include <windows.h>
 #elif defined(__APPLE__)
   #include <pthread.h>
+  #include <sys/sysctl.h>
 #else
   #include <sys/prctl.h>
+  #include <sched.h>
+  #include <pthread.h>
+  #include <dirent.h>
+  #include <string.h>
 #endif
 #include "jtil/threading/thread.h"
+#include "jtil/debug_util/trace.h"
 
 using std::thread;
 
@@ -58,6 +64,69 @@ namespace threading {
       RaiseException( MS_VC_EXCEPTION, 0, sizeof(info)/sizeof(ULONG_PTR), (ULONG_PTR*)&info );
     } __except(EXCEPTION_EXECUTE_HANDLER) {
     }
+    debug::Trace::setThreadName(thread_name);
+  }
+
+  int GetNumCPUs() {
+    DWORD_PTR process_mask;
+    DWORD_PTR system_mask;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask,
+      &system_mask)) {
+      int num_cpus = 0;
+      for (; process_mask != 0; process_mask &= process_mask - 1) {
+        num_cpus++;
+      }
+      return num_cpus;
+    }
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<int>(info.dwNumberOfProcessors);
+  }
+
+  int GetPhysicalCoreCPUs(int* cpus, const int max_cpus) {
+    DWORD size = 0;
+    GetLogicalProcessorInformation(NULL, &size);
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION* info =
+      (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)malloc(size);
+    int num_cpus = 0;
+    if (info != NULL && GetLogicalProcessorInformation(info, &size)) {
+      const int num_info = size / sizeof(info[0]);
+      for (int i = 0; i < num_info && num_cpus < max_cpus; i++) {
+        if (info[i].Relationship != RelationProcessorCore) {
+          continue;
+        }
+        ULONG_PTR mask = info[i].ProcessorMask;
+        int cpu = 0;
+        while (mask != 0 && (mask & 1) == 0) {
+          mask >>= 1;
+          cpu++;
+        }
+        cpus[num_cpus++] = cpu;
+      }
+    }
+    free(info);
+    return num_cpus;
+  }
+
+  int GetCPUNumaNode(const int cpu) {
+    UCHAR node;
+    if (cpu >= 0 && cpu < 256 &&
+      GetNumaProcessorNode(static_cast<UCHAR>(cpu), &node)) {
+      return static_cast<int>(node);
+    }
+    return 0;
+  }
+
+  int GetCurrentCPU() {
+    return static_cast<int>(GetCurrentProcessorNumber());
+  }
+
+  bool SetThreadAffinity(std::thread* thread, const int cpu) {
+    if (cpu < 0 || cpu >= static_cast<int>(8 * sizeof(DWORD_PTR))) {
+      return false;
+    }
+    return SetThreadAffinityMask(static_cast<HANDLE>(thread->native_handle()),
+      static_cast<DWORD_PTR>(1) << cpu) != 0;
   }
 #elif defined(__APPLE__)
 
@@ -65,6 +134,41 @@ namespace threading {
   void SetThreadName(char const * thread_name)
   {
     pthread_setname_np(thread_name);
+    debug::Trace::setThreadName(thread_name);
+  }
+
+  int GetNumCPUs() {
+    const int num_cpus = static_cast<int>(std::thread::hardware_concurrency());
+    return num_cpus > 0 ? num_cpus : 1;
+  }
+
+  // The hardware threads of a core are numbered consecutively
+  int GetPhysicalCoreCPUs(int* cpus, const int max_cpus) {
+    int num_cores = 0;
+    size_t size = sizeof(num_cores);
+    if (sysctlbyname("hw.physicalcpu", &num_cores, &size, NULL, 0) != 0 ||
+      num_cores <= 0) {
+      num_cores = GetNumCPUs();
+    }
+    const int threads_per_core = GetNumCPUs() / num_cores;
+    int num_cpus = 0;
+    for (int i = 0; i < num_cores && num_cpus < max_cpus; i++) {
+      cpus[num_cpus++] = i * (threads_per_core > 0 ? threads_per_core : 1);
+    }
+    return num_cpus;
+  }
+
+  int GetCPUNumaNode(const int cpu) {
+    return 0;
+  }
+
+  int GetCurrentCPU() {
+    return -1;
+  }
+
+  // OS X only has affinity hints (thread_policy_set), not pinning
+  bool SetThreadAffinity(std::thread* thread, const int cpu) {
+    return false;
   }
 
 #else
@@ -72,7 +176,117 @@ namespace threading {
   // SetThreadName - Linux implementation
   void SetThreadName(char const * thread_name)
   {
-    prctl(PR_SET_NAME, "thread_name", 0, 0, 0);
+    prctl(PR_SET_NAME, thread_name, 0, 0, 0);
+    debug::Trace::setThreadName(thread_name);
+  }
+
+  static void GetProcessCPUSet(cpu_set_t* cpu_set) {
+    if (sched_getaffinity(0, sizeof(*cpu_set), cpu_set) != 0) {
+      CPU_ZERO(cpu_set);
+      const int num_cpus = static_cast<int>(thread::hardware_concurrency());
+      for (int i = 0; i < num_cpus || i == 0; i++) {
+        CPU_SET(i, cpu_set);
+      }
+    }
+  }
+
+  static int ReadCPUTopology(const int cpu, const char* name,
+    const int default_val) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s",
+      cpu, name);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+      return default_val;
+    }
+    int val;
+    if (fscanf(file, "%d", &val) != 1) {
+      val = default_val;
+    }
+    fclose(file);
+    return val;
+  }
+
+  int GetNumCPUs() {
+    cpu_set_t cpu_set;
+    GetProcessCPUSet(&cpu_set);
+    return CPU_COUNT(&cpu_set);
+  }
+
+  int GetPhysicalCoreCPUs(int* cpus, const int max_cpus) {
+    cpu_set_t cpu_set;
+    GetProcessCPUSet(&cpu_set);
+    static const int max_cores = CPU_SETSIZE;
+    int core_cpu[max_cores];
+    int core_package[max_cores];
+    int core_id[max_cores];
+    int num_cores = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (!CPU_ISSET(cpu, &cpu_set)) {
+        continue;
+      }
+      const int package = ReadCPUTopology(cpu, "physical_package_id", 0);
+      const int core = ReadCPUTopology(cpu, "core_id", cpu);
+      int i = 0;
+      while (i < num_cores && (core_package[i] != package ||
+        core_id[i] != core)) {
+        i++;
+      }
+      if (i == num_cores) {  // The first hardware thread of a new core
+        // Insert after the other cores of the same (or a lower) package
+        while (i > 0 && core_package[i - 1] > package) {
+          core_cpu[i] = core_cpu[i - 1];
+          core_package[i] = core_package[i - 1];
+          core_id[i] = core_id[i - 1];
+          i--;
+        }
+        core_cpu[i] = cpu;
+        core_package[i] = package;
+        core_id[i] = core;
+        num_cores++;
+      }
+    }
+    const int num_cpus = num_cores < max_cpus ? num_cores : max_cpus;
+    for (int i = 0; i < num_cpus; i++) {
+      cpus[i] = core_cpu[i];
+    }
+    return num_cpus;
+  }
+
+  int GetCPUNumaNode(const int cpu) {
+    // The cpu's sysfs directory has a "node<N>" link on NUMA kernels
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+      return 0;
+    }
+    int node = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+      if (strncmp(entry->d_name, "node", 4) == 0 &&
+        entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+        node = atoi(entry->d_name + 4);
+        break;
+      }
+    }
+    closedir(dir);
+    return node;
+  }
+
+  int GetCurrentCPU() {
+    return sched_getcpu();
+  }
+
+  bool SetThreadAffinity(std::thread* thread, const int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    return pthread_setaffinity_np(thread->native_handle(), sizeof(cpu_set),
+      &cpu_set) == 0;
   }
 
 #endif
@@ -1,8 +1,15 @@
+#include <algorithm>  // For std::min
+#include <chrono>
 #include "jtil/threading/thread_pool.h"
 #include "jtil/threading/thread.h"
+#include "jtil/debug_util/trace.h"
+#include "jtil/exceptions/wruntime_error.h"
 
 #if defined(WIN32) || defined(_WIN32)
   #define snprintf _snprintf
+  #define THREAD_LOCAL __declspec(thread)
+#else
+  #define THREAD_LOCAL __thread
 #endif
 
 namespace jtil {
@@ -10,14 +17,164 @@ namespace threading {
   
   using threading::Callback;
   using threading::MakeCallableOnce;
+
+  // The pool (and worker index) that owns the current thread.  Used in 
+  // TP_WORK_STEALING mode to push tasks onto the caller's own deque.
+  static THREAD_LOCAL ThreadPool* cur_thread_pool_ = NULL;
+  static THREAD_LOCAL int cur_thread_index_ = -1;
+
+  static inline int64_t TimeNS() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // Counters have a single writer, so a plain load + store is enough
+  template <typename T>
+  static inline void StatsAdd(std::atomic<T>& counter, const T val) {
+    counter.store(counter.load(std::memory_order_relaxed) + val,
+      std::memory_order_relaxed);
+  }
   
-  ThreadPool::ThreadPool(int num_workers) {
+  ThreadPool::ThreadPool(int num_workers, const ThreadPoolMode mode,
+    const int* num_reserved_workers, const ThreadPoolPlacement* placement) {
+    int num_reserved = 0;
+    if (num_reserved_workers != NULL) {
+      for (int p = TP_PRIORITY_LOW + 1; p < TP_NUM_PRIORITIES; p++) {
+        if (num_reserved_workers[p] < 0) {
+          throw std::wruntime_error("ThreadPool::ThreadPool: "
+            "num_reserved_workers must not be negative");
+        }
+        num_reserved += num_reserved_workers[p];
+      }
+    }
+    if (num_reserved > 0 && num_reserved >= num_workers) {
+      throw std::wruntime_error("ThreadPool::ThreadPool: At least one "
+        "worker must be left to run TP_PRIORITY_LOW tasks");
+    }
+    if (placement != NULL && placement->affinity == TP_AFFINITY_CPU_LIST &&
+      (placement->cpus == NULL || placement->num_cpus <= 0)) {
+      throw std::wruntime_error("ThreadPool::ThreadPool: TP_AFFINITY_CPU_LIST "
+        "needs at least one CPU");
+    }
     queue_lock_.lock();  // Prevent tasks from being added until workers spawn
     // Spawn worker threads
     stop_called_ = false;
     stop_finished_ = false;
     thread_to_join_in_destructor_ = NULL;
     num_workers_ = num_workers;
+    mode_ = mode;
+    for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+      num_pending_[p].store(0);
+    }
+    num_shared_pending_.store(0);
+    num_sleeping_.store(0);
+    num_adding_.store(0);
+    // The reserved workers are the ones at the end, highest priority last
+    worker_priority_ = new ThreadPoolPriority[num_workers_];
+    has_reserved_workers_ = num_reserved > 0;
+    num_reserved_workers_ = num_reserved;
+    int cur_worker = num_workers_;
+    for (int p = TP_NUM_PRIORITIES - 1; p > TP_PRIORITY_LOW; p--) {
+      const int num = num_reserved_workers ? num_reserved_workers[p] : 0;
+      for (int i = 0; i < num; i++) {
+        worker_priority_[--cur_worker] = static_cast<ThreadPoolPriority>(p);
+      }
+    }
+    while (cur_worker > 0) {
+      worker_priority_[--cur_worker] = TP_PRIORITY_LOW;
+    }
+    initPlacement(placement);
+    worker_deques_ = NULL;
+    worker_rand_state_ = NULL;
+    worker_steal_order_ = NULL;
+    worker_num_local_ = NULL;
+    if (mode_ == TP_WORK_STEALING) {
+      const int num_deques = num_workers_ * TP_NUM_PRIORITIES;
+      worker_deques_ = new WorkStealingDeque<Callback<void>*>*[num_deques];
+      for (int i = 0; i < num_deques; i++) {
+        worker_deques_[i] = new WorkStealingDeque<Callback<void>*>();
+      }
+      worker_rand_state_ = new uint32_t[num_workers_];
+      for (int i = 0; i < num_workers_; i++) {
+        worker_rand_state_[i] = 2463534242u + 7919u * static_cast<uint32_t>(i);
+      }
+      // Each worker's victims start just after it, so that they don't all
+      // sweep the same workers in the same order
+      const bool numa_local = placement != NULL &&
+        placement->numa_local_queues;
+      worker_steal_order_ = new int[num_workers_ * (num_workers_ - 1) + 1];
+      worker_num_local_ = new int[num_workers_];
+      for (int i = 0; i < num_workers_; i++) {
+        int* order = &worker_steal_order_[i * (num_workers_ - 1)];
+        int num_victims = 0;
+        for (int local = 1; local >= 0; local--) {
+          for (int j = 1; j < num_workers_; j++) {
+            const int victim = (i + j) % num_workers_;
+            const bool same_node = !numa_local ||
+              worker_node_[victim] == worker_node_[i];
+            if (same_node == (local == 1)) {
+              order[num_victims++] = victim;
+            }
+          }
+          if (local == 1) {
+            worker_num_local_[i] = num_victims;
+          }
+        }
+      }
+    }
+    worker_locks_ = NULL;
+    worker_woken_ = NULL;
+    worker_busy_ = NULL;
+    for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+      lf_task_queues_[p] = NULL;
+      lf_idle_worker_queues_[p] = NULL;
+    }
+    if (mode_ == TP_LOCK_FREE_QUEUE) {
+      for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+        lf_task_queues_[p] = new LockFreeQueue<Callback<void>*>(
+          THREAD_POOL_LOCK_FREE_QUEUE_SIZE);
+        // Each worker is on an idle queue at most once, so it can never fill
+        lf_idle_worker_queues_[p] = new LockFreeQueue<int>(num_workers_);
+      }
+      worker_locks_ = new std::mutex[num_workers_];
+      worker_woken_ = new bool[num_workers_];
+      worker_busy_ = new bool[num_workers_];
+      for (int i = 0; i < num_workers_; i++) {
+        worker_woken_[i] = false;
+        worker_busy_[i] = false;
+      }
+    }
+    elastic_enabled_ = false;
+    worker_running_ = new bool[num_workers_];
+    worker_idle_ = new bool[num_workers_];
+    for (int i = 0; i < num_workers_; i++) {
+      worker_running_[i] = true;
+      worker_idle_[i] = false;
+    }
+    num_running_workers_ = num_workers_;
+    backlog_start_ns_ = 0;
+    stats_enabled_.store(false);
+    worker_counters_ = new WorkerCounters[num_workers_];
+    for (int i = 0; i < num_workers_; i++) {
+      WorkerCounters& c = worker_counters_[i];
+      c.num_tasks.store(0);
+      c.num_steals.store(0);
+      c.busy_ns.store(0);
+      c.idle_ns.store(0);
+      c.steal_ns.store(0);
+      c.num_latency_samples.store(0);
+      c.latency_ns.store(0);
+      for (int j = 0; j < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; j++) {
+        c.run_time[j].store(0);
+        c.latency[j].store(0);
+      }
+    }
+    task_slots_ = new TaskSlot[THREAD_POOL_NUM_TASK_SLOTS];
+    free_task_slots_ = new LockFreeQueue<TaskSlot*>(THREAD_POOL_NUM_TASK_SLOTS);
+    for (int i = 0; i < THREAD_POOL_NUM_TASK_SLOTS; i++) {
+      task_slots_[i].free_slots = free_task_slots_;
+      free_task_slots_->enqueue(&task_slots_[i]);
+    }
     worker_ids_ = new std::thread[num_workers_];
     stopCB_many_ = MakeCallableMany(&ThreadPool::stop, this);
     stopCB_once_ = MakeCallableOnce(&ThreadPool::stop, this);
@@ -26,13 +183,162 @@ namespace threading {
     // Spawn the worker threads, worker threads are just themselves callbacks
     idle_worker_tasks_ = new Callback<void>*[num_workers_];
     for (int i = 0; i < num_workers_; i ++) {
-      Callback<void>* worker_callback_ =
-      MakeCallableOnce(&ThreadPool::workerMain, this, i);
+      Callback<void>* worker_callback_;
+      switch (mode_) {
+      case TP_WORK_STEALING:
+        worker_callback_ = 
+          MakeCallableOnce(&ThreadPool::workerMainWorkStealing, this, i);
+        break;
+      case TP_LOCK_FREE_QUEUE:
+        worker_callback_ = 
+          MakeCallableOnce(&ThreadPool::workerMainLockFree, this, i);
+        break;
+      default:
+        worker_callback_ = MakeCallableOnce(&ThreadPool::workerMain, this, i);
+        break;
+      }
       worker_ids_[i] = MakeThread(worker_callback_);
       idle_worker_tasks_[i] = NULL;
+      if (worker_cpu_[i] >= 0 &&
+        !SetThreadAffinity(&worker_ids_[i], worker_cpu_[i])) {
+        worker_cpu_[i] = -1;  // The worker's node is now only a guess
+      }
     }
     queue_lock_.unlock();
   }
+
+  // Fills in worker_cpu_ and worker_node_ (before any worker is started)
+  void ThreadPool::initPlacement(const ThreadPoolPlacement* placement) {
+    worker_cpu_ = new int[num_workers_];
+    worker_node_ = new int[num_workers_];
+    const int* cpus = NULL;
+    int num_cpus = 0;
+    int* core_cpus = NULL;
+    if (placement != NULL && placement->affinity == TP_AFFINITY_CPU_LIST) {
+      cpus = placement->cpus;
+      num_cpus = placement->num_cpus;
+    } else if (placement != NULL &&
+      placement->affinity == TP_AFFINITY_PHYSICAL_CORES) {
+      core_cpus = new int[GetNumCPUs()];
+      num_cpus = GetPhysicalCoreCPUs(core_cpus, GetNumCPUs());
+      cpus = core_cpus;
+    }
+    for (int i = 0; i < num_workers_; i++) {
+      worker_cpu_[i] = num_cpus > 0 ? cpus[i % num_cpus] : -1;
+      worker_node_[i] = num_cpus > 0 ? GetCPUNumaNode(worker_cpu_[i]) : 0;
+    }
+    delete[] core_cpus;
+  }
+
+  void ThreadPool::initWorkerThread(const int thread_index) {
+    char thread_name[32];
+    snprintf(thread_name, 32, "TPWorker-%d", thread_index);
+    SetThreadName(thread_name);
+  }
+
+  void ThreadPool::setElastic(const ThreadPoolElastic& elastic) {
+    if (mode_ != TP_SHARED_QUEUE) {
+      throw std::wruntime_error("ThreadPool::setElastic: Only supported in "
+        "TP_SHARED_QUEUE mode");
+    }
+    if (elastic.min_workers < 1 || elastic.idle_timeout_ms <= 0) {
+      throw std::wruntime_error("ThreadPool::setElastic: Bad settings");
+    }
+    if (elastic.min_workers > num_workers_ - num_reserved_workers_) {
+      throw std::wruntime_error("ThreadPool::setElastic: min_workers is more "
+        "than the number of unreserved workers");
+    }
+    std::unique_lock<std::mutex> unique_lock(queue_lock_);
+    elastic_ = elastic;
+    elastic_enabled_ = true;
+    // Idle workers go back to sleep with the new timeout
+    for (int i = 0; i < num_workers_; i++) {
+      worker_cvs_[i].notify_all();
+    }
+  }
+
+  int ThreadPool::numRunningWorkers() const {
+    std::unique_lock<std::mutex> unique_lock(queue_lock_);
+    return num_running_workers_;
+  }
+
+  void ThreadPool::setStatsEnabled(const bool enabled) {
+    stats_enabled_.store(enabled);
+  }
+
+  void ThreadPool::getStats(ThreadPoolStats* stats) const {
+    stats->queue_depth = count();
+    stats->workers.clear();
+    stats->workers.capacity(num_workers_);
+    stats->total.clear();
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    for (int i = 0; i < num_workers_; i++) {
+      const WorkerCounters& c = worker_counters_[i];
+      ThreadPoolWorkerStats worker;
+      worker.num_tasks = c.num_tasks.load(relaxed);
+      worker.num_steals = c.num_steals.load(relaxed);
+      worker.busy_ns = c.busy_ns.load(relaxed);
+      worker.idle_ns = c.idle_ns.load(relaxed);
+      worker.steal_ns = c.steal_ns.load(relaxed);
+      worker.num_latency_samples = c.num_latency_samples.load(relaxed);
+      worker.latency_ns = c.latency_ns.load(relaxed);
+      for (int j = 0; j < THREAD_POOL_HISTOGRAM_NUM_BUCKETS; j++) {
+        worker.run_time.buckets[j] = c.run_time[j].load(relaxed);
+        worker.latency.buckets[j] = c.latency[j].load(relaxed);
+      }
+      stats->workers.pushBack(worker);
+      stats->total.add(worker);
+    }
+  }
+
+  int64_t ThreadPool::statsStart() const {
+    return stats_enabled_.load(std::memory_order_relaxed) ? TimeNS() : 0;
+  }
+
+  void ThreadPool::statsAddIdle(const int thread_index,
+    const int64_t start_ns) {
+    if (start_ns != 0) {
+      StatsAdd(worker_counters_[thread_index].idle_ns,
+        TimeNS() - start_ns);
+    }
+  }
+
+  // Only the preallocated slots are recognised (heap slots aren't timed)
+  TaskSlot* ThreadPool::poolTaskSlot(Callback<void>* task) const {
+    const uintptr_t ptr = reinterpret_cast<uintptr_t>(task);
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(
+      static_cast<Callback<void>*>(&task_slots_[0]));
+    if (ptr < begin || ptr >= begin + THREAD_POOL_NUM_TASK_SLOTS *
+      sizeof(TaskSlot)) {
+      return NULL;
+    }
+    return &task_slots_[(ptr - begin) / sizeof(TaskSlot)];
+  }
+
+  void ThreadPool::runTask(const int thread_index, Callback<void>* task) {
+    JTIL_TRACE_SCOPE("ThreadPool::task");
+    if (!stats_enabled_.load(std::memory_order_relaxed)) {
+      (*task)();
+      return;
+    }
+    WorkerCounters& c = worker_counters_[thread_index];
+    const int64_t start_ns = TimeNS();
+    // Read the slot before running it (it is recycled once it starts)
+    TaskSlot* slot = poolTaskSlot(task);
+    if (slot != NULL && slot->enqueue_time_ns != 0) {
+      const int64_t latency_ns = start_ns - slot->enqueue_time_ns;
+      StatsAdd(c.num_latency_samples, static_cast<uint64_t>(1));
+      StatsAdd(c.latency_ns, latency_ns);
+      StatsAdd(c.latency[ThreadPoolHistogram::bucket(latency_ns)],
+        static_cast<uint64_t>(1));
+    }
+    (*task)();
+    const int64_t run_time_ns = TimeNS() - start_ns;
+    StatsAdd(c.num_tasks, static_cast<uint64_t>(1));
+    StatsAdd(c.busy_ns, run_time_ns);
+    StatsAdd(c.run_time[ThreadPoolHistogram::bucket(run_time_ns)],
+      static_cast<uint64_t>(1));
+  }
   
   // REQUIRES: stop() have completed executing. --> Class spec
   ThreadPool::~ThreadPool() {
@@ -49,17 +355,56 @@ namespace threading {
     // Now grab the lock and release data
     queue_lock_.lock();
     Callback<void>* p_cur_method;
-    while (!callback_queue_.empty()) {
-      p_cur_method = callback_queue_.dequeue();
-      if (p_cur_method->once()) {
-        delete p_cur_method;  // Delete only once callbacks
+    for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+      while (!callback_queues_[p].empty()) {
+        p_cur_method = callback_queues_[p].dequeue();
+        if (p_cur_method->once()) {
+          delete p_cur_method;  // Delete only once callbacks
+        }
+      }
+    }
+    if (worker_deques_) {
+      for (int i = 0; i < num_workers_ * TP_NUM_PRIORITIES; i++) {
+        while (worker_deques_[i]->pop(p_cur_method)) {
+          if (p_cur_method->once()) {
+            delete p_cur_method;
+          }
+        }
+        delete worker_deques_[i];
       }
+      delete[] worker_deques_;
+      delete[] worker_rand_state_;
+      delete[] worker_steal_order_;
+      delete[] worker_num_local_;
     }
+    if (mode_ == TP_LOCK_FREE_QUEUE) {
+      for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+        while (lf_task_queues_[p]->dequeue(p_cur_method)) {
+          if (p_cur_method->once()) {
+            delete p_cur_method;
+          }
+        }
+        delete lf_task_queues_[p];
+        delete lf_idle_worker_queues_[p];
+      }
+      delete[] worker_locks_;
+      delete[] worker_woken_;
+      delete[] worker_busy_;
+    }
+    // Any slots still queued were not once callbacks, they go with the array
+    delete[] task_slots_;
+    delete free_task_slots_;
     delete stopCB_many_;
     delete stopCB_once_;
     delete[] worker_ids_;
     delete[] worker_cvs_;
     delete[] idle_worker_tasks_;
+    delete[] worker_priority_;
+    delete[] worker_cpu_;
+    delete[] worker_node_;
+    delete[] worker_counters_;
+    delete[] worker_running_;
+    delete[] worker_idle_;
     queue_lock_.unlock();
   }
   
@@ -85,7 +430,18 @@ namespace threading {
     for (int i = 0; i < num_workers_; i ++) {
       worker_cvs_[i].notify_all();
     }
+    work_cv_.notify_all();
     queue_lock_.unlock();
+    // Let the lock-free adds that got in before us finish queuing
+    while (num_adding_.load() > 0) {
+      std::this_thread::yield();
+    }
+    if (worker_locks_) {
+      for (int i = 0; i < num_workers_; i ++) {
+        std::unique_lock<std::mutex> worker_lock(worker_locks_[i]);
+        worker_cvs_[i].notify_all();
+      }
+    }
     
     // Wait for worker threads to finish
     for (int i = 0; i < num_workers_; i ++) {
@@ -104,72 +460,567 @@ namespace threading {
     stop_finished_lock_.unlock();
   }
   
-  void ThreadPool::addTask(Callback<void>* task) {
-    // Get queue lock, enqueue the task then release lock
+  bool ThreadPool::addTask(Callback<void>* task,
+    const ThreadPoolPriority priority) {
+    return addTasks(&task, 1, priority);
+  }
+  
+  bool ThreadPool::addTasks(Callback<void>** tasks, const int n,
+    const ThreadPoolPriority priority) {
+    if (n <= 0) {
+      return true;
+    }
+    if (mode_ == TP_WORK_STEALING) {
+      return addTasksWorkStealing(tasks, n, priority);
+    } else if (mode_ == TP_LOCK_FREE_QUEUE) {
+      return addTasksLockFree(tasks, n, priority);
+    }
     queue_lock_.lock();
-    
-    // Check for idle workers, and wake up the worker if it is idle
-    if (!stop_called_ && !idle_worker_queue_.empty()) {
-      int idle_worker = idle_worker_queue_.dequeue();
-      idle_worker_tasks_[idle_worker] = task;
+    if (stop_called_) {  // stop() sets it under this lock: no race
+      queue_lock_.unlock();
+      rejectTasks(tasks, n);
+      return false;
+    }
+    // Hand out as many tasks as there are idle workers, queue the rest
+    int i = 0;
+    int idle_worker;
+    while (i < n && (idle_worker = dequeueIdleWorker(priority)) >= 0) {
+      idle_worker_tasks_[idle_worker] = tasks[i];
       worker_cvs_[idle_worker].notify_all();
-    } else {
-      // Otherwise add the queue to the task and someone will pick it up.
-      callback_queue_.enqueue(task);
+      i++;
+    }
+    std::thread retired;
+    if (i < n) {
+      for (; i < n; i++) {
+        callback_queues_[priority].enqueue(tasks[i]);
+      }
+      retired = growIfBacklogged(priority);
     }
     queue_lock_.unlock();
+    if (retired.joinable()) {
+      retired.join();
+    }
+    return true;
+  }
+
+  // Returns -1 if no idle worker can run 'priority' tasks.  Reserved workers
+  // are preferred so that the unreserved ones stay free for everything else.
+  int ThreadPool::dequeueIdleWorker(const int priority) {
+    for (int p = priority; p >= 0; p--) {
+      if (!idle_worker_queues_[p].empty()) {
+        const int worker = idle_worker_queues_[p].dequeue();
+        worker_idle_[worker] = false;
+        return worker;
+      }
+    }
+    return -1;
+  }
+
+  // O(num idle workers), only used when a worker retires
+  void ThreadPool::removeIdleWorker(const int thread_index) {
+    CallbackQueue<int>& queue = idle_worker_queues_[
+      worker_priority_[thread_index]];
+    const int num_idle = queue.size();
+    for (int i = 0; i < num_idle; i++) {
+      const int worker = queue.dequeue();
+      if (worker != thread_index) {
+        queue.enqueue(worker);
+      }
+    }
+    worker_idle_[thread_index] = false;
+  }
+
+  // Reserved workers never retire, so min_workers is checked against the
+  // running unreserved workers only
+  bool ThreadPool::canRetire(const int thread_index) const {
+    return elastic_enabled_ && !stop_called_ &&
+      worker_priority_[thread_index] == TP_PRIORITY_LOW &&
+      num_running_workers_ - num_reserved_workers_ > elastic_.min_workers;
+  }
+
+  bool ThreadPool::hasRunningWorker(const int priority) const {
+    for (int i = 0; i < num_workers_; i++) {
+      if (worker_running_[i] && worker_priority_[i] <= priority) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Starts one retired worker if nothing running can take 'priority' tasks
+  // (which were just queued) or if the queue is backing up
+  std::thread ThreadPool::growIfBacklogged(const int priority) {
+    if (!elastic_enabled_ || stop_called_) {
+      return std::thread();
+    }
+    int num_queued = 0;
+    for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+      num_queued += callback_queues_[p].size();
+    }
+    if (num_queued == 0 || num_running_workers_ == num_workers_) {
+      backlog_start_ns_ = 0;
+      return std::thread();
+    }
+    const int64_t now_ns = TimeNS();
+    if (backlog_start_ns_ == 0) {
+      backlog_start_ns_ = now_ns;
+    }
+    if (!hasRunningWorker(priority) || 
+      num_queued > elastic_.grow_queue_depth ||
+      now_ns - backlog_start_ns_ > 1000 * elastic_.grow_latency_us) {
+      backlog_start_ns_ = now_ns;  // Give the new worker a chance to catch up
+      // Only unreserved workers retire, and they can run anything
+      for (int i = 0; i < num_workers_; i++) {
+        if (!worker_running_[i]) {
+          return startWorker(i);
+        }
+      }
+    }
+    return std::thread();
+  }
+
+  std::thread ThreadPool::startWorker(const int thread_index) {
+    // The retired thread has already released the lock and is on its way
+    // out, but joining it here would hold up everyone waiting on queue_lock_
+    std::thread retired(std::move(worker_ids_[thread_index]));
+    worker_running_[thread_index] = true;
+    num_running_workers_++;
+    worker_ids_[thread_index] = MakeThread(MakeCallableOnce(
+      &ThreadPool::workerMain, this, thread_index));
+    if (worker_cpu_[thread_index] >= 0) {
+      SetThreadAffinity(&worker_ids_[thread_index], worker_cpu_[thread_index]);
+    }
+    return retired;
+  }
+
+  Callback<void>* ThreadPool::dequeueShared(const int min_priority) {
+    for (int p = TP_NUM_PRIORITIES - 1; p >= min_priority; p--) {
+      if (!callback_queues_[p].empty()) {
+        return callback_queues_[p].dequeue();
+      }
+    }
+    return NULL;
+  }
+
+  TaskSlot* ThreadPool::getTaskSlot(const Task& task) {
+    TaskSlot* slot;
+    if (!free_task_slots_->dequeue(slot)) {
+      slot = new TaskSlot();  // Every slot is in flight: use the heap
+    }
+    slot->task = task;
+    slot->enqueue_time_ns = statsStart();
+    return slot;
+  }
+
+  void ThreadPool::rejectTasks(Callback<void>** tasks, const int n) {
+    for (int i = 0; i < n; i++) {
+      TaskSlot* slot = poolTaskSlot(tasks[i]);
+      if (slot != NULL) {
+        free_task_slots_->enqueue(slot);
+      } else if (tasks[i]->once()) {
+        delete tasks[i];
+      }
+    }
+  }
+
+  bool ThreadPool::addTask(const Task& task,
+    const ThreadPoolPriority priority) {
+    return addTask(getTaskSlot(task), priority);
+  }
+
+  bool ThreadPool::addTasks(const Task* tasks, const int n,
+    const ThreadPoolPriority priority) {
+    Callback<void>* slots[THREAD_POOL_ADD_TASKS_BATCH_SIZE];
+    for (int i = 0; i < n; i += THREAD_POOL_ADD_TASKS_BATCH_SIZE) {
+      const int batch_size = std::min<int>(n - i,
+        THREAD_POOL_ADD_TASKS_BATCH_SIZE);
+      for (int j = 0; j < batch_size; j++) {
+        slots[j] = getTaskSlot(tasks[i + j]);
+      }
+      if (!addTasks(slots, batch_size, priority)) {
+        return false;
+      }
+    }
+    return true;
   }
   
   int ThreadPool::count() const {
+    if (mode_ == TP_WORK_STEALING) {
+      return numPendingWorkStealing(TP_PRIORITY_LOW);
+    } else if (mode_ == TP_LOCK_FREE_QUEUE) {
+      int count_val = num_shared_pending_.load();
+      for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+        count_val += static_cast<int>(lf_task_queues_[p]->size());
+      }
+      return count_val;
+    }
     queue_lock_.lock();
-    int count_val = callback_queue_.size();
+    int count_val = 0;
+    for (int p = 0; p < TP_NUM_PRIORITIES; p++) {
+      count_val += callback_queues_[p].size();
+    }
     queue_lock_.unlock();
     return count_val;
   }
   
   void ThreadPool::workerMain(int thread_index) {
-    char thread_name[32];
-    snprintf(thread_name, 32, "ThreadPool::workerMain - %d", thread_index);
-    SetThreadName(thread_name);
+    initWorkerThread(thread_index);
+    const int min_priority = worker_priority_[thread_index];
     std::unique_lock<std::mutex> unique_lock(queue_lock_);
     // When in the loop we have the lock, unless otherwise noted
     while (!stop_called_) {
-      // Check if any remaining tasks are queued
-      if (callback_queue_.empty()) {
-        idle_worker_queue_.enqueue(thread_index);  // Go onto the idle list
-        worker_cvs_[thread_index].wait(unique_lock);
+      // Check if any remaining tasks (that we may run) are queued
+      Callback<void>* taskBody = dequeueShared(min_priority);
+      if (taskBody == NULL) {
+        // Go onto the idle list (unless we're still on it after a spurious
+        // or timed out wake up)
+        if (!worker_idle_[thread_index]) {
+          idle_worker_queues_[min_priority].enqueue(thread_index);
+          worker_idle_[thread_index] = true;
+        }
+        const int64_t idle_start_ns = statsStart();
+        bool timed_out = false;
+        if (canRetire(thread_index)) {
+          timed_out = worker_cvs_[thread_index].wait_for(unique_lock,
+            std::chrono::milliseconds(elastic_.idle_timeout_ms)) ==
+            std::cv_status::timeout;
+        } else {
+          worker_cvs_[thread_index].wait(unique_lock);
+        }
+        statsAddIdle(thread_index, idle_start_ns);
         // If we were woken, then there must be a task waiting for us (unless
         // a stop was called).
+        if (!idle_worker_tasks_[thread_index] && timed_out &&
+          canRetire(thread_index)) {
+          removeIdleWorker(thread_index);
+          worker_running_[thread_index] = false;
+          num_running_workers_--;
+          break;  // Joined by whoever restarts us (or by stop())
+        }
         if (idle_worker_tasks_[thread_index]) {
           unique_lock.unlock();
           // Manipulating idle_worker_tasks_ outside the lock is safe since
           // addTask wont update unless the worker thread is on the wait queue
           // (which it cannot be at this point).
-          (*idle_worker_tasks_[thread_index])();
+          runTask(thread_index, idle_worker_tasks_[thread_index]);
           idle_worker_tasks_[thread_index] = NULL;
           unique_lock.lock();
         }
       } else {
-        // Otherwise, dequeue a task and execute it
-        Callback<void>* taskBody = callback_queue_.dequeue();
+        // Otherwise, execute the dequeued task (and get help if the queue
+        // is still backed up)
+        std::thread retired = growIfBacklogged(min_priority);
         // THREAD DOESN'T HAVE LOCK HERE
         // This structure was the result of a conversation with Prof. Lerner.
         // Want to avoid race condition between stop and destructor.
         // Prof. Lerner: "If you do a == b, it will be comparing the pointers,
         // both for TP::stop() and for the tp instance for you."
         unique_lock.unlock();
+        if (retired.joinable()) {
+          retired.join();
+        }
         if ((taskBody == stopCB_once_) ||
             (taskBody == stopCB_many_)) {
           (*taskBody)();
           return;  // Return without touching tp (may have been destroyed!)
         } else {
-          (*taskBody)();
+          runTask(thread_index, taskBody);
         }
         unique_lock.lock();  // RE-ACQUIRE LOCK before iterating again
       }
     }
     unique_lock.unlock();
   }
+
+  bool ThreadPool::addTasksWorkStealing(Callback<void>** tasks, const int n,
+    const ThreadPoolPriority priority) {
+    if (cur_thread_pool_ == this) {
+      // We're on one of our own workers: push onto its deque (no lock).
+      if (!beginLockFreeAdd()) {
+        rejectTasks(tasks, n);
+        return false;
+      }
+      WorkStealingDeque<Callback<void>*>* deque =
+        worker_deques_[cur_thread_index_ * TP_NUM_PRIORITIES + priority];
+      for (int i = 0; i < n; i++) {
+        deque->push(tasks[i]);
+      }
+      num_pending_[priority].fetch_add(n);
+      if (num_sleeping_.load() > 0) {
+        // Take the lock so that a worker cannot miss the notification between
+        // checking num_pending_ and waiting on the cv.
+        std::unique_lock<std::mutex> unique_lock(queue_lock_);
+        notifyWorkStealing(n);
+      }
+      num_adding_.fetch_sub(1);
+    } else {
+      std::unique_lock<std::mutex> unique_lock(queue_lock_);
+      if (stop_called_) {
+        unique_lock.unlock();
+        rejectTasks(tasks, n);
+        return false;
+      }
+      for (int i = 0; i < n; i++) {
+        callback_queues_[priority].enqueue(tasks[i]);
+      }
+      num_shared_pending_.fetch_add(n);
+      num_pending_[priority].fetch_add(n);
+      if (num_sleeping_.load() > 0) {
+        notifyWorkStealing(n);
+      }
+    }
+    return true;
+  }
+
+  // Adds that don't take queue_lock_ announce themselves in num_adding_ before
+  // checking stop_called_, and stop() sets stop_called_ before waiting for
+  // num_adding_ to drain (both seq_cst).  So either the add sees the stop and
+  // rejects its tasks, or stop() waits until they are queued, just as if the
+  // add had taken queue_lock_.  Returns false (not announced) on a stop.
+  bool ThreadPool::beginLockFreeAdd() {
+    num_adding_.fetch_add(1);
+    if (stop_called_.load()) {
+      num_adding_.fetch_sub(1);
+      return false;
+    }
+    return true;
+  }
+
+  void ThreadPool::notifyWorkStealing(const int n) {
+    // A woken reserved worker might not be allowed to run the new tasks, so
+    // with reservations everyone is woken
+    if (has_reserved_workers_ || n >= num_sleeping_.load()) {
+      work_cv_.notify_all();
+    } else {
+      for (int i = 0; i < n; i++) {
+        work_cv_.notify_one();
+      }
+    }
+  }
+
+  int ThreadPool::numPendingWorkStealing(const int min_priority) const {
+    int num_pending = 0;
+    for (int p = min_priority; p < TP_NUM_PRIORITIES; p++) {
+      num_pending += num_pending_[p].load();
+    }
+    return num_pending;
+  }
+
+  Callback<void>* ThreadPool::findTaskWorkStealing(const int thread_index,
+    int* priority) {
+    Callback<void>* task = NULL;
+    // Lanes from highest to lowest, stopping at our reservation
+    for (int p = TP_NUM_PRIORITIES - 1; p >= worker_priority_[thread_index];
+      p--) {
+      if (num_pending_[p].load() == 0) {
+        continue;
+      }
+      *priority = p;
+      // 1. Our own deque (LIFO: the most recently pushed task is cache hot)
+      if (worker_deques_[thread_index * TP_NUM_PRIORITIES + p]->pop(task)) {
+        return task;
+      }
+      // 2. Tasks added by threads outside the pool
+      if (num_shared_pending_.load() > 0) {
+        std::unique_lock<std::mutex> unique_lock(queue_lock_);
+        if (!callback_queues_[p].empty()) {
+          num_shared_pending_.fetch_sub(1);
+          return callback_queues_[p].dequeue();
+        }
+      }
+      // 3. Steal (FIFO) from a random victim on our NUMA node, then sweep
+      // the rest of the node in order, then the same for the other nodes
+      if (num_workers_ > 1) {
+        uint32_t& x = worker_rand_state_[thread_index];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        const int* order = &worker_steal_order_[thread_index *
+          (num_workers_ - 1)];
+        const int num_local = worker_num_local_[thread_index];
+        const int num_remote = num_workers_ - 1 - num_local;
+        const int64_t steal_start_ns = statsStart();
+        bool stolen = false;
+        for (int i = 0; i < num_local && !stolen; i++) {
+          const int victim = order[(x + i) % num_local];
+          stolen = worker_deques_[victim * TP_NUM_PRIORITIES + p]->steal(task);
+        }
+        for (int i = 0; i < num_remote && !stolen; i++) {
+          const int victim = order[num_local + (x + i) % num_remote];
+          stolen = worker_deques_[victim * TP_NUM_PRIORITIES + p]->steal(task);
+        }
+        if (steal_start_ns != 0) {
+          WorkerCounters& c = worker_counters_[thread_index];
+          StatsAdd(c.steal_ns, TimeNS() - steal_start_ns);
+          StatsAdd(c.num_steals, static_cast<uint64_t>(stolen ? 1 : 0));
+        }
+        if (stolen) {
+          return task;
+        }
+      }
+    }
+    return NULL;
+  }
+
+  void ThreadPool::workerMainWorkStealing(int thread_index) {
+    initWorkerThread(thread_index);
+    cur_thread_pool_ = this;
+    cur_thread_index_ = thread_index;
+    const int min_priority = worker_priority_[thread_index];
+    while (!stop_called_) {
+      int priority;
+      Callback<void>* taskBody = findTaskWorkStealing(thread_index, &priority);
+      if (taskBody != NULL) {
+        num_pending_[priority].fetch_sub(1);
+        if ((taskBody == stopCB_once_) || (taskBody == stopCB_many_)) {
+          (*taskBody)();
+          return;  // Return without touching tp (may have been destroyed!)
+        }
+        runTask(thread_index, taskBody);
+      } else if (numPendingWorkStealing(min_priority) > 0) {
+        // Someone else is about to run the remaining task(s) (or we lost a
+        // steal race), don't sleep yet.
+        std::this_thread::yield();
+      } else {
+        std::unique_lock<std::mutex> unique_lock(queue_lock_);
+        num_sleeping_.fetch_add(1);
+        const int64_t idle_start_ns = statsStart();
+        while (numPendingWorkStealing(min_priority) == 0 && !stop_called_) {
+          work_cv_.wait(unique_lock);
+        }
+        statsAddIdle(thread_index, idle_start_ns);
+        num_sleeping_.fetch_sub(1);
+      }
+    }
+  }
+
+  bool ThreadPool::addTasksLockFree(Callback<void>** tasks, const int n,
+    const ThreadPoolPriority priority) {
+    if (!beginLockFreeAdd()) {
+      rejectTasks(tasks, n);
+      return false;
+    }
+    LockFreeQueue<Callback<void>*>* queue = lf_task_queues_[priority];
+    int i = 0;
+    while (i < n && queue->enqueue(tasks[i])) {
+      i++;
+    }
+    if (i < n) {
+      // The queue is full, overflow onto the locked queue
+      std::unique_lock<std::mutex> unique_lock(queue_lock_);
+      num_shared_pending_.fetch_add(n - i);
+      for (; i < n; i++) {
+        callback_queues_[priority].enqueue(tasks[i]);
+      }
+    }
+    // The fence pairs with the one in workerMainLockFree: either we see the
+    // worker on the idle queue, or the worker sees our task when it re-checks.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wakeIdleWorkersLockFree(priority, n);
+    num_adding_.fetch_sub(1);  // Only now may stop() go on
+    return true;
+  }
+
+  // A worker that found a task by itself after going on the idle queue is
+  // still on it (the queue can't remove from the middle) but marked busy.
+  // Its entry is stale: drop it, the worker re-queues itself once idle.
+  void ThreadPool::wakeIdleWorkersLockFree(const int priority, const int n) {
+    int num_woken = 0;
+    int idle_worker;
+    while (num_woken < n && dequeueIdleWorkerLockFree(priority, idle_worker)) {
+      std::unique_lock<std::mutex> worker_lock(worker_locks_[idle_worker]);
+      worker_woken_[idle_worker] = true;  // Off the idle queue either way
+      if (!worker_busy_[idle_worker]) {
+        worker_cvs_[idle_worker].notify_one();
+        num_woken++;
+      }
+    }
+  }
+
+  // Same preference as dequeueIdleWorker()
+  bool ThreadPool::dequeueIdleWorkerLockFree(const int priority,
+    int& worker) {
+    for (int p = priority; p >= 0; p--) {
+      if (lf_idle_worker_queues_[p]->dequeue(worker)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Callback<void>* ThreadPool::findTaskLockFree(const int min_priority) {
+    Callback<void>* task = NULL;
+    for (int p = TP_NUM_PRIORITIES - 1; p >= min_priority; p--) {
+      if (lf_task_queues_[p]->dequeue(task)) {
+        return task;
+      }
+      if (num_shared_pending_.load() > 0) {
+        std::unique_lock<std::mutex> unique_lock(queue_lock_);
+        if (!callback_queues_[p].empty()) {
+          num_shared_pending_.fetch_sub(1);
+          return callback_queues_[p].dequeue();
+        }
+      }
+    }
+    return NULL;
+  }
+
+  void ThreadPool::workerMainLockFree(int thread_index) {
+    initWorkerThread(thread_index);
+    // on_idle_queue is true from when we enqueue ourselves on the idle queue
+    // until addTask dequeues us (and sets worker_woken_).
+    bool on_idle_queue = false;
+    const int min_priority = worker_priority_[thread_index];
+    while (!stop_called_) {
+      Callback<void>* taskBody = findTaskLockFree(min_priority);
+      if (taskBody == NULL && !on_idle_queue) {
+        lf_idle_worker_queues_[min_priority]->enqueue(thread_index);
+        on_idle_queue = true;
+        // Re-check: addTask may have enqueued before it could see us as idle.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        taskBody = findTaskLockFree(min_priority);
+      }
+      if (taskBody != NULL) {
+        if (on_idle_queue) {
+          // Still on the idle queue: mark our entry stale so that addTask
+          // wakes someone else rather than queue behind this task
+          std::unique_lock<std::mutex> worker_lock(
+            worker_locks_[thread_index]);
+          if (worker_woken_[thread_index]) {
+            // Already dequeued.  If we weren't busy yet, that addTask
+            // counted on us for one of its tasks: pass the wake up on.
+            const bool pass_on = !worker_busy_[thread_index];
+            worker_woken_[thread_index] = false;
+            worker_busy_[thread_index] = false;
+            on_idle_queue = false;
+            worker_lock.unlock();
+            if (pass_on) {
+              wakeIdleWorkersLockFree(min_priority, 1);
+            }
+          } else {
+            worker_busy_[thread_index] = true;
+          }
+        }
+        if ((taskBody == stopCB_once_) || (taskBody == stopCB_many_)) {
+          (*taskBody)();
+          return;  // Return without touching tp (may have been destroyed!)
+        }
+        runTask(thread_index, taskBody);
+      } else {
+        std::unique_lock<std::mutex> worker_lock(worker_locks_[thread_index]);
+        worker_busy_[thread_index] = false;  // Our entry is good again
+        const int64_t idle_start_ns = statsStart();
+        while (!worker_woken_[thread_index] && !stop_called_) {
+          worker_cvs_[thread_index].wait(worker_lock);
+        }
+        statsAddIdle(thread_index, idle_start_ns);
+        if (worker_woken_[thread_index]) {
+          worker_woken_[thread_index] = false;
+          on_idle_queue = false;
+        }
+      }
+    }
+  }
   
 }  // namespace threading
 }  // namespace jtil
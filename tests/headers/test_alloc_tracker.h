@@ -0,0 +1,144 @@
+//
+//  test_alloc_tracker.h
+//
+
+#include <thread>
+#include <sstream>
+#include <string>
+#include "test_unit/test_unit.h"
+#include "jtil/debug_util/alloc_tracker.h"
+#include "jtil/string_util/macros.h"  // For JTIL_NOINLINE
+
+using jtil::debug::AllocTracker;
+using jtil::debug::AllocScope;
+using jtil::debug::AllocStats;
+
+void TestAllocTrackerNewDelete(const int num, const int size) {
+  for (int i = 0; i < num; i++) {
+    char* ptr = new char[size];
+    tests::DoNotOptimize(ptr);
+    delete[] ptr;
+  }
+}
+
+JTIL_NOINLINE void TestAllocTrackerCallSite() {
+  TestAllocTrackerNewDelete(10, 4096);
+}
+
+TEST(AllocTracker, ScopeCounts) {
+  const bool was_enabled = AllocTracker::enabled();
+  AllocTracker::enable();
+  AllocTracker::clear();
+  AllocStats global0, global1;
+  AllocTracker::getStats(&global0);
+  AllocStats outer_stats, inner_stats;
+  {
+    AllocScope outer("TestAllocTrackerOuter");
+    TestAllocTrackerNewDelete(3, 100);
+    {
+      AllocScope inner("TestAllocTrackerInner");
+      int* ptrs[4];
+      for (int i = 0; i < 4; i++) {
+        ptrs[i] = new int[1000];
+        tests::DoNotOptimize(ptrs[i]);
+      }
+      for (int i = 0; i < 4; i++) {
+        delete[] ptrs[i];
+      }
+      inner_stats = inner.stats();
+    }
+    // Another thread's allocations don't count in this scope
+    std::thread thread(&TestAllocTrackerNewDelete, 5, 100);
+    thread.join();
+    outer_stats = outer.stats();
+  }
+  AllocTracker::getStats(&global1);
+  if (AllocTracker::supported()) {
+    EXPECT_EQ(inner_stats.num_allocs, 4);
+    EXPECT_EQ(inner_stats.num_frees, 4);
+    EXPECT_TRUE(inner_stats.bytes_allocated >= 4 * 1000 * sizeof(int));
+    EXPECT_EQ(inner_stats.bytes_allocated, inner_stats.bytes_freed);
+    // All 4 were live at once
+    EXPECT_EQ(inner_stats.peak_bytes,
+      static_cast<int64_t>(inner_stats.bytes_allocated));
+    // The thread's own allocations (std::thread may allocate its state)
+    EXPECT_TRUE(outer_stats.num_allocs >= 7 && outer_stats.num_allocs <= 9);
+    EXPECT_TRUE(outer_stats.peak_bytes >= inner_stats.peak_bytes);
+    EXPECT_TRUE(global1.num_allocs - global0.num_allocs >= 12);
+    EXPECT_TRUE(global1.peak_bytes >= inner_stats.peak_bytes);
+
+    std::stringstream ss;
+    AllocTracker::printReport(ss);
+    const std::string report = ss.str();
+    EXPECT_TRUE(report.find("TestAllocTrackerOuter: 1 scopes") !=
+      std::string::npos);
+    EXPECT_TRUE(report.find("TestAllocTrackerInner: 1 scopes, 4 allocs") !=
+      std::string::npos);
+  } else {
+    EXPECT_EQ(inner_stats.num_allocs, 0);
+    EXPECT_EQ(global1.num_allocs, 0);
+  }
+
+  // Disabled, nothing is counted
+  AllocTracker::disable();
+  AllocTracker::getStats(&global0);
+  {
+    AllocScope scope("TestAllocTrackerDisabled");
+    TestAllocTrackerNewDelete(3, 100);
+    EXPECT_EQ(scope.stats().num_allocs, 0);
+  }
+  AllocTracker::getStats(&global1);
+  EXPECT_EQ(global1.num_allocs, global0.num_allocs);
+  if (was_enabled) {
+    AllocTracker::enable();
+  }
+}
+
+TEST(AllocTracker, CallSites) {
+  const bool was_enabled = AllocTracker::enabled();
+  AllocTracker::clear();
+  AllocTracker::enable(true);
+  TestAllocTrackerCallSite();
+  AllocTracker::enable(false);
+  std::stringstream ss;
+  AllocTracker::printReport(ss, 1);
+  const std::string report = ss.str();
+  if (AllocTracker::supported()) {
+    // The biggest site: 10 allocations of at least 4096 bytes
+    EXPECT_TRUE(report.find("Top call sites by bytes:\n  10 allocs (") !=
+      std::string::npos);
+  }
+  AllocTracker::clear();
+  if (!was_enabled) {
+    AllocTracker::disable();
+  }
+}
+
+// A block allocated before enable() and freed after it doesn't cancel out
+// one that is still live
+TEST(AllocTracker, LiveAllocations) {
+  const bool was_enabled = AllocTracker::enabled();
+  AllocTracker::disable();
+  char* before = new char[100];
+  tests::DoNotOptimize(before);
+  AllocTracker::enable();
+  const int64_t live0 = AllocTracker::liveAllocations();
+  AllocStats global0, global1;
+  AllocTracker::getStats(&global0);
+  delete[] before;
+  char* leaked = new char[100];
+  tests::DoNotOptimize(leaked);
+  const int64_t live1 = AllocTracker::liveAllocations();
+  AllocTracker::getStats(&global1);
+  if (AllocTracker::supported()) {
+    EXPECT_EQ(live1 - live0, 1);
+    EXPECT_EQ(global1.num_frees, global0.num_frees);
+  }
+  // Its free is counted after disable() too
+  AllocTracker::disable();
+  delete[] leaked;
+  EXPECT_EQ(AllocTracker::liveAllocations(), live0);
+  if (was_enabled) {
+    AllocTracker::enable();
+  }
+}
@@ -0,0 +1,155 @@
+//
+//  test_async_io.h
+//
+
+#include <stdio.h>  // For remove()
+#include <atomic>
+#include <sstream>
+#include <string>
+#include "test_unit/test_unit.h"
+#include "jtil/file_io/async_io.h"
+#include "jtil/file_io/file_io.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/callback.h"
+
+#define TEST_AIO_NUM_FILES 20
+#define TEST_AIO_FILE_SIZE 1000  // ints
+#define TEST_AIO_BIG_FILE_SIZE (3 * ASYNC_IO_CHUNK_SIZE / 4 + 17)  // ints
+
+using jtil::file_io::AsyncIO;
+using jtil::file_io::AsyncIORequest;
+using jtil::file_io::ASYNC_IO_PREAD;
+using jtil::file_io::ASYNC_IO_URING;
+using jtil::threading::ThreadPool;
+using jtil::threading::MakeCallableMany;
+
+std::string TestAIOFilename(const int i) {
+  std::stringstream ss;
+  ss << "test_async_io_" << i << ".bin";
+  return ss.str();
+}
+
+// File i holds the ints i, i+1, ...
+void TestAIOWriteFile(const int i, const int size) {
+  int* arr = new int[size];
+  for (int j = 0; j < size; j++) {
+    arr[j] = i + j;
+  }
+  jtil::file_io::SaveArrayToFile(arr, size, TestAIOFilename(i));
+  delete[] arr;
+}
+
+int TestAIONumBad(AsyncIORequest* request, const int i, const int size) {
+  if (!request->ok() || request->size() != size * sizeof(int) ||
+    request->data()[request->size()] != 0) {
+    return 1;
+  }
+  const int* arr = reinterpret_cast<const int*>(request->data());
+  int num_bad = 0;
+  for (int j = 0; j < size; j++) {
+    num_bad += arr[j] != i + j ? 1 : 0;
+  }
+  return num_bad;
+}
+
+class TestAIODecoder {
+public:
+  TestAIODecoder() { num_bad.store(0); num_decoded.store(0); }
+  void decode(AsyncIORequest* request) {
+    // Still being completed, so done() is false in here
+    num_bad += request->done() ? 1 : 0;
+    const int i = atoi(request->filename().c_str() +
+      strlen("test_async_io_"));
+    num_bad += TestAIONumBad(request, i, TEST_AIO_FILE_SIZE);
+    num_decoded++;
+  }
+  std::atomic<int> num_bad;
+  std::atomic<int> num_decoded;
+};
+
+// Every backend reads the files back intact, with and without callbacks on
+// a pool, and reports missing files as errors.
+TEST(AsyncIO, ReadFiles) {
+  for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+    TestAIOWriteFile(i, TEST_AIO_FILE_SIZE);
+  }
+  TestAIOWriteFile(TEST_AIO_NUM_FILES, TEST_AIO_BIG_FILE_SIZE);
+  TestAIOWriteFile(TEST_AIO_NUM_FILES + 1, 0);
+
+  ThreadPool tp(4);
+  const jtil::file_io::AsyncIOBackend backends[] = {ASYNC_IO_PREAD,
+    ASYNC_IO_URING};
+  for (int b = 0; b < 2; b++) {
+    for (int use_tp = 0; use_tp < 2; use_tp++) {
+      TestAIODecoder decoder;
+      AsyncIO io(2, use_tp ? &tp : NULL, backends[b]);
+      EXPECT_TRUE(b == 0 ? io.backend() == ASYNC_IO_PREAD : true);
+      jtil::threading::Callback<void, AsyncIORequest*>* decode =
+        MakeCallableMany(&TestAIODecoder::decode, &decoder);
+      AsyncIORequest* requests[TEST_AIO_NUM_FILES];
+      for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+        requests[i] = io.read(TestAIOFilename(i), decode);
+      }
+      AsyncIORequest* big = io.read(TestAIOFilename(TEST_AIO_NUM_FILES));
+      AsyncIORequest* empty = io.read(TestAIOFilename(TEST_AIO_NUM_FILES + 1));
+      AsyncIORequest* missing = io.read("test_async_io_missing.bin");
+      int num_bad = 0;
+      for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+        requests[i]->wait();
+        num_bad += requests[i]->done() ? 0 : 1;
+        num_bad += TestAIONumBad(requests[i], i, TEST_AIO_FILE_SIZE);
+        delete requests[i];
+      }
+      big->wait();
+      num_bad += TestAIONumBad(big, TEST_AIO_NUM_FILES,
+        TEST_AIO_BIG_FILE_SIZE);
+      uint8_t* data = big->releaseData();
+      delete big;
+      delete[] data;
+      empty->wait();
+      num_bad += TestAIONumBad(empty, TEST_AIO_NUM_FILES + 1, 0);
+      delete empty;
+      missing->wait();
+      EXPECT_FALSE(missing->ok());
+      EXPECT_TRUE(missing->error().size() > 0);
+      delete missing;
+      EXPECT_EQ(num_bad, 0);
+      EXPECT_EQ(decoder.num_bad.load(), 0);
+      EXPECT_EQ(decoder.num_decoded.load(), TEST_AIO_NUM_FILES);
+      delete decode;
+    }
+  }
+  tp.stop();
+  for (int i = 0; i < TEST_AIO_NUM_FILES + 2; i++) {
+    remove(TestAIOFilename(i).c_str());
+  }
+}
+
+// A pool that has already been stopped rejects the callbacks, which then run
+// on the I/O threads (rather than never, leaving the requests waiting).
+TEST(AsyncIO, StoppedPool) {
+  for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+    TestAIOWriteFile(i, TEST_AIO_FILE_SIZE);
+  }
+  ThreadPool tp(2);
+  tp.stop();
+  TestAIODecoder decoder;
+  jtil::threading::Callback<void, AsyncIORequest*>* decode =
+    MakeCallableMany(&TestAIODecoder::decode, &decoder);
+  {
+    AsyncIO io(2, &tp);
+    AsyncIORequest* requests[TEST_AIO_NUM_FILES];
+    for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+      requests[i] = io.read(TestAIOFilename(i), decode);
+    }
+    for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+      delete requests[i];  // Waits for the callback
+    }
+  }
+  EXPECT_EQ(decoder.num_bad.load(), 0);
+  EXPECT_EQ(decoder.num_decoded.load(), TEST_AIO_NUM_FILES);
+  delete decode;
+  for (int i = 0; i < TEST_AIO_NUM_FILES; i++) {
+    remove(TestAIOFilename(i).c_str());
+  }
+}
@@ -0,0 +1,119 @@
+//
+//  test_async_io_profile.h
+//
+//  Load time of a "scene" of many files that each need some CPU decoding:
+//  serially with file_io::LoadArrayFromFile (how the library loads models
+//  and textures today) against AsyncIO reads whose callbacks decode on a
+//  ThreadPool.  The files were just written so they are likely in the page
+//  cache, which understates the gain on a cold disk.  The numbers are only
+//  printed.
+//
+
+#include <stdio.h>  // For remove()
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "test_unit/test_unit.h"
+#include "jtil/file_io/async_io.h"
+#include "jtil/file_io/file_io.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/callback.h"
+#include "jtil/clk/clk.h"
+
+#define PROFILE_AIO_NUM_FILES 200
+#define PROFILE_AIO_FILE_SIZE (64 * 1024)  // ints
+#define PROFILE_AIO_DECODE_PASSES 8  // ie, decompression + parsing
+#define PROFILE_AIO_NUM_WORKERS 4
+
+std::string ProfileAIOFilename(const int i) {
+  std::stringstream ss;
+  ss << "profile_async_io_" << i << ".bin";
+  return ss.str();
+}
+
+uint32_t ProfileAIODecode(const uint32_t* arr, const uint32_t size) {
+  uint32_t hash = 2166136261u;
+  for (int pass = 0; pass < PROFILE_AIO_DECODE_PASSES; pass++) {
+    for (uint32_t i = 0; i < size; i++) {
+      hash = (hash ^ arr[i]) * 16777619u;  // FNV-1a
+    }
+  }
+  return hash;
+}
+
+class ProfileAIODecoder {
+public:
+  ProfileAIODecoder() { checksum.store(0); num_bad.store(0); }
+  void decode(jtil::file_io::AsyncIORequest* request) {
+    if (!request->ok() ||
+      request->size() != PROFILE_AIO_FILE_SIZE * sizeof(uint32_t)) {
+      num_bad++;
+      return;
+    }
+    checksum += ProfileAIODecode(
+      reinterpret_cast<const uint32_t*>(request->data()),
+      PROFILE_AIO_FILE_SIZE);
+  }
+  std::atomic<uint32_t> checksum;
+  std::atomic<int> num_bad;
+};
+
+TEST(ProfileAsyncIO, SceneLoad) {
+  uint32_t* arr = new uint32_t[PROFILE_AIO_FILE_SIZE];
+  for (int i = 0; i < PROFILE_AIO_NUM_FILES; i++) {
+    for (uint32_t j = 0; j < PROFILE_AIO_FILE_SIZE; j++) {
+      arr[j] = i * PROFILE_AIO_FILE_SIZE + j;
+    }
+    jtil::file_io::SaveArrayToFile(arr, PROFILE_AIO_FILE_SIZE,
+      ProfileAIOFilename(i));
+  }
+  jtil::clk::Clk clk;
+
+  // Serial: load then decode, one file at a time
+  double t0 = clk.getTime();
+  uint32_t serial_checksum = 0;
+  for (int i = 0; i < PROFILE_AIO_NUM_FILES; i++) {
+    jtil::file_io::LoadArrayFromFile(arr, PROFILE_AIO_FILE_SIZE,
+      ProfileAIOFilename(i));
+    serial_checksum += ProfileAIODecode(arr, PROFILE_AIO_FILE_SIZE);
+  }
+  double t_serial = clk.getTime() - t0;
+  delete[] arr;
+
+  std::cout << std::endl;
+  std::cout << "  backend | serial load + decode (ms) | "
+    << "AsyncIO + ThreadPool decode (ms)" << std::endl;
+  const jtil::file_io::AsyncIOBackend backends[] = {
+    jtil::file_io::ASYNC_IO_PREAD, jtil::file_io::ASYNC_IO_URING};
+  jtil::threading::ThreadPool tp(PROFILE_AIO_NUM_WORKERS);
+  for (int b = 0; b < 2; b++) {
+    ProfileAIODecoder decoder;
+    jtil::threading::Callback<void, jtil::file_io::AsyncIORequest*>* decode =
+      jtil::threading::MakeCallableMany(&ProfileAIODecoder::decode, &decoder);
+    jtil::file_io::AsyncIORequest* requests[PROFILE_AIO_NUM_FILES];
+    t0 = clk.getTime();
+    {
+      jtil::file_io::AsyncIO io(2, &tp, backends[b]);
+      for (int i = 0; i < PROFILE_AIO_NUM_FILES; i++) {
+        requests[i] = io.read(ProfileAIOFilename(i), decode);
+      }
+      for (int i = 0; i < PROFILE_AIO_NUM_FILES; i++) {
+        requests[i]->wait();
+        delete requests[i];
+      }
+      std::cout << "  " << (io.backend() == jtil::file_io::ASYNC_IO_URING ?
+        "io_uring" : "pread") << " | ";
+    }
+    double t_async = clk.getTime() - t0;
+    std::cout << t_serial * 1000.0 << " | " << t_async * 1000.0 << std::endl;
+    EXPECT_EQ(decoder.num_bad.load(), 0);
+    EXPECT_EQ(decoder.checksum.load(), serial_checksum);
+    delete decode;
+  }
+  tp.stop();
+
+  for (int i = 0; i < PROFILE_AIO_NUM_FILES; i++) {
+    remove(ProfileAIOFilename(i).c_str());
+  }
+}
@@ -0,0 +1,46 @@
+//
+//  test_benchmark.h
+//
+//  The BENCHMARK harness in test_unit.
+//
+
+#include <vector>
+#include "test_unit/test_unit.h"
+
+using tests::BenchmarkResult;
+
+TEST(Benchmark, Stats) {
+  std::vector<double> ns;
+  for (int i = 100; i >= 1; i--) {
+    ns.push_back(static_cast<double>(i));
+  }
+  BenchmarkResult result;
+  result.computeStats(&ns, 2.0);
+  EXPECT_EQ(result.repetitions, 100);
+  EXPECT_EQ(result.min_ns, 1.0);
+  EXPECT_EQ(result.median_ns, 50.5);
+  EXPECT_EQ(result.p99_ns, 99.0);
+  EXPECT_EQ(result.mean_ns, 50.5);
+  EXPECT_EQ(result.items_per_sec, 2.0 * 1e9 / 50.5);
+
+  ns.clear();
+  ns.push_back(3.0);
+  ns.push_back(1.0);
+  ns.push_back(2.0);
+  result.computeStats(&ns, 0);
+  EXPECT_EQ(result.median_ns, 2.0);
+  EXPECT_EQ(result.p99_ns, 3.0);
+  EXPECT_EQ(result.items_per_sec, 0);
+}
+
+// Scales up from a single iteration, so the body must see more than one
+BENCHMARK(Benchmark, SumLoop) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    sum += i;
+    tests::DoNotOptimize(sum);
+  }
+  tests::ClobberMemory();
+  EXPECT_EQ(sum, state.iterations() * (state.iterations() - 1) / 2);
+  state.setItemsPerIteration(1);
+}
@@ -8,12 +8,15 @@
 //  the test unit stuff.
 
 #include "jtil/threading/callback.h"
+#include "jtil/threading/task.h"
 #include "test_unit/test_unit.h"
 #include "test_unit/test_util.h"
 
 using jtil::threading::Callback;
 using jtil::threading::MakeCallableOnce;
 using jtil::threading::MakeCallableMany;
+using jtil::threading::Task;
+using jtil::threading::MakeTask;
 using tests::Counter;
 
 TEST(Once, Simple) {
@@ -72,3 +75,40 @@ TEST(Many, Simple) {
   EXPECT_EQ(c.count(), 2);
   delete cb;
 }
+
+// A functor small enough to be stored in a Task
+struct TaskIncBy {
+  TaskIncBy(Counter* c, int i) : c(c), i(i) { }
+  void operator()() { c->incBy(i); }
+  Counter* c;
+  int i;
+};
+
+TEST(Task, MemberAndFunctor) {
+  Counter c;
+  Task empty_task;
+  EXPECT_TRUE(empty_task.empty());
+
+  Task t1 = MakeTask(&Counter::inc, &c);
+  EXPECT_FALSE(t1.empty());
+  t1();
+  t1();
+  EXPECT_EQ(c.count(), 2);
+
+  // Bound arguments are copied into the task (and so are the tasks)
+  Task t2 = MakeTask(&Counter::incBy, &c, 3);
+  Task t3 = t2;
+  t2();
+  t3();
+  EXPECT_EQ(c.count(), 8);
+
+  // Non-void return values are ignored
+  c.set(7);
+  Task t4 = MakeTask(&Counter::between, &c, 5, 10);
+  t4();
+  EXPECT_EQ(c.count(), 7);
+
+  Task t5 = MakeTask(TaskIncBy(&c, 5));
+  t5();
+  EXPECT_EQ(c.count(), 12);
+}
@@ -0,0 +1,58 @@
+//
+//  test_clk.h
+//
+
+#include <math.h>
+#include <thread>
+#include "test_unit/test_unit.h"
+#include "jtil/clk/clk.h"
+
+using jtil::clk::Clk;
+using jtil::clk::CLK_SOURCE_OS;
+using jtil::clk::CLK_SOURCE_TSC;
+
+#define TEST_CLK_SLEEP_MS 20
+
+TEST(Clk, ElapsedTime) {
+  const jtil::clk::ClkSource sources[] = {CLK_SOURCE_OS, CLK_SOURCE_TSC};
+  for (int s = 0; s < 2; s++) {
+    Clk clk(sources[s]);
+    EXPECT_TRUE(clk.ticksPerSec() > 0);
+    EXPECT_TRUE(s == 0 ? clk.source() == CLK_SOURCE_OS : true);
+    // Never goes backwards
+    uint64_t num_backwards = 0;
+    uint64_t prev = clk.getTimeNS();
+    for (int i = 0; i < 10000; i++) {
+      const uint64_t cur = clk.getTimeNS();
+      num_backwards += cur < prev ? 1 : 0;
+      prev = cur;
+    }
+    EXPECT_EQ(num_backwards, 0);
+
+    const uint64_t t0_ns = clk.getTimeNS();
+    const double t0 = clk.getTime();
+    std::this_thread::sleep_for(
+      std::chrono::milliseconds(TEST_CLK_SLEEP_MS));
+    const double t1 = clk.getTime();
+    const uint64_t t1_ns = clk.getTimeNS();
+    // Generous upper bound: the sandbox may deschedule us
+    EXPECT_TRUE(t1 - t0 >= 0.001 * (TEST_CLK_SLEEP_MS - 1));
+    EXPECT_TRUE(t1 - t0 < 1.0);
+    EXPECT_TRUE(t1_ns - t0_ns >= (TEST_CLK_SLEEP_MS - 1) * 1000000ull);
+    EXPECT_TRUE(static_cast<double>(t1_ns - t0_ns) * 1e-9 >= t1 - t0);
+  }
+}
+
+TEST(Clk, TicksToNS) {
+  Clk clk(CLK_SOURCE_TSC);
+  const uint64_t tps = clk.ticksPerSec();
+  EXPECT_EQ(clk.ticksToNS(0), 0);
+  EXPECT_EQ(clk.ticksToNS(tps), 1000000000ull);
+  // tps / 2 is only exact if the calibrated rate is even
+  const uint64_t half = clk.ticksToNS(1000 * tps + tps / 2);
+  EXPECT_TRUE(half <= 1000500000000ull && half + 1 >= 1000500000000ull);
+  // A year of ticks doesn't overflow
+  const uint64_t year = 365ull * 24 * 3600;
+  EXPECT_EQ(clk.ticksToNS(year * tps), year * 1000000000ull);
+  EXPECT_TRUE(fabs(clk.nsPerTick() * static_cast<double>(tps) - 1e9) < 1e-3);
+}
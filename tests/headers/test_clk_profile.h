@@ -0,0 +1,106 @@
+//
+//  test_clk_profile.h
+//
+//  Cost of reading the clock while many threads timestamp at once.  "locked"
+//  is a Clk behind a global mutex (what every Clk::getTime() call used to
+//  pay).  The numbers are only printed.
+//
+
+#include <thread>
+#include <mutex>
+#include <iostream>
+#include "test_unit/test_unit.h"
+#include "jtil/clk/clk.h"
+
+#define PROFILE_CLK_NUM_CALLS 200000  // per thread
+#define PROFILE_CLK_MAX_THREADS 16
+
+typedef enum {
+  PROFILE_CLK_LOCKED_TIME = 0,
+  PROFILE_CLK_TIME = 1,
+  PROFILE_CLK_TIME_NS = 2,
+  PROFILE_CLK_TICKS = 3,
+  PROFILE_CLK_NUM_CALL_TYPES = 4,
+} ProfileClkCall;
+
+const char* ProfileClkCallName[PROFILE_CLK_NUM_CALL_TYPES] = {
+  "locked getTime()", "getTime()", "getTimeNS()", "getTicks()"};
+
+struct ProfileClkWorker {
+  ProfileClkWorker() : clk(NULL), lock(NULL), call(PROFILE_CLK_TIME),
+    sum(0) { }
+  void run() {
+    switch (call) {
+    case PROFILE_CLK_LOCKED_TIME:
+      for (int i = 0; i < PROFILE_CLK_NUM_CALLS; i++) {
+        std::lock_guard<std::mutex> guard(*lock);
+        sum += static_cast<uint64_t>(clk->getTime());
+      }
+      break;
+    case PROFILE_CLK_TIME:
+      for (int i = 0; i < PROFILE_CLK_NUM_CALLS; i++) {
+        sum += static_cast<uint64_t>(clk->getTime());
+      }
+      break;
+    case PROFILE_CLK_TIME_NS:
+      for (int i = 0; i < PROFILE_CLK_NUM_CALLS; i++) {
+        sum += clk->getTimeNS();
+      }
+      break;
+    default:
+      for (int i = 0; i < PROFILE_CLK_NUM_CALLS; i++) {
+        sum += clk->getTicks();
+      }
+      break;
+    }
+  }
+  const jtil::clk::Clk* clk;
+  std::mutex* lock;
+  ProfileClkCall call;
+  uint64_t sum;  // So the calls aren't optimized away
+};
+
+// Returns the wall time per call in ns (summed over threads, ie, the cost
+// of one call if the threads ran back to back)
+double ProfileClk(const jtil::clk::Clk* clk, const ProfileClkCall call,
+  const int num_threads) {
+  std::mutex lock;
+  ProfileClkWorker workers[PROFILE_CLK_MAX_THREADS];
+  std::thread threads[PROFILE_CLK_MAX_THREADS];
+  jtil::clk::Clk timer;
+  const uint64_t t0 = timer.getTimeNS();
+  for (int i = 0; i < num_threads; i++) {
+    workers[i].clk = clk;
+    workers[i].lock = &lock;
+    workers[i].call = call;
+    threads[i] = std::thread(&ProfileClkWorker::run, &workers[i]);
+  }
+  for (int i = 0; i < num_threads; i++) {
+    threads[i].join();
+  }
+  const uint64_t t1 = timer.getTimeNS();
+  return static_cast<double>(t1 - t0) /
+    (static_cast<double>(num_threads) * PROFILE_CLK_NUM_CALLS);
+}
+
+TEST(ProfileClk, ContendedCallCost) {
+  jtil::clk::Clk clk_os(jtil::clk::CLK_SOURCE_OS);
+  jtil::clk::Clk clk_tsc(jtil::clk::CLK_SOURCE_TSC);
+  const jtil::clk::Clk* clks[2] = {&clk_os, &clk_tsc};
+  std::cout << std::endl;
+  std::cout << "  TSC source available: " <<
+    (clk_tsc.source() == jtil::clk::CLK_SOURCE_TSC ? "yes" : "no") <<
+    std::endl;
+  std::cout << "  source | call | 1 thread (ns/call) | " <<
+    PROFILE_CLK_MAX_THREADS << " threads (ns/call)" << std::endl;
+  for (int s = 0; s < 2; s++) {
+    for (int c = 0; c < PROFILE_CLK_NUM_CALL_TYPES; c++) {
+      const ProfileClkCall call = static_cast<ProfileClkCall>(c);
+      std::cout << "  " << (s == 0 ? "OS" : "TSC") << " | " <<
+        ProfileClkCallName[c] << " | ";
+      std::cout << ProfileClk(clks[s], call, 1) << " | ";
+      std::cout << ProfileClk(clks[s], call, PROFILE_CLK_MAX_THREADS);
+      std::cout << std::endl;
+    }
+  }
+}
@@ -8,8 +8,11 @@
 //  which was amazing), particularly the test unit stuff.
 
 #include "test_data_str/test_circular_buffer.h"
+#include "test_data_str/test_circular_buffer_spsc.h"
 #include "test_data_str/test_hash_map.h"
 #include "test_data_str/test_hash_map_managed.h"
+#include "test_data_str/test_concurrent_hash_map.h"
+#include "test_data_str/test_flat_hash_map.h"
 #include "test_data_str/test_hash_set.h"
 #include "test_data_str/test_vector.h"
 #include "test_data_str/test_vector_managed.h"
@@ -0,0 +1,117 @@
+//
+//  test_circular_buffer_spsc.h
+//
+
+#include <thread>
+#include "jtil/data_str/circular_buffer_spsc.h"
+#include "test_unit/test_unit.h"
+
+#define TEST_CB_SPSC_SIZE 11
+#define TEST_CB_SPSC_NUM_VALUES 100000
+#define TEST_CB_SPSC_FRAME_SIZE 64
+
+using jtil::data_str::CircularBufferSPSC;
+
+// Every slot is usable, a full buffer rejects writes (rather than dropping
+// old values) and the wrap around keeps the order.
+TEST(CircularBufferSPSC, ReadWrite) {
+  CircularBufferSPSC<int> b(TEST_CB_SPSC_SIZE);
+  EXPECT_EQ(b.capacity(), TEST_CB_SPSC_SIZE);
+  int value = 0;
+  EXPECT_FALSE(b.read(value));
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < TEST_CB_SPSC_SIZE; i++) {
+      EXPECT_TRUE(b.write(j * 100 + i));
+    }
+    EXPECT_TRUE(b.full());
+    EXPECT_FALSE(b.write(-1));
+    for (int i = 0; i < TEST_CB_SPSC_SIZE; i++) {
+      EXPECT_TRUE(b.read(value));
+      EXPECT_EQ(value, j * 100 + i);
+    }
+    EXPECT_TRUE(b.empty());
+    EXPECT_FALSE(b.read(value));
+    b.write(0);  // Shift the start so the next pass wraps around
+    b.read(value);
+  }
+}
+
+TEST(CircularBufferSPSC, BulkReadWrite) {
+  CircularBufferSPSC<int> b(TEST_CB_SPSC_SIZE);
+  int in[2 * TEST_CB_SPSC_SIZE];
+  int out[2 * TEST_CB_SPSC_SIZE];
+  for (int i = 0; i < 2 * TEST_CB_SPSC_SIZE; i++) {
+    in[i] = i;
+  }
+  EXPECT_EQ(b.write(in, 7), 7);
+  EXPECT_EQ(b.read(out, 5), 5);
+  // Wraps around, and is cut short by the 2 unread values
+  EXPECT_EQ(b.write(&in[7], 2 * TEST_CB_SPSC_SIZE - 7),
+    TEST_CB_SPSC_SIZE - 2);
+  EXPECT_EQ(b.size(), TEST_CB_SPSC_SIZE);
+  EXPECT_EQ(b.read(&out[5], 2 * TEST_CB_SPSC_SIZE), TEST_CB_SPSC_SIZE);
+  for (int i = 0; i < TEST_CB_SPSC_SIZE + 5; i++) {
+    EXPECT_EQ(out[i], i);
+  }
+  EXPECT_EQ(b.read(out, 1), 0);
+}
+
+struct TestSPSCFrame {
+  int id;
+  int data[TEST_CB_SPSC_FRAME_SIZE];
+};
+
+void TestSPSCProduce(CircularBufferSPSC<TestSPSCFrame>* b) {
+  for (int i = 0; i < TEST_CB_SPSC_NUM_VALUES; i++) {
+    TestSPSCFrame* frame;
+    while ((frame = b->reserve()) == NULL) {
+      std::this_thread::yield();
+    }
+    frame->id = i;
+    for (int j = 0; j < TEST_CB_SPSC_FRAME_SIZE; j++) {
+      frame->data[j] = i + j;
+    }
+    b->commit();
+  }
+}
+
+int TestSPSCNumBad(const TestSPSCFrame& frame, const int id) {
+  int num_bad = frame.id != id ? 1 : 0;
+  for (int j = 0; j < TEST_CB_SPSC_FRAME_SIZE; j++) {
+    num_bad += frame.data[j] != id + j ? 1 : 0;
+  }
+  return num_bad;
+}
+
+// Frames filled in place by a producer thread arrive complete and in order.
+// The consumer alternates between in place and bulk reads.
+TEST(CircularBufferSPSC, ProducerConsumer) {
+  CircularBufferSPSC<TestSPSCFrame> b(4);
+  std::thread producer(TestSPSCProduce, &b);
+  TestSPSCFrame frames[3];
+  int num_bad = 0;
+  int next_id = 0;
+  while (next_id < TEST_CB_SPSC_NUM_VALUES) {
+    uint32_t num = 0;
+    if (next_id % 2 == 0) {
+      const TestSPSCFrame* frame = b.peek();
+      if (frame != NULL) {
+        num_bad += TestSPSCNumBad(*frame, next_id);
+        b.consume();
+        num = 1;
+      }
+    } else {
+      num = b.read(frames, 3);
+      for (uint32_t f = 0; f < num; f++) {
+        num_bad += TestSPSCNumBad(frames[f], next_id + f);
+      }
+    }
+    if (num == 0) {
+      std::this_thread::yield();
+    }
+    next_id += num;
+  }
+  producer.join();
+  EXPECT_EQ(num_bad, 0);
+  EXPECT_TRUE(b.peek() == NULL);
+}
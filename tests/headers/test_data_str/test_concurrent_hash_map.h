@@ -0,0 +1,142 @@
+//
+//  test_concurrent_hash_map.h
+//
+
+#include <thread>
+#include <string>
+#include <sstream>
+#include "jtil/data_str/concurrent_hash_map.h"
+#include "jtil/data_str/hash_funcs.h"
+#include "test_unit/test_unit.h"
+
+#define TEST_CHM_START_SIZE 16  // Small, to force a few rehashes
+#define TEST_CHM_NUM_VALUES 1000
+#define TEST_CHM_NUM_THREADS 4
+
+using jtil::data_str::ConcurrentHashMap;
+using jtil::data_str::HashUInt;
+using jtil::data_str::HashString;
+
+TEST(ConcurrentHashMap, InsertLookupErase) {
+  ConcurrentHashMap<uint32_t, uint32_t> hm(TEST_CHM_START_SIZE, &HashUInt, 4);
+  EXPECT_EQ(hm.numShards(), 4);
+  for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(hm.insert(i, 2 * i));
+  }
+  EXPECT_FALSE(hm.insert(7, 0));  // Already there
+  EXPECT_EQ(hm.count(), TEST_CHM_NUM_VALUES);
+  uint32_t val = 0;
+  uint32_t num_wrong = 0;
+  for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i++) {
+    num_wrong += (!hm.lookup(i, val) || val != 2 * i) ? 1 : 0;
+  }
+  EXPECT_EQ(num_wrong, 0);
+  EXPECT_FALSE(hm.lookup(TEST_CHM_NUM_VALUES, val));
+
+  // Erase the even keys, the odd ones must still be found past the
+  // tombstones, and re-inserting reuses them
+  for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i += 2) {
+    EXPECT_TRUE(hm.erase(i));
+  }
+  EXPECT_FALSE(hm.erase(0));
+  EXPECT_EQ(hm.count(), TEST_CHM_NUM_VALUES / 2);
+  for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i++) {
+    num_wrong += hm.lookup(i, val) != (i % 2 == 1) ? 1 : 0;
+  }
+  EXPECT_EQ(num_wrong, 0);
+  EXPECT_FALSE(hm.set(0, 1));
+  EXPECT_TRUE(hm.set(1, 1));
+  EXPECT_TRUE(hm.lookup(1, val));
+  EXPECT_EQ(val, 1);
+  // Many erase / insert rounds: the tombstones must get purged
+  for (uint32_t j = 0; j < 20; j++) {
+    for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i += 2) {
+      EXPECT_TRUE(hm.insert(i, j));
+    }
+    for (uint32_t i = 0; i < TEST_CHM_NUM_VALUES; i += 2) {
+      EXPECT_TRUE(hm.erase(i));
+    }
+  }
+  EXPECT_EQ(hm.count(), TEST_CHM_NUM_VALUES / 2);
+  hm.clear();
+  EXPECT_EQ(hm.count(), 0);
+  EXPECT_FALSE(hm.lookup(1, val));
+}
+
+TEST(ConcurrentHashMap, StringKeys) {
+  ConcurrentHashMap<std::string, int> hm(TEST_CHM_START_SIZE, &HashString);
+  for (int i = 0; i < TEST_CHM_NUM_VALUES; i++) {
+    std::stringstream ss;
+    ss << "geometry_" << i;
+    EXPECT_TRUE(hm.insert(ss.str(), i));
+  }
+  int val = -1;
+  EXPECT_TRUE(hm.lookup("geometry_123", val));
+  EXPECT_EQ(val, 123);
+  EXPECT_FALSE(hm.lookup("geometry_", val));
+}
+
+// Each writer thread owns a range of keys that it inserts, updates and
+// erases while reader threads look up everything.  Any value a reader sees
+// must be one that a writer stored for that key.
+class TestCHMWorker {
+public:
+  TestCHMWorker(ConcurrentHashMap<uint32_t, uint32_t>* hm, const uint32_t id)
+    : hm_(hm), id_(id), num_bad(0), num_found(0) { }
+  void write() {
+    const uint32_t begin = id_ * TEST_CHM_NUM_VALUES;
+    for (uint32_t round = 0; round < 10; round++) {
+      for (uint32_t i = begin; i < begin + TEST_CHM_NUM_VALUES; i++) {
+        num_bad += hm_->insert(i, 3 * i) ? 0 : 1;
+      }
+      for (uint32_t i = begin; i < begin + TEST_CHM_NUM_VALUES; i++) {
+        num_bad += hm_->set(i, 3 * i + 1) ? 0 : 1;
+      }
+      for (uint32_t i = begin + 1; i < begin + TEST_CHM_NUM_VALUES; i += 2) {
+        num_bad += hm_->erase(i) ? 0 : 1;
+      }
+      for (uint32_t i = begin; i < begin + TEST_CHM_NUM_VALUES; i += 2) {
+        num_bad += hm_->erase(i) ? 0 : 1;
+      }
+    }
+  }
+  void read() {
+    const uint32_t num_keys = TEST_CHM_NUM_THREADS * TEST_CHM_NUM_VALUES;
+    for (uint32_t round = 0; round < 20; round++) {
+      for (uint32_t i = 0; i < num_keys; i++) {
+        uint32_t val;
+        if (hm_->lookup(i, val)) {
+          num_found++;
+          num_bad += (val == 3 * i || val == 3 * i + 1) ? 0 : 1;
+        }
+      }
+    }
+  }
+
+private:
+  ConcurrentHashMap<uint32_t, uint32_t>* hm_;
+  uint32_t id_;
+
+public:
+  uint32_t num_bad;
+  uint32_t num_found;
+};
+
+TEST(ConcurrentHashMap, ConcurrentReadWrite) {
+  ConcurrentHashMap<uint32_t, uint32_t> hm(TEST_CHM_START_SIZE, &HashUInt);
+  TestCHMWorker* workers[2 * TEST_CHM_NUM_THREADS];
+  std::thread threads[2 * TEST_CHM_NUM_THREADS];
+  for (uint32_t i = 0; i < 2 * TEST_CHM_NUM_THREADS; i++) {
+    workers[i] = new TestCHMWorker(&hm, i % TEST_CHM_NUM_THREADS);
+    threads[i] = std::thread(i < TEST_CHM_NUM_THREADS ? &TestCHMWorker::write
+      : &TestCHMWorker::read, workers[i]);
+  }
+  uint32_t num_bad = 0;
+  for (uint32_t i = 0; i < 2 * TEST_CHM_NUM_THREADS; i++) {
+    threads[i].join();
+    num_bad += workers[i]->num_bad;
+    delete workers[i];
+  }
+  EXPECT_EQ(num_bad, 0);
+  EXPECT_EQ(hm.count(), 0);
+}
@@ -0,0 +1,179 @@
+//
+//  test_flat_hash_map.h
+//
+
+#include <string>
+#include <sstream>
+#include <map>
+#include "jtil/data_str/flat_hash_map.h"
+#include "test_unit/test_unit.h"
+#include "jtil/data_str/hash_funcs.h"
+
+#define TEST_FHM_START_SIZE 16
+#define TEST_FHM_NUM_VALUES 1000  // Enough to force a few re-hashes
+
+using jtil::data_str::FlatHashMap;
+using jtil::data_str::HashUInt;
+using jtil::data_str::HashString;
+
+TEST(FlatHashMap, CreationAndInsertion) {
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  EXPECT_EQ(ht.capacity(), 32);  // 16 keys don't fit under the 7/8 load
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(ht.insert(i, i * 2));
+  }
+  EXPECT_EQ(ht.count(), TEST_FHM_NUM_VALUES);
+  EXPECT_TRUE(ht.load() <= 0.875f);
+  uint32_t val = 0;
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(ht.lookup(i, val));
+    EXPECT_EQ(i * 2, val);
+  }
+  for (uint32_t i = TEST_FHM_NUM_VALUES; i < 2 * TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_FALSE(ht.lookup(i, val));
+  }
+}
+
+TEST(FlatHashMap, DuplicateInsertionAndSet) {
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  EXPECT_FALSE(ht.set(0, 1));  // Not there yet
+  EXPECT_TRUE(ht.insert(0, 1));
+  EXPECT_FALSE(ht.insert(0, 2));
+  uint32_t val = 0;
+  EXPECT_TRUE(ht.lookup(0, val));
+  EXPECT_EQ(val, 1);
+  EXPECT_TRUE(ht.set(0, 3));
+  EXPECT_TRUE(ht.lookup(0, val));
+  EXPECT_EQ(val, 3);
+  EXPECT_EQ(ht.count(), 1);
+}
+
+TEST(FlatHashMap, Erase) {
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  EXPECT_FALSE(ht.erase(1));
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(ht.insert(i, i));
+  }
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i += 2) {
+    EXPECT_TRUE(ht.erase(i));
+    EXPECT_FALSE(ht.erase(i));
+  }
+  EXPECT_EQ(ht.count(), TEST_FHM_NUM_VALUES / 2);
+  uint32_t val = 0;
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_EQ(ht.lookup(i, val), i % 2 == 1);
+  }
+  // Put them back: they reuse the slots, so the table doesn't grow
+  const uint32_t capacity = ht.capacity();
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i += 2) {
+    EXPECT_TRUE(ht.insert(i, i + 1));
+  }
+  EXPECT_EQ(ht.capacity(), capacity);
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(ht.lookup(i, val));
+    EXPECT_EQ(val, i % 2 == 0 ? i + 1 : i);
+  }
+}
+
+TEST(FlatHashMap, Churn) {
+  // Insert and erase keys at random against a std::map, with a small key
+  // range so the same slots are erased and refilled many times (and the
+  // tombstones are purged by same size re-hashes)
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  std::map<uint32_t, uint32_t> ref;
+  uint32_t state = 1;
+  uint32_t max_capacity = 0;
+  for (uint32_t i = 0; i < 100000; i++) {
+    state = state * 1664525 + 1013904223;  // LCG
+    const uint32_t key = (state >> 8) % 200;
+    uint32_t val;
+    if ((state >> 28) < 8) {
+      EXPECT_EQ(ht.insert(key, i), ref.find(key) == ref.end());
+      ref.insert(std::make_pair(key, i));
+    } else {
+      EXPECT_EQ(ht.erase(key), ref.erase(key) == 1);
+    }
+    EXPECT_EQ(ht.count(), static_cast<uint32_t>(ref.size()));
+    if (i % 1000 == 0) {
+      for (uint32_t k = 0; k < 200; k++) {
+        std::map<uint32_t, uint32_t>::iterator it = ref.find(k);
+        EXPECT_EQ(ht.lookup(k, val), it != ref.end());
+        if (it != ref.end()) {
+          EXPECT_EQ(val, it->second);
+        }
+      }
+    }
+    max_capacity = std::max<uint32_t>(max_capacity, ht.capacity());
+  }
+  EXPECT_TRUE(max_capacity <= 512);  // The tombstones didn't grow the table
+}
+
+TEST(FlatHashMap, StringKeys) {
+  FlatHashMap<std::string, uint32_t> ht(TEST_FHM_START_SIZE, &HashString);
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    std::stringstream ss;
+    ss << "bone_" << i;
+    EXPECT_TRUE(ht.insert(ss.str(), i));
+  }
+  uint32_t val = 0;
+  EXPECT_TRUE(ht.lookup("bone_17", val));
+  EXPECT_EQ(val, 17);
+  EXPECT_TRUE(ht.lookupPrehash(ht.hash("bone_999"), "bone_999", val));
+  EXPECT_EQ(val, 999);
+  EXPECT_FALSE(ht.lookup("bone_1000", val));
+  EXPECT_TRUE(ht.erase("bone_17"));
+  EXPECT_FALSE(ht.lookup("bone_17", val));
+
+  uint32_t num_full = 0;
+  for (uint32_t i = 0; i < ht.capacity(); i++) {
+    if (ht.full(i)) {
+      num_full++;
+      EXPECT_EQ(ht.table()[i].first.substr(0, 5), "bone_");
+    }
+  }
+  EXPECT_EQ(num_full, TEST_FHM_NUM_VALUES - 1);
+}
+
+TEST(FlatHashMap, Clear) {
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    ht.insert(i, i);
+  }
+  ht.clear();
+  EXPECT_EQ(ht.count(), 0);
+  uint32_t val;
+  EXPECT_FALSE(ht.lookup(0, val));
+  EXPECT_TRUE(ht.insert(0, 5));
+  EXPECT_TRUE(ht.lookup(0, val));
+  EXPECT_EQ(val, 5);
+
+  // The keys' and values' heap memory is freed too
+  FlatHashMap<std::string, std::string> ht_str(TEST_FHM_START_SIZE,
+    &HashString);
+  for (uint32_t i = 0; i < TEST_FHM_START_SIZE / 2; i++) {
+    std::stringstream ss;
+    ss << "a long key, to be sure it is on the heap " << i;
+    ht_str.insert(ss.str(), ss.str());
+  }
+  ht_str.clear();
+  uint32_t num_not_reset = 0;
+  for (uint32_t i = 0; i < ht_str.capacity(); i++) {
+    num_not_reset += (!ht_str.table()[i].first.empty() ||
+      !ht_str.table()[i].second.empty()) ? 1 : 0;
+  }
+  EXPECT_EQ(num_not_reset, 0);
+}
+
+TEST(FlatHashMap, Reserve) {
+  FlatHashMap<uint32_t, uint32_t> ht(TEST_FHM_START_SIZE, &HashUInt);
+  ht.insert(TEST_FHM_NUM_VALUES, 0);
+  ht.reserve(TEST_FHM_NUM_VALUES + 1);
+  const uint32_t capacity = ht.capacity();
+  for (uint32_t i = 0; i < TEST_FHM_NUM_VALUES; i++) {
+    EXPECT_TRUE(ht.insert(i, i));
+  }
+  EXPECT_EQ(ht.capacity(), capacity);  // No rehash
+  uint32_t val;
+  EXPECT_TRUE(ht.lookup(TEST_FHM_NUM_VALUES, val));
+  EXPECT_EQ(val, 0);
+}
@@ -226,3 +226,121 @@ TEST(HashMapPtr, StringCreationAndInsertion) {
   // for us.
   delete[] vals;
 }
+
+// TEST 6: reserve() and build() size the table once
+TEST(HashMap, ReserveAndBuild) {
+  HashMap<uint32_t, uint32_t> ht(TEST_HM_START_SIZE, &HashUInt);
+  ht.reserve(10 * TEST_HM_NUM_VALUES);
+  const uint32_t size = ht.size();
+  EXPECT_TRUE(size >= 20 * TEST_HM_NUM_VALUES);
+  for (uint32_t i = 0; i < 10 * TEST_HM_NUM_VALUES; i += 1) {
+    EXPECT_TRUE(ht.insert(i, i*2));
+  }
+  EXPECT_EQ(ht.size(), size);  // No rehash
+  ht.reserve(1);  // Never shrinks
+  EXPECT_EQ(ht.size(), size);
+
+  HashMap<std::string, uint32_t> hts(TEST_HM_START_SIZE, &HashString);
+  std::string keys[3 * TEST_HM_NUM_VALUES];
+  uint32_t vals[3 * TEST_HM_NUM_VALUES];
+  std::stringstream ss;
+  for (uint32_t i = 0; i < 3 * TEST_HM_NUM_VALUES; i += 1) {
+    ss.str("");
+    ss << (i % (2 * TEST_HM_NUM_VALUES));  // The last third are duplicates
+    keys[i] = ss.str();
+    vals[i] = i;
+  }
+  EXPECT_TRUE(hts.insert("0", 7));
+  EXPECT_EQ(hts.build(keys, vals, 3 * TEST_HM_NUM_VALUES), 
+    2 * TEST_HM_NUM_VALUES - 1);
+  EXPECT_EQ(hts.count(), 2 * TEST_HM_NUM_VALUES);
+  EXPECT_TRUE(hts.load() <= 0.5f);
+  uint32_t val = 0;
+  EXPECT_TRUE(hts.lookup("0", val));
+  EXPECT_EQ(val, 7);  // Already there, so not replaced
+  for (uint32_t i = 1; i < 2 * TEST_HM_NUM_VALUES; i += 1) {
+    EXPECT_TRUE(hts.lookup(keys[i], val));
+    EXPECT_EQ(val, i);  // The first of the duplicates wins
+  }
+  EXPECT_TRUE(hts.lookupPrehash(CONSTANT_HASH(hts.size(), "17"), "17", val));
+  EXPECT_EQ(val, 17);
+}
+
+// TEST 7: Iterators, emplace and moves
+TEST(HashMap, IterateEmplaceAndMove) {
+  HashMap<std::string, std::string> ht(TEST_HM_START_SIZE, &HashString);
+  std::string key("k0");
+  std::string value("v0");
+  EXPECT_TRUE(ht.insert(std::move(key), std::move(value)));
+  EXPECT_TRUE(ht.emplace("k1", 2, 'v'));  // value "vv"
+  EXPECT_FALSE(ht.emplace("k1", 3, 'v'));
+  EXPECT_TRUE(ht.insert(std::string("k2"), std::string("v2")));
+  std::string val;
+  EXPECT_TRUE(ht.lookup("k0", val));
+  EXPECT_EQ(val, "v0");
+  EXPECT_TRUE(ht.lookup("k1", val));
+  EXPECT_EQ(val, "vv");
+
+  uint32_t num_keys = 0;
+  for (HashMap<std::string, std::string>::iterator it = ht.begin(); 
+    it != ht.end(); ++it) {
+    EXPECT_EQ(it->first.at(0), 'k');
+    it->second += "!";
+    num_keys++;
+  }
+  EXPECT_EQ(num_keys, 3);
+
+  HashMap<std::string, std::string> ht2(std::move(ht));
+  EXPECT_EQ(ht2.count(), 3);
+  EXPECT_TRUE(ht2.lookup("k2", val));
+  EXPECT_EQ(val, "v2!");
+  HashMap<std::string, std::string> ht3(TEST_HM_START_SIZE, &HashString);
+  ht3.insert(std::string("x"), std::string("y"));
+  ht3 = std::move(ht2);
+  EXPECT_EQ(ht3.count(), 3);
+  EXPECT_FALSE(ht3.lookup("x", val));
+  const HashMap<std::string, std::string>& ht3_const = ht3;
+  num_keys = 0;
+  for (HashMap<std::string, std::string>::const_iterator it = 
+    ht3_const.begin(); it != ht3_const.end(); it++) {
+    num_keys++;
+  }
+  EXPECT_EQ(num_keys, 3);
+
+  // Moved from maps are empty and can be used again
+  EXPECT_EQ(ht.count(), 0);
+  EXPECT_EQ(ht2.count(), 0);
+  EXPECT_TRUE(ht.size() > 0 && ht2.size() > 0);
+  EXPECT_FALSE(ht.lookup("k0", val));
+  EXPECT_FALSE(ht2.lookup("x", val));  // Not ht3's old contents
+  EXPECT_TRUE(ht2.begin() == ht2.end());
+  for (uint32_t i = 0; i < TEST_HM_NUM_VALUES; i++) {
+    std::stringstream ss;
+    ss << i;
+    EXPECT_TRUE(ht.insert(ss.str(), ss.str()));
+    EXPECT_TRUE(ht2.insert(ss.str(), ss.str()));
+  }
+  EXPECT_TRUE(ht2.lookup("17", val));
+  EXPECT_EQ(val, "17");
+  EXPECT_EQ(ht.count(), TEST_HM_NUM_VALUES);
+}
+
+// TEST 8: A const_iterator over a non-const map
+TEST(HashMap, ConstIteratorFromNonConstMap) {
+  HashMap<std::string, uint32_t> ht(TEST_HM_START_SIZE, &HashString);
+  ht.insert("a", 1);
+  ht.insert("b", 2);
+  uint32_t sum = 0;
+  HashMap<std::string, uint32_t>::const_iterator it;
+  for (it = ht.begin(); it != ht.end(); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(sum, 3);
+  HashMap<std::string, uint32_t>::iterator it_mutable = ht.begin();
+  HashMap<std::string, uint32_t>::const_iterator it_const = it_mutable;
+  EXPECT_TRUE(it_mutable == it_const);
+  EXPECT_TRUE(it_const == it_mutable);
+  EXPECT_FALSE(ht.end() != ht.end());
+  ++it_const;
+  EXPECT_TRUE(it_mutable != it_const);
+}
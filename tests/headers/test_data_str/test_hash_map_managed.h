@@ -4,6 +4,8 @@
 //  Created by Jonathan Tompson on 4/26/12.
 //
 
+#include <sstream>
+#include <string>
 #include "jtil/data_str/hash_map_managed.h"
 #include "test_unit/test_unit.h"
 #include "jtil/data_str/hash_funcs.h"
@@ -224,3 +226,76 @@ TEST(HashMapManagedPtr, StringCreationAndInsertion) {
   }
   EXPECT_EQ(ht.count(), TEST_HMM_NUM_VALUES);
 }
+
+// TEST 6Ptr: build() (the map owns the values it inserted)
+TEST(HashMapManagedPtr, Build) {
+  HashMapManaged<std::string, uint32_t*> ht(TEST_HM_START_SIZE, &HashString);
+  std::string keys[TEST_HMM_NUM_VALUES + 1];
+  uint32_t* vals[TEST_HMM_NUM_VALUES + 1];
+  std::stringstream ss;
+  for (uint32_t i = 0; i < TEST_HMM_NUM_VALUES; i += 1) {
+    ss.str("");
+    ss << i;
+    keys[i] = ss.str();
+    vals[i] = new uint32_t(i*2);
+  }
+  keys[TEST_HMM_NUM_VALUES] = "3";  // A duplicate, not inserted
+  vals[TEST_HMM_NUM_VALUES] = new uint32_t(0);
+  EXPECT_EQ(ht.build(keys, vals, TEST_HMM_NUM_VALUES + 1), 
+    TEST_HMM_NUM_VALUES);
+  delete vals[TEST_HMM_NUM_VALUES];
+  const uint32_t size = ht.size();
+  EXPECT_TRUE(size >= 2 * TEST_HMM_NUM_VALUES);
+  uint32_t* val = NULL;
+  for (uint32_t i = 0; i < TEST_HMM_NUM_VALUES; i += 1) {
+    EXPECT_TRUE(ht.lookup(keys[i], val));
+    EXPECT_EQ(i*2, *val);
+  }
+}
+
+// TEST 7Ptr: Iterators, emplace and moves
+TEST(HashMapManagedPtr, IterateEmplaceAndMove) {
+  HashMapManaged<std::string, std::string*> ht(TEST_HM_START_SIZE, 
+    &HashString);
+  EXPECT_TRUE(ht.emplace("a", 2, 'a'));  // Owns new std::string(2, 'a')
+  EXPECT_FALSE(ht.emplace("a", 3, 'a'));  // Nothing constructed
+  EXPECT_TRUE(ht.insert(std::string("b"), new std::string("bb")));
+  std::string all;
+  for (HashMapManaged<std::string, std::string*>::iterator it = ht.begin();
+    it != ht.end(); ++it) {
+    all += *it->second;
+  }
+  EXPECT_TRUE(all == "aabb" || all == "bbaa");
+
+  HashMapManaged<std::string, std::string*> ht2(std::move(ht));
+  EXPECT_EQ(ht2.count(), 2);
+  HashMapManaged<std::string, std::string*> ht3(TEST_HM_START_SIZE, 
+    &HashString);
+  ht3.emplace("c", "c");
+  ht3 = std::move(ht2);  // Deletes "c"
+  std::string* val;
+  EXPECT_TRUE(ht3.lookup("a", val));
+  EXPECT_EQ(*val, "aa");
+  EXPECT_FALSE(ht3.lookup("c", val));
+  uint32_t num_keys = 0;
+  HashMapManaged<std::string, std::string*>::const_iterator it;
+  for (it = ht3.begin(); it != ht3.end(); ++it) {  // ht3 isn't const
+    num_keys++;
+  }
+  EXPECT_EQ(num_keys, 2);
+
+  // Moved from maps are empty (not holding ht3's old values) and usable
+  EXPECT_EQ(ht.count(), 0);
+  EXPECT_EQ(ht2.count(), 0);
+  EXPECT_FALSE(ht2.lookup("c", val));
+  EXPECT_TRUE(ht2.begin() == ht2.end());
+  for (uint32_t i = 0; i < TEST_HMM_NUM_VALUES; i++) {
+    std::stringstream ss;
+    ss << i;
+    EXPECT_TRUE(ht.insert(ss.str(), new std::string(ss.str())));
+    EXPECT_TRUE(ht2.emplace(ss.str(), ss.str()));
+  }
+  EXPECT_TRUE(ht.lookup("17", val));
+  EXPECT_EQ(*val, "17");
+  EXPECT_EQ(ht2.count(), TEST_HMM_NUM_VALUES);
+}
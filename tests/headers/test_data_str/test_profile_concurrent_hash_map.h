@@ -0,0 +1,133 @@
+//
+//  test_profile_concurrent_hash_map.h
+//
+//  Multi-threaded lookup / update throughput of ConcurrentHashMap against a
+//  HashMap behind one global mutex (which is how GeometryManager shares its
+//  maps today).  The numbers are only printed.
+//
+
+#include <thread>
+#include <mutex>
+#include <iostream>
+#include "test_unit/test_unit.h"
+#include "jtil/data_str/hash_map.h"
+#include "jtil/data_str/concurrent_hash_map.h"
+#include "jtil/data_str/hash_funcs.h"
+#include "jtil/clk/clk.h"
+
+#define PROFILE_CHM_NUM_KEYS 4096
+#define PROFILE_CHM_OPS_PER_THREAD 400000
+#define PROFILE_CHM_MAX_THREADS 8
+
+using jtil::data_str::HashMap;
+using jtil::data_str::ConcurrentHashMap;
+using jtil::data_str::HashUInt;
+
+class ProfileLockedHashMap {
+public:
+  ProfileLockedHashMap() : hm_(2 * PROFILE_CHM_NUM_KEYS + 1, &HashUInt) { }
+  bool insert(const uint32_t key, const uint32_t value) {
+    std::lock_guard<std::mutex> lock(lock_);
+    return hm_.insert(key, value);
+  }
+  bool set(const uint32_t key, const uint32_t value) {
+    std::lock_guard<std::mutex> lock(lock_);
+    return hm_.set(key, value);
+  }
+  bool lookup(const uint32_t key, uint32_t& value) {
+    std::lock_guard<std::mutex> lock(lock_);
+    return hm_.lookup(key, value);
+  }
+private:
+  std::mutex lock_;
+  HashMap<uint32_t, uint32_t> hm_;
+};
+
+class ProfileConcurrentHashMap {
+public:
+  ProfileConcurrentHashMap() : hm_(PROFILE_CHM_NUM_KEYS, &HashUInt) { }
+  bool insert(const uint32_t key, const uint32_t value) {
+    return hm_.insert(key, value);
+  }
+  bool set(const uint32_t key, const uint32_t value) {
+    return hm_.set(key, value);
+  }
+  bool lookup(const uint32_t key, uint32_t& value) {
+    return hm_.lookup(key, value);
+  }
+private:
+  ConcurrentHashMap<uint32_t, uint32_t> hm_;
+};
+
+// 'write_percent' of the operations update a random key, the rest look one up
+template <class Map>
+struct ProfileCHMWorker {
+  ProfileCHMWorker() : map(NULL), write_percent(0), seed(1), num_found(0) { }
+  void run() {
+    uint32_t x = seed;
+    for (int i = 0; i < PROFILE_CHM_OPS_PER_THREAD; i++) {
+      x ^= x << 13;  // xorshift32
+      x ^= x >> 17;
+      x ^= x << 5;
+      const uint32_t key = x % PROFILE_CHM_NUM_KEYS;
+      if ((x >> 16) % 100 < write_percent) {
+        map->set(key, i);
+      } else {
+        uint32_t value;
+        num_found += map->lookup(key, value) ? 1 : 0;
+      }
+    }
+  }
+  Map* map;
+  uint32_t write_percent;
+  uint32_t seed;
+  uint32_t num_found;
+};
+
+// Returns millions of operations per second
+template <class Map>
+double ProfileCHM(const int num_threads, const uint32_t write_percent,
+  uint32_t* num_found) {
+  Map map;
+  for (uint32_t i = 0; i < PROFILE_CHM_NUM_KEYS; i++) {
+    map.insert(i, i);
+  }
+  ProfileCHMWorker<Map> workers[PROFILE_CHM_MAX_THREADS];
+  std::thread threads[PROFILE_CHM_MAX_THREADS];
+  jtil::clk::Clk clk;
+  double t0 = clk.getTime();
+  for (int i = 0; i < num_threads; i++) {
+    workers[i].map = &map;
+    workers[i].write_percent = write_percent;
+    workers[i].seed = 2463534242u + i;
+    threads[i] = std::thread(&ProfileCHMWorker<Map>::run, &workers[i]);
+  }
+  for (int i = 0; i < num_threads; i++) {
+    threads[i].join();
+    *num_found += workers[i].num_found;
+  }
+  double t1 = clk.getTime();
+  return 1e-6 * static_cast<double>(num_threads) *
+    static_cast<double>(PROFILE_CHM_OPS_PER_THREAD) / (t1 - t0);
+}
+
+TEST(ProfileConcurrentHashMap, ReadWriteVsLockedHashMap) {
+  const uint32_t write_percents[] = {0, 10, 50};
+  std::cout << std::endl;
+  std::cout << "  threads | writes % | HashMap + mutex (Mops/sec) | "
+    << "ConcurrentHashMap (Mops/sec)" << std::endl;
+  for (int n = 1; n <= PROFILE_CHM_MAX_THREADS; n *= 2) {
+    for (int w = 0; w < 3; w++) {
+      uint32_t num_found[2] = {0, 0};
+      std::cout << "  " << n << " | " << write_percents[w] << " | ";
+      std::cout << ProfileCHM<ProfileLockedHashMap>(n, write_percents[w],
+        &num_found[0]);
+      std::cout << " | ";
+      std::cout << ProfileCHM<ProfileConcurrentHashMap>(n, write_percents[w],
+        &num_found[1]);
+      std::cout << std::endl;
+      // Every key is always present
+      EXPECT_TRUE(num_found[0] > 0 && num_found[1] > 0);
+    }
+  }
+}
@@ -0,0 +1,94 @@
+//
+//  test_profile_flat_hash_map.h
+//
+//  String key lookups (the GeometryManager / SettingsManager case) in a
+//  HashMap against a FlatHashMap, half of them hits and half misses.  And
+//  filling a HashMap from its start size with insert() (which rehashes as it
+//  grows) against build().
+//
+
+#include <string>
+#include <sstream>
+#include "test_unit/test_unit.h"
+#include "jtil/data_str/hash_map.h"
+#include "jtil/data_str/flat_hash_map.h"
+#include "jtil/data_str/hash_funcs.h"
+
+#define PROFILE_FHM_NUM_KEYS 1024
+
+using jtil::data_str::HashMap;
+using jtil::data_str::FlatHashMap;
+using jtil::data_str::HashString;
+
+// The keys "name_0" to "name_<2 * NUM_KEYS - 1>" and both maps holding the
+// first half, built once so the benchmarks only time the lookups
+class ProfileFlatHashMapData {
+public:
+  ProfileFlatHashMapData() : hm(2 * PROFILE_FHM_NUM_KEYS + 1, &HashString),
+    fhm(PROFILE_FHM_NUM_KEYS, &HashString) {
+    for (uint32_t i = 0; i < 2 * PROFILE_FHM_NUM_KEYS; i++) {
+      std::stringstream ss;
+      ss << "name_" << i;
+      keys[i] = ss.str();
+      if (i < PROFILE_FHM_NUM_KEYS) {
+        hm.insert(keys[i], i);
+        fhm.insert(keys[i], i);
+      }
+    }
+  }
+  static ProfileFlatHashMapData& get() {
+    static ProfileFlatHashMapData data;
+    return data;
+  }
+  std::string keys[2 * PROFILE_FHM_NUM_KEYS];
+  HashMap<std::string, uint32_t> hm;
+  FlatHashMap<std::string, uint32_t> fhm;
+};
+
+BENCHMARK(ProfileFlatHashMap, HashMapStringLookup) {
+  ProfileFlatHashMapData& data = ProfileFlatHashMapData::get();
+  uint32_t sum = 0;
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    uint32_t val = 0;
+    data.hm.lookup(data.keys[i % (2 * PROFILE_FHM_NUM_KEYS)], val);
+    sum += val;
+  }
+  tests::DoNotOptimize(sum);
+}
+
+BENCHMARK(ProfileFlatHashMap, FlatHashMapStringLookup) {
+  ProfileFlatHashMapData& data = ProfileFlatHashMapData::get();
+  uint32_t sum = 0;
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    uint32_t val = 0;
+    data.fhm.lookup(data.keys[i % (2 * PROFILE_FHM_NUM_KEYS)], val);
+    sum += val;
+  }
+  tests::DoNotOptimize(sum);
+}
+
+BENCHMARK(ProfileFlatHashMap, HashMapStringInsert) {
+  ProfileFlatHashMapData& data = ProfileFlatHashMapData::get();
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    HashMap<std::string, uint32_t> hm(211, &HashString);
+    for (uint32_t j = 0; j < PROFILE_FHM_NUM_KEYS; j++) {
+      hm.insert(data.keys[j], j);
+    }
+    tests::DoNotOptimize(hm);
+  }
+  state.setItemsPerIteration(PROFILE_FHM_NUM_KEYS);
+}
+
+BENCHMARK(ProfileFlatHashMap, HashMapStringBuild) {
+  ProfileFlatHashMapData& data = ProfileFlatHashMapData::get();
+  uint32_t vals[PROFILE_FHM_NUM_KEYS];
+  for (uint32_t j = 0; j < PROFILE_FHM_NUM_KEYS; j++) {
+    vals[j] = j;
+  }
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    HashMap<std::string, uint32_t> hm(211, &HashString);
+    hm.build(data.keys, vals, PROFILE_FHM_NUM_KEYS);
+    tests::DoNotOptimize(hm);
+  }
+  state.setItemsPerIteration(PROFILE_FHM_NUM_KEYS);
+}
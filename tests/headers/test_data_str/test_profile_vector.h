@@ -0,0 +1,86 @@
+//
+//  test_profile_vector.h
+//
+//  pushBack throughput of Vector against std::vector, filling from empty (so
+//  the growth is timed too).  Float3 and uint32_t take Vector's realloc path,
+//  std::string takes the move construct path.
+//
+
+#include <string>
+#include <vector>
+#include "test_unit/test_unit.h"
+#include "jtil/data_str/vector.h"
+#include "jtil/math/math_types.h"
+
+#define PROFILE_VECTOR_NUM_ELEMS 4096
+
+using jtil::data_str::Vector;
+using jtil::math::Float3;
+
+BENCHMARK(ProfileVector, VectorUInt32PushBack) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    Vector<uint32_t> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.pushBack(j);
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
+
+BENCHMARK(ProfileVector, StdVectorUInt32PushBack) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    std::vector<uint32_t> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.push_back(j);
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
+
+BENCHMARK(ProfileVector, VectorFloat3PushBack) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    Vector<Float3> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.pushBack(Float3(static_cast<float>(j), 0.0f, 1.0f));
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
+
+BENCHMARK(ProfileVector, StdVectorFloat3PushBack) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    std::vector<Float3> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.push_back(Float3(static_cast<float>(j), 0.0f, 1.0f));
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
+
+BENCHMARK(ProfileVector, VectorStringPushBack) {
+  const std::string str("a string key");
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    Vector<std::string> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.pushBack(str);
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
+
+BENCHMARK(ProfileVector, StdVectorStringPushBack) {
+  const std::string str("a string key");
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    std::vector<std::string> vec;
+    for (uint32_t j = 0; j < PROFILE_VECTOR_NUM_ELEMS; j++) {
+      vec.push_back(str);
+    }
+    tests::DoNotOptimize(vec);
+  }
+  state.setItemsPerIteration(PROFILE_VECTOR_NUM_ELEMS);
+}
@@ -4,13 +4,22 @@
 //  Created by Jonathan Tompson on 4/26/12.
 //
 
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include "jtil/data_str/vector.h"
+#include "jtil/math/math_types.h"
 #include "test_unit/test_unit.h"
 
 #define TEST_VECTOR_START_SIZE 101  // A "bigish" prime
 #define TEST_VECTOR_NUM_VALUES 2048
 
 using jtil::data_str::Vector;
+using jtil::data_str::CacheLineAllocator;
+using jtil::data_str::HugePageAllocator;
+using jtil::math::Float3;
+using jtil::math::Float4;
 
 TEST(Vector, CreationAndInsertion) {
   Vector<int>* vec1 = new Vector<int>(2);  // capacity = 2
@@ -117,3 +126,197 @@ TEST(VectorPointer, CreationAndInsertion) {
   delete vec1;
   delete vec2;
 }
+
+// Counts its copies, to check that moves and emplaces don't copy
+class TestVectorCopyCount {
+public:
+  TestVectorCopyCount() : val(0) { }
+  explicit TestVectorCopyCount(const int v, const int w = 0) : val(v + w) { }
+  TestVectorCopyCount(const TestVectorCopyCount& other) : val(other.val) {
+    num_copies++;
+  }
+  TestVectorCopyCount(TestVectorCopyCount&& other) : val(other.val) { }
+  TestVectorCopyCount& operator=(const TestVectorCopyCount& other) {
+    val = other.val;
+    num_copies++;
+    return *this;
+  }
+  TestVectorCopyCount& operator=(TestVectorCopyCount&& other) {
+    val = other.val;
+    return *this;
+  }
+  int val;
+  static int num_copies;
+};
+int TestVectorCopyCount::num_copies = 0;
+
+TEST(Vector, MoveEmplaceAndIterate) {
+  TestVectorCopyCount::num_copies = 0;
+  Vector<TestVectorCopyCount> vec;
+  for (int i = 0; i < 100; i++) {
+    if (i % 2 == 0) {
+      vec.pushBack(TestVectorCopyCount(i));
+    } else {
+      vec.emplaceBack(i - 1, 1);
+    }
+  }
+  EXPECT_EQ(TestVectorCopyCount::num_copies, 0);  // Even when growing
+  int expected = 0;
+  for (Vector<TestVectorCopyCount>::iterator it = vec.begin(); 
+    it != vec.end(); ++it) {
+    EXPECT_EQ(it->val, expected++);
+  }
+  EXPECT_EQ(expected, 100);
+  vec.deleteAtAndShift(0);
+  EXPECT_EQ(vec[0].val, 1);
+  EXPECT_EQ(TestVectorCopyCount::num_copies, 0);
+
+  Vector<TestVectorCopyCount> vec2(std::move(vec));
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec2.size(), 99);
+  EXPECT_EQ(TestVectorCopyCount::num_copies, 0);
+  vec = std::move(vec2);
+  EXPECT_EQ(vec.size(), 99);
+  EXPECT_EQ(vec2.size(), 0);
+
+  const Vector<TestVectorCopyCount> vec3(vec);  // A deep copy
+  EXPECT_EQ(TestVectorCopyCount::num_copies, 99);
+  vec[0].val = -1;
+  int sum = 0;
+  for (Vector<TestVectorCopyCount>::const_iterator it = vec3.begin(); 
+    it != vec3.end(); ++it) {
+    sum += it->val;
+  }
+  EXPECT_EQ(sum, 99 * 100 / 2);
+}
+
+// Counts the live instances, to check that only [0, size()) is constructed
+// and that everything constructed is destroyed
+class TestVectorLiveCount {
+public:
+  TestVectorLiveCount() : str("default") { num_live++; }
+  explicit TestVectorLiveCount(const std::string& s) : str(s) { num_live++; }
+  TestVectorLiveCount(const TestVectorLiveCount& other) : str(other.str) {
+    num_live++;
+  }
+  TestVectorLiveCount& operator=(const TestVectorLiveCount& other) {
+    str = other.str;
+    return *this;
+  }
+  ~TestVectorLiveCount() { num_live--; }
+  std::string str;
+  static int num_live;
+};
+int TestVectorLiveCount::num_live = 0;
+
+TEST(Vector, ConstructOnlyLiveElements) {
+  TestVectorLiveCount::num_live = 0;
+  {
+    Vector<TestVectorLiveCount> vec(64);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 0);  // Just raw memory
+    for (uint32_t i = 0; i < 100; i++) {  // Grows to 128
+      vec.emplaceBack(std::string(i + 1, 'a'));
+    }
+    EXPECT_EQ(TestVectorLiveCount::num_live, 100);
+    EXPECT_EQ(vec[99].str.length(), 100);
+    vec.pushBack(vec[0]);  // Grows to 256 while copying one of its own
+    EXPECT_EQ(vec[100].str, "a");
+    vec.popBack();
+    vec.deleteAtAndShift(0);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 99);
+    EXPECT_EQ(vec[0].str, "aa");
+    vec.resize(50);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 50);
+    vec.resize(60);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 60);
+    EXPECT_EQ(vec[59].str, "default");
+    vec.capacity(10);  // Truncates
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 10);
+    Vector<TestVectorLiveCount> vec2(vec);
+    EXPECT_EQ(TestVectorLiveCount::num_live, 20);
+    EXPECT_EQ(vec2[9].str, vec[9].str);
+  }
+  EXPECT_EQ(TestVectorLiveCount::num_live, 0);
+}
+
+// Pushing or emplacing one of the vector's own elements when it is full
+// (growing frees the buffer the argument refers to).
+TEST(Vector, PushOwnElementAtFullCapacity) {
+  Vector<int> ints(4);
+  for (int i = 0; i < 4; i++) {
+    ints.pushBack(i + 10);
+  }
+  ints.emplaceBack(ints[1]);
+  EXPECT_EQ(ints.size(), 5);
+  EXPECT_EQ(ints[4], 11);
+  Vector<std::string> strs(2);
+  strs.pushBack(std::string("first"));
+  strs.pushBack(std::string("second"));
+  strs.emplaceBack(strs[0]);  // Copy
+  EXPECT_EQ(strs[2], "first");
+  strs.pushBack(std::string("third"));
+  strs.pushBack(std::move(strs[1]));  // Full again (4): move
+  EXPECT_EQ(strs.size(), 5);
+  EXPECT_EQ(strs[4], "second");
+  EXPECT_EQ(strs[0], "first");
+}
+
+TEST(Vector, TriviallyCopyable) {
+  EXPECT_TRUE(std::is_trivially_copyable<Float3>::value);
+  Vector<Float3> vec;
+  for (uint32_t i = 0; i < TEST_VECTOR_NUM_VALUES; i++) {
+    vec.pushBack(Float3(static_cast<float>(i), 1.0f, 2.0f));
+  }
+  EXPECT_EQ(vec.capacity(), TEST_VECTOR_NUM_VALUES);
+  vec.pushBack(vec[7]);  // Reallocs while copying one of its own
+  EXPECT_EQ(vec[TEST_VECTOR_NUM_VALUES][0], 7.0f);
+  vec.deleteAtAndShift(0);
+  Vector<Float3> vec2;
+  vec2 = vec;
+  EXPECT_EQ(vec2.size(), TEST_VECTOR_NUM_VALUES);
+  for (uint32_t i = 0; i < TEST_VECTOR_NUM_VALUES - 1; i++) {
+    EXPECT_EQ(vec2[i][0], static_cast<float>(i + 1));
+    EXPECT_EQ(vec2[i][2], 2.0f);
+  }
+  vec2.capacity(4);  // Truncates
+  vec2.capacity(8);
+  vec2.resize(8);  // The new elements are zeroed by Float3()
+  EXPECT_EQ(vec2[3][0], 4.0f);
+  EXPECT_EQ(vec2[7][1], 0.0f);
+}
+
+static bool isAligned(const void* ptr, const uintptr_t alignment) {
+  return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+}
+
+TEST(Vector, AllocatorPolicies) {
+  // Check the alignment after every grow, since the trivially copyable path
+  // reallocs
+  Vector<Float4> vec_default;
+  Vector<Float4, CacheLineAllocator> vec_line;
+  for (uint32_t i = 0; i < TEST_VECTOR_NUM_VALUES; i++) {
+    vec_default.pushBack(Float4(static_cast<float>(i), 0.0f, 0.0f, 0.0f));
+    vec_line.pushBack(Float4(static_cast<float>(i), 0.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(isAligned(vec_default.at(0), ALIGNMENT));
+    EXPECT_TRUE(isAligned(vec_line.at(0), 64));
+  }
+  for (uint32_t i = 0; i < TEST_VECTOR_NUM_VALUES; i++) {
+    EXPECT_EQ(vec_line[i][0], static_cast<float>(i));
+  }
+  Vector<Float4, CacheLineAllocator> vec_line2(vec_line);
+  EXPECT_TRUE(isAligned(vec_line2.at(0), 64));
+  EXPECT_EQ(vec_line2[TEST_VECTOR_NUM_VALUES - 1][0], 
+    static_cast<float>(TEST_VECTOR_NUM_VALUES - 1));
+
+  // Small arrays are cache line aligned, 2MB+ ones are huge page aligned
+  Vector<uint32_t, HugePageAllocator> vec_huge(16);
+  EXPECT_TRUE(isAligned(vec_huge.at(0), 64));
+  const uint32_t huge_count = 3 * 1024 * 1024 / sizeof(uint32_t);
+  for (uint32_t i = 0; i < huge_count; i++) {
+    vec_huge.pushBack(i);
+  }
+  EXPECT_TRUE(isAligned(vec_huge.at(0), 2 * 1024 * 1024));
+  EXPECT_EQ(vec_huge[17], 17);
+  EXPECT_EQ(vec_huge[huge_count - 1], huge_count - 1);
+}
@@ -4,10 +4,14 @@
 //  Created by Jonathan Tompson on 6/1/12.
 //
 
+#include <stdint.h>
+#include <string>
+#include <utility>
 #include "jtil/data_str/vector_managed.h"
 #include "test_unit/test_unit.h"
 
 using jtil::data_str::VectorManaged;
+using jtil::data_str::CacheLineAllocator;
 
 TEST(VectorManaged, CreationAndInsertion) {
   VectorManaged<int>* vec1 = new VectorManaged<int>(2);  // capacity = 2
@@ -106,3 +110,67 @@ TEST(VectorManagedPointer, CreationAndInsertion) {
   }
   delete vec2;
 }
+
+TEST(VectorManaged, MoveEmplaceAndIterate) {
+  VectorManaged<std::string> vec;
+  std::string str("a");
+  vec.pushBack(std::move(str));
+  vec.emplaceBack(3, 'b');
+  vec.pushBack(std::string("c"));
+  std::string all;
+  for (VectorManaged<std::string>::iterator it = vec.begin(); it != vec.end();
+    ++it) {
+    all += *it;
+  }
+  EXPECT_EQ(all, "abbbc");
+  VectorManaged<std::string> vec2(std::move(vec));
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec2.size(), 3);
+  EXPECT_EQ(vec2[1], "bbb");
+}
+
+// Same as Vector(PushOwnElementAtFullCapacity): copy, emplace and move
+TEST(VectorManaged, PushOwnElementAtFullCapacity) {
+  for (int op = 0; op < 3; op++) {
+    VectorManaged<std::string> vec(2);
+    vec.pushBack(std::string("first"));
+    vec.pushBack(std::string("second"));
+    if (op == 0) {
+      vec.pushBack(vec[1]);
+    } else if (op == 1) {
+      vec.emplaceBack(vec[1]);
+    } else {
+      vec.pushBack(std::move(vec[1]));
+    }
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], "first");
+    EXPECT_EQ(vec[2], "second");
+  }
+}
+
+TEST(VectorManagedPointer, MoveEmplaceAndIterate) {
+  VectorManaged<std::string*> vec;
+  vec.emplaceBack(2, 'x');  // Owns new std::string(2, 'x')
+  vec.pushBack(new std::string("y"));
+  VectorManaged<std::string*> vec2;
+  vec2.pushBack(new std::string("z"));
+  vec2 = std::move(vec);  // Frees "z"
+  EXPECT_EQ(vec.size(), 0);
+  std::string all;
+  for (VectorManaged<std::string*>::const_iterator it = vec2.begin(); 
+    it != vec2.end(); ++it) {
+    all += **it;
+  }
+  EXPECT_EQ(all, "xxy");
+}
+
+TEST(VectorManagedPointer, CacheLineAllocator) {
+  VectorManaged<std::string*, CacheLineAllocator> vec;
+  for (uint32_t i = 0; i < 100; i++) {
+    vec.emplaceBack(i + 1, 'a');
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.at(0)) % 64, 0);
+  }
+  EXPECT_EQ(vec[99]->length(), 100);
+  VectorManaged<std::string, CacheLineAllocator> vec_str(3);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(vec_str.at(0)) % 64, 0);
+}
@@ -120,4 +120,37 @@ TEST(ImageUtil, BlobDetect) {
     std::cout << "skipping test (run in jtil/tests/ in future)...";
     std::cout << std::endl;
   }
-}
\ No newline at end of file
+}
+// The ThreadPool path of FracDownsampleImageSAT should give exactly the same
+// result as the serial (or OpenMP) path.
+TEST(ImageUtil, FracDownsampleImageSATThreadPool) {
+  const int32_t src_w = 161;
+  const int32_t src_h = 119;
+  const int32_t dst_w = 67;
+  const int32_t dst_h = 43;
+  float* src = new float[src_w * src_h];
+  for (int32_t i = 0; i < src_w * src_h; i++) {
+    src[i] = static_cast<float>((i * 7919) % 256);
+  }
+  double* tmp = new double[src_w * src_h];
+  float* dst_serial = new float[dst_w * dst_h];
+  float* dst_pool = new float[dst_w * dst_h];
+
+  jtil::image_util::FracDownsampleImageSAT<float>(dst_serial, 0, 0, dst_w, 
+    dst_h, dst_w, src, 0, 0, src_w, src_h, src_w, src_h, tmp);
+  jtil::threading::ThreadPool tp(4);
+  jtil::image_util::FracDownsampleImageSAT<float>(dst_pool, 0, 0, dst_w, 
+    dst_h, dst_w, src, 0, 0, src_w, src_h, src_w, src_h, tmp, &tp);
+  tp.stop();
+
+  int32_t num_wrong = 0;
+  for (int32_t i = 0; i < dst_w * dst_h; i++) {
+    num_wrong += dst_serial[i] != dst_pool[i] ? 1 : 0;
+  }
+  EXPECT_EQ(num_wrong, 0);
+
+  delete[] src;
+  delete[] tmp;
+  delete[] dst_serial;
+  delete[] dst_pool;
+}
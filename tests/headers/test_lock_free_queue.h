@@ -0,0 +1,138 @@
+//
+//  test_lock_free_queue.h
+//
+//  Single threaded tests of LockFreeQueue plus a multi-producer /
+//  multi-consumer stress test under contention.
+
+#include <thread>
+#include <atomic>
+#include "jtil/threading/lock_free_queue.h"
+#include "test_unit/test_unit.h"
+
+#define TEST_LF_QUEUE_SIZE 16
+#define TEST_LF_NUM_PRODUCERS 4
+#define TEST_LF_NUM_CONSUMERS 4
+#define TEST_LF_ITEMS_PER_PRODUCER 100000
+
+using jtil::threading::LockFreeQueue;
+
+TEST(LockFreeQueue, EnqueueAndDequeue) {
+  LockFreeQueue<int> q(TEST_LF_QUEUE_SIZE);
+  EXPECT_EQ(q.capacity(), TEST_LF_QUEUE_SIZE);
+  EXPECT_TRUE(q.empty());
+
+  // Repeat so that the positions wrap around the ring a few times
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < TEST_LF_QUEUE_SIZE; i++) {
+      EXPECT_TRUE(q.enqueue(i));
+      EXPECT_EQ(q.size(), static_cast<uint32_t>(i + 1));
+    }
+    int value = -1;
+    for (int i = 0; i < TEST_LF_QUEUE_SIZE; i++) {
+      EXPECT_TRUE(q.dequeue(value));
+      EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(q.empty());
+  }
+}
+
+TEST(LockFreeQueue, FullAndEmpty) {
+  LockFreeQueue<int> q(TEST_LF_QUEUE_SIZE - 1);  // Rounds up to a power of 2
+  EXPECT_EQ(q.capacity(), TEST_LF_QUEUE_SIZE);
+
+  int value = -1;
+  EXPECT_FALSE(q.dequeue(value));
+  for (int i = 0; i < TEST_LF_QUEUE_SIZE; i++) {
+    EXPECT_TRUE(q.enqueue(i));
+  }
+  EXPECT_FALSE(q.enqueue(TEST_LF_QUEUE_SIZE));
+  EXPECT_EQ(q.size(), static_cast<uint32_t>(TEST_LF_QUEUE_SIZE));
+
+  // Freeing one slot should allow exactly one more enqueue
+  EXPECT_TRUE(q.dequeue(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(q.enqueue(TEST_LF_QUEUE_SIZE));
+  EXPECT_FALSE(q.enqueue(TEST_LF_QUEUE_SIZE + 1));
+  for (int i = 1; i <= TEST_LF_QUEUE_SIZE; i++) {
+    EXPECT_TRUE(q.dequeue(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(q.dequeue(value));
+}
+
+// Every producer enqueues a disjoint range of values into a small queue (so
+// it is constantly full or empty), while the consumers tally what they see.
+// Every value must come out exactly once, and each producer's values must
+// come out in the order they went in.
+static void LockFreeQueueProducer(LockFreeQueue<int>* q, int producer) {
+  for (int i = 0; i < TEST_LF_ITEMS_PER_PRODUCER; i++) {
+    int value = producer * TEST_LF_ITEMS_PER_PRODUCER + i;
+    while (!q->enqueue(value)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+static void LockFreeQueueConsumer(LockFreeQueue<int>* q,
+  std::atomic<int>* num_consumed, int* seen, bool* ordered) {
+  const int num_items = TEST_LF_NUM_PRODUCERS * TEST_LF_ITEMS_PER_PRODUCER;
+  int last[TEST_LF_NUM_PRODUCERS];
+  for (int i = 0; i < TEST_LF_NUM_PRODUCERS; i++) {
+    last[i] = -1;
+  }
+  int value;
+  while (num_consumed->load() < num_items) {
+    if (q->dequeue(value)) {
+      seen[value]++;  // Each value should only be written by one consumer
+      int producer = value / TEST_LF_ITEMS_PER_PRODUCER;
+      if (value <= last[producer]) {
+        *ordered = false;
+      }
+      last[producer] = value;
+      num_consumed->fetch_add(1);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+TEST(LockFreeQueue, StressMPMC) {
+  const int num_items = TEST_LF_NUM_PRODUCERS * TEST_LF_ITEMS_PER_PRODUCER;
+  LockFreeQueue<int> q(TEST_LF_QUEUE_SIZE);
+  std::atomic<int> num_consumed;
+  num_consumed.store(0);
+  int* seen = new int[num_items];
+  for (int i = 0; i < num_items; i++) {
+    seen[i] = 0;
+  }
+  bool ordered[TEST_LF_NUM_CONSUMERS];
+
+  std::thread producers[TEST_LF_NUM_PRODUCERS];
+  std::thread consumers[TEST_LF_NUM_CONSUMERS];
+  for (int i = 0; i < TEST_LF_NUM_CONSUMERS; i++) {
+    ordered[i] = true;
+    consumers[i] = std::thread(LockFreeQueueConsumer, &q, &num_consumed, seen,
+      &ordered[i]);
+  }
+  for (int i = 0; i < TEST_LF_NUM_PRODUCERS; i++) {
+    producers[i] = std::thread(LockFreeQueueProducer, &q, i);
+  }
+  for (int i = 0; i < TEST_LF_NUM_PRODUCERS; i++) {
+    producers[i].join();
+  }
+  for (int i = 0; i < TEST_LF_NUM_CONSUMERS; i++) {
+    consumers[i].join();
+    EXPECT_TRUE(ordered[i]);
+  }
+
+  EXPECT_EQ(num_consumed.load(), num_items);
+  EXPECT_TRUE(q.empty());
+  int num_wrong = 0;
+  for (int i = 0; i < num_items; i++) {
+    if (seen[i] != 1) {
+      num_wrong++;
+    }
+  }
+  EXPECT_EQ(num_wrong, 0);
+  delete[] seen;
+}
@@ -16,3 +16,4 @@
 #include "test_math/test_vec4_mat4x4.h"
 #include "test_math/test_quaternion.h"
 #include "test_math/test_math_base.h"
+#include "test_math/test_random.h"
@@ -4,10 +4,11 @@
 //  Created by Jonathan Tompson on 4/26/12.
 //
 
+#include <random>
 #include "test_unit/test_unit.h"
 #include "jtil/math/math_types.h"
 #include "jtil/math/math_base.h"
-#include "jtil/clk/clk.h"
+#include "jtil/math/random.h"
 
 using jtil::math::Vec4;
 using jtil::math::Mat4x4;
@@ -15,7 +16,6 @@ using jtil::math::Mat4x4;
 // Note: RotMat Axis angle is tested in test_quaternion
 
 TEST(ProfileSIMDMath, MatrixMatrixMultiply) {
-  jtil::clk::Clk wall_clock;
   // Some practice variables
   Vec4<float> V_1(5.376671395461000e-001f, 1.833885014595087e+000f, 
     -2.258846861003648e+000f, 8.621733203681206e-001f);
@@ -71,32 +71,56 @@ TEST(ProfileSIMDMath, MatrixMatrixMultiply) {
   M_2.transpose();
   Mat4x4<float>::multSIMD(M_3, M_1, M_2);
   EXPECT_TRUE(Mat4x4<float>::approxEqual(M_3, M_3_expect));
-  
-  // Standard matrix multiply
-  Mat4x4<float>  M_4, M_5;
+}
+
+// Repeated products of a near-identity matrix (so the values stay finite)
+BENCHMARK(ProfileSIMDMath, MatrixMultiplyStandard) {
+  Mat4x4<float> M_3, M_4, M_5;
   M_3.identity();
   M_3[0] += EPSILON;
   M_4.identity();
-  double t0 = wall_clock.getTime();
-  for (uint32_t i = 0; i < 10000000; i++) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
     Mat4x4<float>::mult(M_5, M_4, M_3);
     M_4.set(M_5);
   }
-  // M_4 is n * M_1*M_1
-  double t1 = wall_clock.getTime();
-  std::cout << std::endl;
-  std::cout << "Wall clock time (standard) = " << (t1 - t0) << '\n';
+  tests::DoNotOptimize(M_4);
+}
 
-  // SIMD matrix multiply
+BENCHMARK(ProfileSIMDMath, MatrixMultiplySIMD) {
+  Mat4x4<float> M_3, M_4, M_5;
   M_3.identity();
   M_3[0] += EPSILON;
   M_4.identity();
-  t0 = wall_clock.getTime();
-  for (uint32_t i = 0; i < 10000000; i++) {
+  for (uint64_t i = 0; i < state.iterations(); i++) {
     Mat4x4<float>::multSIMD(M_5, M_4, M_3);
     M_4.set(M_5);
   }
-  // M_4 is n * M_1*M_1
-  t1 = wall_clock.getTime();
-  std::cout << "Wall clock time (SIMD) = " << (t1 - t0) << '\n';
-}
\ No newline at end of file
+  tests::DoNotOptimize(M_4);
+}
+
+// 1024 uniform floats per iteration: the optimizers' old mt19937 +
+// std::uniform_real_distribution against jtil::math::Rand's batch version
+#define PROFILE_RAND_BATCH 1024
+
+BENCHMARK(ProfileSIMDMath, UniformMT19937) {
+  std::mt19937 eng;
+  std::uniform_real_distribution<float> dist(-1, 1);
+  float vals[PROFILE_RAND_BATCH];
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    for (int j = 0; j < PROFILE_RAND_BATCH; j++) {
+      vals[j] = dist(eng);
+    }
+    tests::DoNotOptimize(vals);
+  }
+  state.setItemsPerIteration(PROFILE_RAND_BATCH);
+}
+
+BENCHMARK(ProfileSIMDMath, UniformRandBatch) {
+  jtil::math::Rand rand;
+  float vals[PROFILE_RAND_BATCH];
+  for (uint64_t i = 0; i < state.iterations(); i++) {
+    rand.uniform(vals, PROFILE_RAND_BATCH, -1, 1);
+    tests::DoNotOptimize(vals);
+  }
+  state.setItemsPerIteration(PROFILE_RAND_BATCH);
+}
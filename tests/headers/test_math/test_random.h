@@ -0,0 +1,106 @@
+//
+//  test_random.h
+//
+
+#include <math.h>
+#include "test_unit/test_unit.h"
+#include "jtil/math/random.h"
+
+#define TEST_RAND_NUM 100001  // Odd, to test the batch tails
+
+using jtil::math::Rand;
+
+TEST(Rand, SeedsAndStreams) {
+  Rand a(42);
+  Rand b(42, 0);
+  Rand c(42, 1);
+  Rand d(43);
+  int num_same_b = 0, num_same_c = 0, num_same_d = 0;
+  for (int i = 0; i < 1000; i++) {
+    const uint64_t x = a.next();
+    num_same_b += x == b.next() ? 1 : 0;
+    num_same_c += x == c.next() ? 1 : 0;
+    num_same_d += x == d.next() ? 1 : 0;
+  }
+  EXPECT_EQ(num_same_b, 1000);
+  EXPECT_EQ(num_same_c, 0);
+  EXPECT_EQ(num_same_d, 0);
+
+  // seed() restarts the sequence
+  a.seed(7, 3);
+  const float first = a.uniform();
+  a.normal();
+  a.seed(7, 3);
+  EXPECT_EQ(a.uniform(), first);
+
+  // jump() is deterministic and moves somewhere else
+  a.seed(7);
+  b.seed(7);
+  a.jump();
+  b.jump();
+  c.seed(7);
+  EXPECT_EQ(a.next(), b.next());
+  EXPECT_TRUE(a.next() != c.next());
+}
+
+TEST(Rand, Uniform) {
+  Rand rand(1);
+  float* vals = new float[TEST_RAND_NUM];
+  double sum = 0;
+  int num_out = 0;
+  for (int i = 0; i < TEST_RAND_NUM; i++) {
+    const float u = rand.uniform(-1, 3);
+    num_out += (u < -1 || u >= 3) ? 1 : 0;
+    sum += u;
+  }
+  EXPECT_EQ(num_out, 0);
+  EXPECT_TRUE(fabs(sum / TEST_RAND_NUM - 1.0) < 0.02);
+
+  // The batch version, checked against the same draws done by hand
+  Rand batch(5);
+  Rand check(5);
+  batch.uniform(vals, TEST_RAND_NUM, -1, 3);
+  int num_wrong = 0;
+  sum = 0;
+  for (int i = 0; i < TEST_RAND_NUM; i += 2) {
+    const uint64_t x = check.next();
+    const float u0 = static_cast<float>(x >> 40) / 16777216.0f;
+    const float u1 = static_cast<float>((x >> 16) & 0xffffff) / 16777216.0f;
+    num_wrong += vals[i] != -1 + 4 * u0 ? 1 : 0;
+    if (i + 1 < TEST_RAND_NUM) {
+      num_wrong += vals[i + 1] != -1 + 4 * u1 ? 1 : 0;
+      sum += vals[i + 1];
+    }
+    sum += vals[i];
+  }
+  EXPECT_EQ(num_wrong, 0);
+  EXPECT_TRUE(fabs(sum / TEST_RAND_NUM - 1.0) < 0.02);
+  delete[] vals;
+}
+
+TEST(Rand, Normal) {
+  Rand rand(2);
+  float* vals = new float[TEST_RAND_NUM];
+  rand.normal(vals, TEST_RAND_NUM, 1, 2);
+  double sum = 0, sum_sq = 0;
+  for (int i = 0; i < TEST_RAND_NUM; i++) {
+    sum += vals[i];
+    sum_sq += vals[i] * vals[i];
+  }
+  double mean = sum / TEST_RAND_NUM;
+  double std_dev = sqrt(sum_sq / TEST_RAND_NUM - mean * mean);
+  EXPECT_TRUE(fabs(mean - 1) < 0.03);
+  EXPECT_TRUE(fabs(std_dev - 2) < 0.03);
+
+  sum = sum_sq = 0;
+  for (int i = 0; i < TEST_RAND_NUM; i++) {
+    const float x = rand.normal();
+    sum += x;
+    sum_sq += x * x;
+  }
+  mean = sum / TEST_RAND_NUM;
+  std_dev = sqrt(sum_sq / TEST_RAND_NUM - mean * mean);
+  EXPECT_TRUE(fabs(mean) < 0.02);
+  EXPECT_TRUE(fabs(std_dev - 1) < 0.02);
+  delete[] vals;
+}
@@ -68,6 +68,40 @@ TEST(PSOParallel, ExponentialFit) {
   delete solver2;
 }
 
+// The same seed gives bitwise identical results, another seed doesn't
+TEST(PSO, Reproducible) {
+  jtil::math::PSO solver(NUM_COEFFS_EXPONTIAL_FIT, 17);
+  solver.max_iterations = 50;
+  float c_rad[NUM_COEFFS_EXPONTIAL_FIT] = {2, 2, 2, 2};
+  float ret[3][NUM_COEFFS_EXPONTIAL_FIT];
+  const uint64_t seeds[3] = {1, 1, 2};
+  for (int i = 0; i < 3; i++) {
+    solver.seed = seeds[i];
+    solver.minimize(ret[i], jtil::math::c_0_exponential_fit, c_rad, NULL,
+      jtil::math::exponentialFit, NULL);
+  }
+  EXPECT_EQ(memcmp(ret[0], ret[1], sizeof(ret[0])), 0);
+  EXPECT_TRUE(memcmp(ret[0], ret[2], sizeof(ret[0])) != 0);
+}
+
+TEST(PSOParallel, Reproducible) {
+  bool angle_coeffs[NUM_COEFFS_EXPONTIAL_FIT];
+  memset(angle_coeffs, 0, sizeof(angle_coeffs[0]) * NUM_COEFFS_EXPONTIAL_FIT);
+  jtil::math::PSOParallel solver(NUM_COEFFS_EXPONTIAL_FIT, 64);
+  solver.max_iterations = 50;
+  float c_rad[NUM_COEFFS_EXPONTIAL_FIT] = {2, 2, 2, 2};
+  float ret[3][NUM_COEFFS_EXPONTIAL_FIT];
+  const uint64_t seeds[3] = {1, 1, 2};
+  for (int i = 0; i < 3; i++) {
+    solver.seed = seeds[i];
+    solver.minimize(ret[i], jtil::math::c_0_exponential_fit, c_rad,
+      angle_coeffs, jtil::math::exponentialFitParallel,
+      &jtil::math::coeffUpdateFunc);
+  }
+  EXPECT_EQ(memcmp(ret[0], ret[1], sizeof(ret[0])), 0);
+  EXPECT_TRUE(memcmp(ret[0], ret[2], sizeof(ret[0])) != 0);
+}
+
 TEST(BFGS, HW7_Q4A) {
   jtil::math::BFGS<float>* solver_bfgs = new jtil::math::BFGS<float>(NUM_COEFFS_HW7_4A);
   solver_bfgs->verbose = false;
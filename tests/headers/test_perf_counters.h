@@ -0,0 +1,71 @@
+//
+//  test_perf_counters.h
+//
+
+#include "test_unit/test_unit.h"
+#include "jtil/debug_util/perf_counters.h"
+
+using jtil::debug::PerfCounters;
+using jtil::debug::PerfCounterValues;
+using jtil::debug::PerfScope;
+using jtil::debug::PerfCounter;
+using jtil::debug::PERF_NUM_COUNTERS;
+using jtil::debug::PERF_TASK_CLOCK;
+
+uint64_t TestPerfWork(const uint64_t n) {
+  uint64_t x = 88172645463325252ull;
+  for (uint64_t i = 0; i < n; i++) {
+    x ^= x << 13;  // xorshift64
+    x ^= x >> 7;
+    x ^= x << 17;
+    tests::DoNotOptimize(x);
+  }
+  return x;
+}
+
+// Whatever counters the kernel gives us must count the work, and the rest
+// must be reported as invalid rather than failing
+TEST(PerfCounters, CountWork) {
+  PerfCounters perf;
+  PerfCounterValues vals;
+  {
+    PerfScope scope(&perf, &vals);
+    TestPerfWork(1000000);
+  }
+  PerfCounterValues more;
+  {
+    PerfScope scope(&perf, &more);
+    TestPerfWork(1000000);
+  }
+  {
+    PerfScope scope(&perf, &more);  // Accumulates
+    TestPerfWork(1000000);
+  }
+  int num_bad = 0;
+  for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+    const PerfCounter c = static_cast<PerfCounter>(i);
+    num_bad += PerfCounters::name(c) == NULL ? 1 : 0;
+    num_bad += vals.valid[i] != perf.available(c) ? 1 : 0;
+    num_bad += !vals.valid[i] && vals.counts[i] != 0 ? 1 : 0;
+    if (vals.valid[i] && i != jtil::debug::PERF_LLC_MISSES &&
+      i != jtil::debug::PERF_BRANCH_MISSES) {
+      num_bad += vals.counts[i] == 0 ? 1 : 0;
+      num_bad += more.counts[i] <= vals.counts[i] ? 1 : 0;
+    }
+  }
+  EXPECT_EQ(num_bad, 0);
+  EXPECT_TRUE(vals.ipc() >= 0);
+#if defined(__linux__)
+  // A software counter, only missing if perf events are disabled outright
+  if (perf.available(PERF_TASK_CLOCK)) {
+    EXPECT_TRUE(vals.counts[PERF_TASK_CLOCK] > 100000);  // > 0.1ms
+  }
+#else
+  EXPECT_FALSE(perf.anyAvailable());
+#endif
+}
+
+BENCHMARK(PerfCounters, XorShift) {
+  TestPerfWork(state.iterations());
+  state.setCounter("shifts", 3.0 * static_cast<double>(state.iterations()));
+}
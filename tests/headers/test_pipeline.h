@@ -0,0 +1,212 @@
+//
+//  test_pipeline.h
+//
+
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "test_unit/test_unit.h"
+#include "jtil/threading/callback.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/pipeline.h"
+#include "jtil/data_str/vector.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+#define TEST_PIPELINE_NUM_WORKERS 4
+#define TEST_PIPELINE_NUM_BUFFERS 4
+#define TEST_PIPELINE_NUM_FRAMES 300
+#define TEST_PIPELINE_FRAME_SIZE 16
+
+using jtil::threading::ThreadPool;
+using jtil::threading::Pipeline;
+using jtil::threading::PipelineStats;
+using jtil::threading::MakeCallableMany;
+using jtil::data_str::Vector;
+
+struct TestPipelineFrame {
+  int id;
+  int data[TEST_PIPELINE_FRAME_SIZE];
+};
+
+class TestPipelineApp {
+public:
+  explicit TestPipelineApp(const int num_frames) : num_frames_(num_frames),
+    next_id_(0), num_bad_(0) {
+    num_in_parallel_stage_.store(0);
+    max_in_parallel_stage_.store(0);
+  }
+
+  bool capture(TestPipelineFrame* frame) {
+    if (num_frames_ >= 0 && next_id_ >= num_frames_) {
+      return false;
+    }
+    frame->id = next_id_++;
+    for (int i = 0; i < TEST_PIPELINE_FRAME_SIZE; i++) {
+      frame->data[i] = frame->id;
+    }
+    return true;
+  }
+
+  // Parallel stage, some frames take much longer than others
+  void filter(TestPipelineFrame* frame) {
+    const int num = num_in_parallel_stage_.fetch_add(1) + 1;
+    int max = max_in_parallel_stage_.load();
+    while (num > max && !max_in_parallel_stage_.compare_exchange_weak(max,
+      num)) { }
+    std::this_thread::sleep_for(std::chrono::microseconds(
+      frame->id % 3 == 0 ? 500 : 50));
+    for (int i = 0; i < TEST_PIPELINE_FRAME_SIZE; i++) {
+      frame->data[i] += i;
+    }
+    num_in_parallel_stage_.fetch_sub(1);
+  }
+
+  // Serial stage
+  void output(TestPipelineFrame* frame) {
+    for (int i = 0; i < TEST_PIPELINE_FRAME_SIZE; i++) {
+      num_bad_ += frame->data[i] != frame->id + i ? 1 : 0;
+    }
+    ids.pushBack(frame->id);
+  }
+
+  inline int numBad() const { return num_bad_; }
+  inline int maxInParallelStage() const {
+    return max_in_parallel_stage_.load();
+  }
+  Vector<int> ids;
+
+private:
+  int num_frames_;  // -1 for an endless stream
+  int next_id_;
+  int num_bad_;
+  std::atomic<int> num_in_parallel_stage_;
+  std::atomic<int> max_in_parallel_stage_;
+};
+
+// Every frame makes it through, intact and in order at the serial stage,
+// with the parallel stage actually running frames concurrently.
+TEST(Pipeline, OrderAndStats) {
+  ThreadPool tp(TEST_PIPELINE_NUM_WORKERS);
+  TestPipelineApp app(TEST_PIPELINE_NUM_FRAMES);
+  {
+    Pipeline<TestPipelineFrame> pipeline(&tp, TEST_PIPELINE_NUM_BUFFERS);
+    pipeline.setSource(MakeCallableMany(&TestPipelineApp::capture, &app));
+    EXPECT_EQ(pipeline.addStage(MakeCallableMany(&TestPipelineApp::filter,
+      &app), 3), 0);
+    EXPECT_EQ(pipeline.addStage(MakeCallableMany(&TestPipelineApp::output,
+      &app)), 1);
+    pipeline.start();
+    pipeline.wait();
+
+    PipelineStats stats;
+    pipeline.getStats(&stats);
+    EXPECT_EQ(stats.num_frames, TEST_PIPELINE_NUM_FRAMES);
+    EXPECT_EQ(stats.source.num_frames, TEST_PIPELINE_NUM_FRAMES);
+    EXPECT_EQ(stats.stages.size(), 2);
+    EXPECT_EQ(stats.stages[0].num_frames, TEST_PIPELINE_NUM_FRAMES);
+    EXPECT_EQ(stats.stages[1].num_frames, TEST_PIPELINE_NUM_FRAMES);
+    EXPECT_TRUE(stats.stages[0].busy_ns > stats.stages[1].busy_ns);
+    EXPECT_TRUE(stats.framesPerSecond() > 0);
+
+    // A single buffer pipeline runs one frame at a time
+    TestPipelineApp app2(TEST_PIPELINE_NUM_FRAMES);
+    Pipeline<TestPipelineFrame> pipeline2(&tp, 1);
+    pipeline2.setSource(MakeCallableMany(&TestPipelineApp::capture, &app2));
+    pipeline2.addStage(MakeCallableMany(&TestPipelineApp::output, &app2));
+    pipeline2.start();
+    pipeline2.wait();
+    EXPECT_EQ(app2.ids.size(), TEST_PIPELINE_NUM_FRAMES);
+  }
+  EXPECT_EQ(app.numBad(), 0);
+  EXPECT_EQ(app.ids.size(), TEST_PIPELINE_NUM_FRAMES);
+  int num_out_of_order = 0;
+  for (uint32_t i = 0; i < app.ids.size(); i++) {
+    num_out_of_order += app.ids[i] != static_cast<int>(i) ? 1 : 0;
+  }
+  EXPECT_EQ(num_out_of_order, 0);
+  EXPECT_TRUE(app.maxInParallelStage() > 1);
+  EXPECT_TRUE(app.maxInParallelStage() <= 3);
+  tp.stop();
+}
+
+// An endless source keeps going until stop(), which lets the frames already
+// captured finish.
+TEST(Pipeline, StopAndRestart) {
+  ThreadPool tp(TEST_PIPELINE_NUM_WORKERS);
+  TestPipelineApp app(-1);
+  Pipeline<TestPipelineFrame> pipeline(&tp, TEST_PIPELINE_NUM_BUFFERS);
+  bool thrown = false;
+  try {
+    pipeline.start();
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  pipeline.setSource(MakeCallableMany(&TestPipelineApp::capture, &app));
+  pipeline.addStage(MakeCallableMany(&TestPipelineApp::filter, &app), 2);
+  pipeline.addStage(MakeCallableMany(&TestPipelineApp::output, &app));
+  for (int run = 0; run < 2; run++) {
+    pipeline.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pipeline.stop();
+    PipelineStats stats;
+    pipeline.getStats(&stats);
+    EXPECT_TRUE(stats.num_frames > 0);
+    EXPECT_EQ(stats.num_frames, stats.source.num_frames);
+  }
+  int num_out_of_order = 0;
+  for (uint32_t i = 0; i < app.ids.size(); i++) {
+    num_out_of_order += app.ids[i] != static_cast<int>(i) ? 1 : 0;
+  }
+  EXPECT_EQ(num_out_of_order, 0);
+  EXPECT_EQ(app.numBad(), 0);
+  tp.stop();
+}
+
+// Stops the pool from inside the source once it has produced some frames
+class TestPipelineStopper {
+public:
+  TestPipelineStopper(ThreadPool* tp, const int stop_at) : tp_(tp),
+    stop_at_(stop_at), next_id_(0) { }
+  bool capture(TestPipelineFrame* frame) {
+    if (next_id_ == stop_at_) {
+      tp_->stop();  // Every later task is rejected
+    }
+    frame->id = next_id_++;
+    return true;
+  }
+  void output(TestPipelineFrame* frame) { ids.pushBack(frame->id); }
+  Vector<int> ids;
+
+private:
+  ThreadPool* tp_;
+  int stop_at_;
+  int next_id_;
+};
+
+// A pipeline whose pool is stopped under it drops the frame the pool
+// rejects and ends the stream, rather than leaving wait() (and stop() and
+// the destructor) waiting for frames that will never finish.
+TEST(Pipeline, PoolStopped) {
+  ThreadPool tp(TEST_PIPELINE_NUM_WORKERS);
+  TestPipelineStopper stopper(&tp, 10);
+  Pipeline<TestPipelineFrame> pipeline(&tp, 1);  // One task at a time
+  pipeline.setSource(MakeCallableMany(&TestPipelineStopper::capture,
+    &stopper));
+  pipeline.addStage(MakeCallableMany(&TestPipelineStopper::output,
+    &stopper));
+  pipeline.start();
+  pipeline.wait();
+  EXPECT_EQ(stopper.ids.size(), 10);
+  PipelineStats stats;
+  pipeline.getStats(&stats);
+  EXPECT_EQ(stats.num_frames, 10);
+  bool thrown = false;
+  try {
+    pipeline.start();
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  pipeline.stop();
+}
@@ -0,0 +1,208 @@
+//
+//  test_task_group.h
+//
+//  TaskGroup wait / continuations (including waiting from inside a worker and
+//  on a stopped pool) and TaskGraph dependency ordering over many runs.
+
+#include <thread>
+#include <atomic>
+#include "test_unit/test_unit.h"
+#include "test_unit/test_util.h"
+#include "jtil/threading/callback.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/task_group.h"
+#include "jtil/exceptions/wruntime_error.h"
+
+#define TG_NUM_WORKERS 4
+#define TG_NUM_TASKS 1001
+#define TG_NUM_FRAMES 101
+
+using jtil::threading::ThreadPool;
+using jtil::threading::TaskGroup;
+using jtil::threading::TaskGraph;
+using jtil::threading::TP_WORK_STEALING;
+using jtil::threading::TP_LOCK_FREE_QUEUE;
+using jtil::threading::Callback;
+using jtil::threading::MakeCallableOnce;
+using jtil::threading::MakeCallableMany;
+using tests::CounterThreadSafe;
+
+// wait() must not return until every task has run, and the group (and pool)
+// must be reusable afterwards.
+TEST(TaskGroup, RunAndWait) {
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(TG_NUM_WORKERS, modes[m]);
+    TaskGroup group(&tp);
+    CounterThreadSafe c;
+    Callback<void>* inc = MakeCallableMany(&CounterThreadSafe::inc, &c);
+    for (int j = 1; j <= 3; j++) {
+      for (int i = 0; i < TG_NUM_TASKS; i++) {
+        group.run(inc);
+      }
+      group.wait();
+      EXPECT_EQ(c.count(), j * TG_NUM_TASKS);
+      EXPECT_EQ(group.numPending(), 0);
+    }
+    group.run(MakeCallableOnce(&CounterThreadSafe::incBy, &c, 2));
+    group.wait();
+    EXPECT_EQ(c.count(), 3 * TG_NUM_TASKS + 2);
+    tp.stop();
+    delete inc;
+  }
+}
+
+// Records the order in which tasks finish
+class TaskOrder {
+public:
+  TaskOrder() { next.store(0); gate.store(false); }
+  void mark(int* slot) { *slot = next.fetch_add(1); }
+  void waitThenMark(int* slot) {
+    while (!gate.load()) {
+      std::this_thread::yield();
+    }
+    mark(slot);
+  }
+  std::atomic<int> next;
+  std::atomic<bool> gate;
+};
+
+// A continuation starts after every task in the group (including ones added
+// after then() was called), and wait() also covers the continuation.
+TEST(TaskGroup, Continuation) {
+  ThreadPool tp(TG_NUM_WORKERS);
+  TaskGroup group(&tp);
+  TaskOrder order;
+  int slots[4];
+  // The first task holds the group open until every request has been made
+  group.run(MakeCallableOnce(&TaskOrder::waitThenMark, &order, &slots[0]));
+  group.run(MakeCallableOnce(&TaskOrder::mark, &order, &slots[1]));
+  group.then(MakeCallableOnce(&TaskOrder::mark, &order, &slots[3]));
+  group.run(MakeCallableOnce(&TaskOrder::mark, &order, &slots[2]));
+  order.gate.store(true);
+  group.wait();
+  EXPECT_EQ(order.next.load(), 4);
+  EXPECT_EQ(slots[3], 3);
+
+  // On an empty group the continuation runs straight away
+  group.then(MakeCallableOnce(&TaskOrder::mark, &order, &slots[0]));
+  group.wait();
+  EXPECT_EQ(slots[0], 4);
+  tp.stop();
+}
+
+// A task that fans out into its own group and waits on it.  With a single
+// worker this only completes if wait() runs the inner tasks itself.
+class TaskGroupFanOut {
+public:
+  TaskGroupFanOut(ThreadPool* tp, CounterThreadSafe* c) : tp_(tp), c_(c) { }
+  void run() {
+    TaskGroup inner(tp_);
+    for (int i = 0; i < TG_NUM_TASKS; i++) {
+      inner.run(MakeCallableOnce(&CounterThreadSafe::inc, c_));
+    }
+    inner.wait();
+    count_after_wait = c_->count();
+  }
+  int count_after_wait;
+private:
+  ThreadPool* tp_;
+  CounterThreadSafe* c_;
+};
+
+TEST(TaskGroup, WaitInsideWorker) {
+  ThreadPool tp(1);
+  CounterThreadSafe c;
+  TaskGroupFanOut fan_out(&tp, &c);
+  TaskGroup outer(&tp);
+  outer.run(MakeCallableOnce(&TaskGroupFanOut::run, &fan_out));
+  outer.wait();
+  EXPECT_EQ(fan_out.count_after_wait, TG_NUM_TASKS);
+  tp.stop();
+}
+
+// Nobody in the pool will run the tasks, so wait() must
+TEST(TaskGroup, StoppedPool) {
+  ThreadPool tp(TG_NUM_WORKERS);
+  tp.stop();
+  CounterThreadSafe c;
+  TaskGroup group(&tp);
+  for (int i = 0; i < TG_NUM_TASKS; i++) {
+    group.run(MakeCallableOnce(&CounterThreadSafe::inc, &c));
+  }
+  group.then(MakeCallableOnce(&CounterThreadSafe::incBy, &c, 2));
+  group.wait();
+  EXPECT_EQ(c.count(), TG_NUM_TASKS + 2);
+  EXPECT_EQ(tp.count(), 0);
+}
+
+// A frame style DAG:
+//     0 -> 1 -> 3 -> 5
+//       \-> 2 -/    /
+//     4 -----------/
+class TaskGraphFrame {
+public:
+  TaskGraphFrame() { next.store(0); }
+  void mark(int node) { order[node] = next.fetch_add(1); }
+  void markEnd(int* slot) { *slot = next.fetch_add(1); }
+  std::atomic<int> next;
+  int order[6];
+};
+
+TEST(TaskGraph, DependencyOrder) {
+  const int edges[][2] = {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 5}, {4, 5}};
+  const int num_edges = sizeof(edges) / sizeof(edges[0]);
+  ThreadPool tp(TG_NUM_WORKERS, TP_WORK_STEALING);
+  TaskGraphFrame frame;
+  TaskGraph graph(&tp);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(graph.addNode(MakeCallableMany(&TaskGraphFrame::mark, &frame,
+      i)), i);
+  }
+  for (int i = 0; i < num_edges; i++) {
+    graph.addEdge(edges[i][0], edges[i][1]);
+  }
+
+  // The same graph is run every frame without restarting the pool
+  int num_wrong = 0;
+  int num_continuations_wrong = 0;
+  for (int f = 0; f < TG_NUM_FRAMES; f++) {
+    frame.next.store(0);
+    int end_of_frame = -1;
+    graph.run();
+    graph.then(MakeCallableOnce(&TaskGraphFrame::markEnd, &frame,
+      &end_of_frame));
+    graph.wait();
+    for (int i = 0; i < num_edges; i++) {
+      if (frame.order[edges[i][0]] >= frame.order[edges[i][1]]) {
+        num_wrong++;
+      }
+    }
+    if (end_of_frame != 6) {
+      num_continuations_wrong++;
+    }
+  }
+  EXPECT_EQ(num_wrong, 0);
+  EXPECT_EQ(num_continuations_wrong, 0);
+  tp.stop();
+}
+
+TEST(TaskGraph, Cycle) {
+  ThreadPool tp(TG_NUM_WORKERS);
+  CounterThreadSafe c;
+  TaskGraph graph(&tp);
+  int a = graph.addNode(MakeCallableMany(&CounterThreadSafe::inc, &c));
+  int b = graph.addNode(MakeCallableMany(&CounterThreadSafe::inc, &c));
+  graph.addEdge(a, b);
+  graph.addEdge(b, a);
+  bool thrown = false;
+  try {
+    graph.run();
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  EXPECT_EQ(c.count(), 0);
+  tp.stop();
+}
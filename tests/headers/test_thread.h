@@ -9,6 +9,10 @@
 
 #include <thread>
 #include <sstream>
+#if defined(__linux__)
+  #include <sys/prctl.h>
+  #include <string.h>
+#endif
 #include "test_unit/test_unit.h"
 #include "test_unit/test_util.h"
 #include "jtil/threading/thread.h"
@@ -25,6 +29,10 @@ using jtil::threading::MakeCallableOnce;
 using jtil::threading::MakeCallableMany;
 using jtil::threading::MakeThread;
 using jtil::threading::GetThreadID;
+using jtil::threading::SetThreadName;
+using jtil::threading::GetNumCPUs;
+using jtil::threading::GetPhysicalCoreCPUs;
+using jtil::threading::GetCPUNumaNode;
 
 int count = 0;
 void DumbCounter() {
@@ -101,3 +109,35 @@ TEST(Creation, MakeAndExecuteMany) {
   // Check that the counter incremented
   EXPECT_EQ(NUM_EXECUTE_THREADS, c.count());
 }
+
+// Sanity checks only, the topology depends on the machine
+TEST(Placement, CPUTopology) {
+  const int num_cpus = GetNumCPUs();
+  EXPECT_TRUE(num_cpus >= 1);
+  int* cores = new int[num_cpus];
+  const int num_cores = GetPhysicalCoreCPUs(cores, num_cpus);
+  EXPECT_TRUE(num_cores >= 1 && num_cores <= num_cpus);
+  for (int i = 0; i < num_cores; i++) {
+    EXPECT_TRUE(cores[i] >= 0);
+    EXPECT_TRUE(GetCPUNumaNode(cores[i]) >= 0);
+    for (int j = 0; j < i; j++) {
+      EXPECT_NEQ(cores[i], cores[j]);
+    }
+  }
+  delete[] cores;
+}
+
+#if defined(__linux__)
+// SetThreadName used to give every thread the name "thread_name"
+static char thread_name_read_back[16];
+static void NameThread() {
+  SetThreadName("jtil-test-name");
+  prctl(PR_GET_NAME, thread_name_read_back, 0, 0, 0);
+}
+
+TEST(Placement, SetThreadName) {
+  std::thread th(NameThread);
+  th.join();
+  EXPECT_EQ(strcmp(thread_name_read_back, "jtil-test-name"), 0);
+}
+#endif
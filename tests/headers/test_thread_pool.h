@@ -9,12 +9,16 @@
 
 #include <stdlib.h>  // exit
 #include <thread>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
 #include <sstream>
 #include "test_unit/test_unit.h"
 #include "test_unit/test_util.h"
 #include "jtil/threading/thread.h"
 #include "jtil/threading/callback.h"
 #include "jtil/threading/thread_pool.h"
+#include "jtil/exceptions/wruntime_error.h"
 
 #define NUM_WORKERS 4  // Should be as many as the number of avaliable cores
 #define NUM_TASK_REQUESTS 1001  // A non-trivial number
@@ -22,10 +26,23 @@
 #define NUM_TEST_REPEATS 11
 
 using jtil::threading::ThreadPool;
+using jtil::threading::TP_WORK_STEALING;
+using jtil::threading::TP_LOCK_FREE_QUEUE;
 using tests::CounterThreadSafe;
 using jtil::threading::Callback;
 using jtil::threading::MakeCallableOnce;
 using jtil::threading::MakeCallableMany;
+using jtil::threading::MakeTask;
+using jtil::threading::Task;
+using jtil::threading::ThreadPoolPriority;
+using jtil::threading::TP_PRIORITY_LOW;
+using jtil::threading::TP_PRIORITY_NORMAL;
+using jtil::threading::TP_PRIORITY_HIGH;
+using jtil::threading::TP_NUM_PRIORITIES;
+using jtil::threading::ThreadPoolPlacement;
+using jtil::threading::ThreadPoolStats;
+using jtil::threading::ThreadPoolWorkerStats;
+using jtil::threading::ThreadPoolElastic;
 
 // Create a thread pool, add one task and then request a stop
 TEST(ThreadPool, CreateAddOnceAndStop) {
@@ -111,7 +128,7 @@ TEST(ThreadPool, CreateAfterStopped) {
   // Create the callback associated with one counter increment and add the task
   Callback<void>* threadBody = MakeCallableOnce(&CounterThreadSafe::incBy, &c,
                                                 COUNT_STRIDE);
-  tp.addTask(threadBody);
+  EXPECT_FALSE(tp.addTask(threadBody));
 
   // We want to test that threadBody isn't executed.  Try yielding this thread
   // a few times to make sure that we give the TP enough time to make a mistake.
@@ -120,10 +137,766 @@ TEST(ThreadPool, CreateAfterStopped) {
   }
 
   // Make sure the thread DIDN'T run:
-  // a) There should be no waiting tasks left
-  EXPECT_EQ(tp.count(), 1);
+  // a) It was rejected rather than queued (and deleted, being a once task)
+  EXPECT_EQ(tp.count(), 0);
   // b) The counter shouldn't have incremented.
   EXPECT_EQ(c.count(), 0);
 }
 
+// Same as CreateAddManyAndStop but using the work stealing scheduler
+TEST(ThreadPool, WorkStealingAddManyAndStop) {
+  CounterThreadSafe c;
+
+  for (int i = 0; i < NUM_TEST_REPEATS; i ++) {
+    ThreadPool* tp = new ThreadPool(NUM_WORKERS, TP_WORK_STEALING);
+
+    Callback<void>* threadBodyInc = MakeCallableMany(&CounterThreadSafe::incBy,
+                                                     &c, COUNT_STRIDE);
+    Callback<void>* threadBody = MakeCallableMany(&CounterThreadSafe::inc, &c);
+    for ( int i = 0; i < NUM_TASK_REQUESTS; i ++)
+      tp->addTask(threadBodyInc);
+    for ( int i = 0; i < NUM_TASK_REQUESTS; i ++)
+      tp->addTask(threadBody);
+
+    Callback<void>* p_StopTask = MakeCallableOnce(&ThreadPool::stop, tp);
+    tp->addTask(p_StopTask);
+
+    while (tp->count()>0) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(tp->count(), 0);
+
+    delete tp;  // destructor will wait for stop to finish
+    delete threadBodyInc;
+    delete threadBody;
+
+    EXPECT_EQ(c.count(), (COUNT_STRIDE + 1) * NUM_TASK_REQUESTS);
+    c.reset();
+  }
+}
+
+// A task that recursively adds child tasks from inside the worker threads (so
+// that they are pushed onto the worker's own deque and must be stolen by the
+// other workers).
+class RecursiveSpawner {
+public:
+  RecursiveSpawner(ThreadPool* tp, CounterThreadSafe* c) : tp_(tp), c_(c) { }
+  void spawn(int depth) {
+    c_->inc();
+    if (depth > 0) {
+      tp_->addTask(MakeCallableOnce(&RecursiveSpawner::spawn, this, depth-1));
+      tp_->addTask(MakeCallableOnce(&RecursiveSpawner::spawn, this, depth-1));
+    }
+  }
+private:
+  ThreadPool* tp_;
+  CounterThreadSafe* c_;
+};
+
+TEST(ThreadPool, WorkStealingNestedTasks) {
+  const int depth = 10;
+  const int num_tasks = (1 << (depth + 1)) - 1;
+  ThreadPool tp(NUM_WORKERS, TP_WORK_STEALING);
+  CounterThreadSafe c;
+  RecursiveSpawner spawner(&tp, &c);
+  tp.addTask(MakeCallableOnce(&RecursiveSpawner::spawn, &spawner, depth));
+
+  // count() only tracks queued tasks, so wait on the counter instead
+  while (c.count() < num_tasks) {
+    std::this_thread::yield();
+  }
+  tp.stop();
+  EXPECT_EQ(tp.count(), 0);
+  EXPECT_EQ(c.count(), num_tasks);
+}
+
+TEST(ThreadPool, WorkStealingCreateAfterStopped) {
+  ThreadPool tp(NUM_WORKERS, TP_WORK_STEALING);
+  CounterThreadSafe c;
+
+  tp.stop();
+
+  Callback<void>* threadBody = MakeCallableOnce(&CounterThreadSafe::incBy, &c,
+                                                COUNT_STRIDE);
+  EXPECT_FALSE(tp.addTask(threadBody));
+  for (int i = 0; i < 101; i ++) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(tp.count(), 0);
+  EXPECT_EQ(c.count(), 0);
+}
+
+// Same as CreateAddManyAndStop but using the lock-free queues
+TEST(ThreadPool, LockFreeQueueAddManyAndStop) {
+  CounterThreadSafe c;
+
+  for (int i = 0; i < NUM_TEST_REPEATS; i ++) {
+    ThreadPool* tp = new ThreadPool(NUM_WORKERS, TP_LOCK_FREE_QUEUE);
+
+    Callback<void>* threadBodyInc = MakeCallableMany(&CounterThreadSafe::incBy,
+                                                     &c, COUNT_STRIDE);
+    Callback<void>* threadBody = MakeCallableMany(&CounterThreadSafe::inc, &c);
+    for ( int i = 0; i < NUM_TASK_REQUESTS; i ++)
+      tp->addTask(threadBodyInc);
+    for ( int i = 0; i < NUM_TASK_REQUESTS; i ++)
+      tp->addTask(threadBody);
+
+    Callback<void>* p_StopTask = MakeCallableOnce(&ThreadPool::stop, tp);
+    tp->addTask(p_StopTask);
+
+    while (tp->count()>0) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(tp->count(), 0);
+
+    delete tp;  // destructor will wait for stop to finish
+    delete threadBodyInc;
+    delete threadBody;
+
+    EXPECT_EQ(c.count(), (COUNT_STRIDE + 1) * NUM_TASK_REQUESTS);
+    c.reset();
+  }
+}
+
+// Add more tasks than the lock-free queue can hold so that some of them
+// overflow onto the locked queue.
+TEST(ThreadPool, LockFreeQueueOverflow) {
+  const int num_tasks = 3 * THREAD_POOL_LOCK_FREE_QUEUE_SIZE;
+  ThreadPool tp(1, TP_LOCK_FREE_QUEUE);
+  CounterThreadSafe c;
+  Callback<void>* threadBody = MakeCallableMany(&CounterThreadSafe::inc, &c);
+  for (int i = 0; i < num_tasks; i++) {
+    tp.addTask(threadBody);
+  }
+  while (c.count() < num_tasks) {
+    std::this_thread::yield();
+  }
+  tp.stop();
+  EXPECT_EQ(tp.count(), 0);
+  EXPECT_EQ(c.count(), num_tasks);
+  delete threadBody;
+}
+
+TEST(ThreadPool, LockFreeQueueCreateAfterStopped) {
+  ThreadPool tp(NUM_WORKERS, TP_LOCK_FREE_QUEUE);
+  CounterThreadSafe c;
+
+  tp.stop();
+
+  Callback<void>* threadBody = MakeCallableOnce(&CounterThreadSafe::incBy, &c,
+                                                COUNT_STRIDE);
+  EXPECT_FALSE(tp.addTask(threadBody));
+  for (int i = 0; i < 101; i ++) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(tp.count(), 0);
+  EXPECT_EQ(c.count(), 0);
+}
+
+// A long task and then a short one, with a worker free for the short one
+class LongAndShortTasks {
+public:
+  LongAndShortTasks() {
+    open.store(false);
+    num_long.store(0);
+    num_short.store(0);
+  }
+  void longTask() {
+    while (!open.load()) {
+      std::this_thread::yield();
+    }
+    num_long++;
+  }
+  void shortTask() { num_short++; }
+  std::atomic<bool> open;
+  std::atomic<int> num_long;
+  std::atomic<int> num_short;
+};
+
+// A worker that picks up a task while it is still on the idle queue must not
+// soak up the wake up meant for a worker that is actually idle: the short
+// task has to run while the long one is still going.
+TEST(ThreadPool, LockFreeQueueWakesIdleWorker) {
+  ThreadPool tp(2, TP_LOCK_FREE_QUEUE);
+  LongAndShortTasks tasks;
+  for (int i = 0; i < 10 * NUM_TEST_REPEATS; i++) {
+    tasks.open.store(false);
+    // The worker finishing the first short task and going idle races with
+    // the long task being added, so it sometimes takes it on its re-check
+    tp.addTask(MakeTask(&LongAndShortTasks::shortTask, &tasks));
+    tp.addTask(MakeTask(&LongAndShortTasks::longTask, &tasks));
+    tp.addTask(MakeTask(&LongAndShortTasks::shortTask, &tasks));
+    const std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (tasks.num_short.load() < 2 * (i + 1) &&
+      std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(tasks.num_short.load(), 2 * (i + 1));
+    tasks.open.store(true);
+    while (tasks.num_long.load() < i + 1) {
+      std::this_thread::yield();
+    }
+  }
+  tp.stop();
+}
+
+// Keeps adding tasks (from outside the pool) until the pool rejects one
+class AddUntilRejected {
+public:
+  AddUntilRejected(ThreadPool* tp, CounterThreadSafe* c) : tp_(tp), c_(c) {
+    num_accepted.store(0);
+  }
+  void run() {
+    while (tp_->addTask(MakeCallableOnce(&CounterThreadSafe::inc, c_))) {
+      num_accepted++;
+    }
+  }
+  std::atomic<int> num_accepted;
+private:
+  ThreadPool* tp_;
+  CounterThreadSafe* c_;
+};
+
+// An add racing with stop() is either rejected or queued before stop()
+// returns: nothing gets in afterwards, and every accepted task either ran or
+// is still queued (and freed with the pool).
+TEST(ThreadPool, AddWhileStopping) {
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  for (int m = 0; m < 3; m++) {
+    for (int i = 0; i < NUM_TEST_REPEATS; i++) {
+      ThreadPool tp(NUM_WORKERS, modes[m]);
+      CounterThreadSafe c;
+      AddUntilRejected adder(&tp, &c);
+      std::thread thread = jtil::threading::MakeThread(MakeCallableOnce(
+        &AddUntilRejected::run, &adder));
+      while (adder.num_accepted.load() < 100) {
+        std::this_thread::yield();
+      }
+      tp.stop();
+      const int num_queued = tp.count();
+      thread.join();
+      EXPECT_EQ(tp.count(), num_queued);
+      EXPECT_EQ(c.count() + num_queued, adder.num_accepted.load());
+    }
+  }
+}
+
+// Tasks added by value, more than there are slots so that some of them end
+// up on the heap, then some more on a stopped pool (which rejects them, so
+// the caller runs them instead).
+TEST(ThreadPool, AddTaskByValue) {
+  const int num_tasks = 3 * THREAD_POOL_NUM_TASK_SLOTS;
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(NUM_WORKERS, modes[m]);
+    CounterThreadSafe c;
+    for (int i = 0; i < num_tasks; i++) {
+      tp.addTask(MakeTask(&CounterThreadSafe::incBy, &c, COUNT_STRIDE));
+    }
+    while (c.count() < num_tasks * COUNT_STRIDE) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    EXPECT_EQ(c.count(), num_tasks * COUNT_STRIDE);
+    for (int i = 0; i < num_tasks; i++) {
+      Task task = MakeTask(&CounterThreadSafe::inc, &c);
+      if (!tp.addTask(task)) {
+        task();
+      }
+    }
+    EXPECT_EQ(tp.count(), 0);
+    EXPECT_EQ(c.count(), num_tasks * (COUNT_STRIDE + 1));
+  }
+}
+
+// Batches (by pointer and by value) from outside and from inside the pool,
+// and then on a stopped pool which must reject them all.
+class AddTasksFanOut {
+public:
+  AddTasksFanOut(ThreadPool* tp, CounterThreadSafe* c) : tp_(tp), c_(c) { }
+  void run() {
+    Task tasks[NUM_TASK_REQUESTS];
+    for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+      tasks[i] = MakeTask(&CounterThreadSafe::inc, c_);
+    }
+    tp_->addTasks(tasks, NUM_TASK_REQUESTS);
+  }
+private:
+  ThreadPool* tp_;
+  CounterThreadSafe* c_;
+};
+
+TEST(ThreadPool, AddTasks) {
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  Callback<void>* tasks[NUM_TASK_REQUESTS];
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(NUM_WORKERS, modes[m]);
+    CounterThreadSafe c;
+    for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+      tasks[i] = MakeCallableOnce(&CounterThreadSafe::incBy, &c, COUNT_STRIDE);
+    }
+    tp.addTasks(tasks, NUM_TASK_REQUESTS);
+    AddTasksFanOut fan_out(&tp, &c);
+    tp.addTask(MakeTask(&AddTasksFanOut::run, &fan_out));
+    const int expected = NUM_TASK_REQUESTS * (COUNT_STRIDE + 1);
+    while (c.count() < expected) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    EXPECT_EQ(c.count(), expected);
+    for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+      tasks[i] = MakeCallableOnce(&CounterThreadSafe::inc, &c);
+    }
+    EXPECT_FALSE(tp.addTasks(tasks, NUM_TASK_REQUESTS));
+    EXPECT_EQ(tp.count(), 0);
+    EXPECT_EQ(c.count(), expected);
+  }
+}
+
+// Records the order tasks start in.  gate() blocks a worker until open.
+class PriorityRecorder {
+public:
+  PriorityRecorder() { next.store(0); started.store(0); open.store(false); }
+  void mark(int i) { order[i] = next.fetch_add(1); }
+  void gate() {
+    started.fetch_add(1);
+    while (!open.load()) {
+      std::this_thread::yield();
+    }
+  }
+  void waitForStarted(const int n) {
+    while (started.load() < n) {
+      std::this_thread::yield();
+    }
+  }
+  std::atomic<int> next;
+  std::atomic<int> started;
+  std::atomic<bool> open;
+  int order[3 * NUM_TASK_REQUESTS];
+};
+
+// With one (busy) worker, everything queued in a higher lane must start
+// before anything in a lower lane, whatever order they were added in.
+TEST(ThreadPool, PriorityOrder) {
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  const ThreadPoolPriority priorities[] = {TP_PRIORITY_LOW,
+    TP_PRIORITY_NORMAL, TP_PRIORITY_HIGH};
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(1, modes[m]);
+    PriorityRecorder rec;
+    tp.addTask(MakeTask(&PriorityRecorder::gate, &rec));
+    rec.waitForStarted(1);
+    // Task i has priority i % 3
+    for (int i = 0; i < 3 * NUM_TASK_REQUESTS; i++) {
+      tp.addTask(MakeTask(&PriorityRecorder::mark, &rec, i), priorities[i % 3]);
+    }
+    EXPECT_EQ(tp.count(), 3 * NUM_TASK_REQUESTS);
+    rec.open.store(true);
+    while (rec.next.load() < 3 * NUM_TASK_REQUESTS) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    int num_wrong = 0;
+    for (int i = 0; i < 3 * NUM_TASK_REQUESTS; i++) {
+      // The first NUM_TASK_REQUESTS tasks to start are HIGH, etc
+      const int lane = 2 - rec.order[i] / NUM_TASK_REQUESTS;
+      if (lane != i % 3) {
+        num_wrong++;
+      }
+    }
+    EXPECT_EQ(num_wrong, 0);
+  }
+}
+
+// One of two workers is reserved for TP_PRIORITY_HIGH.  While the other is
+// stuck on a background task, a high priority task must still run and a low
+// priority one must not.
+TEST(ThreadPool, PriorityReservedWorkers) {
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  int num_reserved[TP_NUM_PRIORITIES] = {0};
+  num_reserved[TP_PRIORITY_HIGH] = 1;
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(2, modes[m], num_reserved);
+    EXPECT_EQ(tp.workerPriority(0), TP_PRIORITY_LOW);
+    EXPECT_EQ(tp.workerPriority(1), TP_PRIORITY_HIGH);
+    PriorityRecorder rec;
+    CounterThreadSafe c;
+    tp.addTask(MakeTask(&PriorityRecorder::gate, &rec), TP_PRIORITY_LOW);
+    rec.waitForStarted(1);
+    tp.addTask(MakeTask(&CounterThreadSafe::inc, &c), TP_PRIORITY_LOW);
+    tp.addTask(MakeTask(&CounterThreadSafe::incBy, &c, COUNT_STRIDE),
+      TP_PRIORITY_HIGH);
+    while (c.count() < COUNT_STRIDE) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(c.count(), COUNT_STRIDE);
+    rec.open.store(true);
+    while (c.count() < COUNT_STRIDE + 1) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+  }
+
+  // Somebody has to be left to run the low priority tasks
+  num_reserved[TP_PRIORITY_NORMAL] = 1;
+  bool thrown = false;
+  try {
+    ThreadPool tp(2, jtil::threading::TP_SHARED_QUEUE, num_reserved);
+    tp.stop();
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+}
+
+// Records which CPU each task ran on
+class PlacementRecorder {
+public:
+  PlacementRecorder() { num_done.store(0); num_wrong_cpu.store(0); }
+  void check(int expected_cpu) {
+    if (jtil::threading::GetCurrentCPU() != expected_cpu) {
+      num_wrong_cpu.fetch_add(1);
+    }
+    num_done.fetch_add(1);
+  }
+  std::atomic<int> num_done;
+  std::atomic<int> num_wrong_cpu;
+};
+
+// Workers pinned to one CPU must only run there.  Then every mode with one
+// worker per physical core (and NUMA local stealing) must still run
+// everything, including nested tasks.
+TEST(ThreadPool, Placement) {
+  int cpu;
+  EXPECT_EQ(jtil::threading::GetPhysicalCoreCPUs(&cpu, 1), 1);
+  ThreadPoolPlacement placement;
+  placement.affinity = jtil::threading::TP_AFFINITY_CPU_LIST;
+  placement.cpus = &cpu;
+  placement.num_cpus = 1;
+  ThreadPool pinned_tp(2, jtil::threading::TP_SHARED_QUEUE, NULL, &placement);
+  PlacementRecorder rec;
+  for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+    pinned_tp.addTask(MakeTask(&PlacementRecorder::check, &rec, cpu));
+  }
+  while (rec.num_done.load() < NUM_TASK_REQUESTS) {
+    std::this_thread::yield();
+  }
+  pinned_tp.stop();
+  if (pinned_tp.workerCPU(0) == cpu) {  // Otherwise the OS doesn't pin
+    EXPECT_EQ(pinned_tp.workerCPU(1), cpu);
+    EXPECT_EQ(rec.num_wrong_cpu.load(), 0);
+  }
+
+  placement.affinity = jtil::threading::TP_AFFINITY_PHYSICAL_CORES;
+  placement.numa_local_queues = true;
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(NUM_WORKERS, modes[m], NULL, &placement);
+    CounterThreadSafe c;
+    RecursiveSpawner spawner(&tp, &c);
+    const int depth = 10;
+    tp.addTask(MakeCallableOnce(&RecursiveSpawner::spawn, &spawner, depth));
+    while (c.count() < (1 << (depth + 1)) - 1) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    EXPECT_EQ(c.count(), (1 << (depth + 1)) - 1);
+  }
+
+  placement.num_cpus = 0;
+  placement.affinity = jtil::threading::TP_AFFINITY_CPU_LIST;
+  bool thrown = false;
+  try {
+    ThreadPool tp(2, jtil::threading::TP_SHARED_QUEUE, NULL, &placement);
+    tp.stop();
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+}
+
+// Every task run while stats are on is counted exactly once, and nothing is
+// counted while they are off.
+TEST(ThreadPool, Stats) {
+  EXPECT_EQ(jtil::threading::ThreadPoolHistogram::bucket(0), 0);
+  EXPECT_EQ(jtil::threading::ThreadPoolHistogram::bucket(1999), 0);
+  EXPECT_EQ(jtil::threading::ThreadPoolHistogram::bucket(2000), 1);
+  EXPECT_EQ(jtil::threading::ThreadPoolHistogram::bucket(-1), 0);
+  EXPECT_EQ(jtil::threading::ThreadPoolHistogram::bucket(INT64_MAX),
+    THREAD_POOL_HISTOGRAM_NUM_BUCKETS - 1);
+
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(NUM_WORKERS, modes[m]);
+    CounterThreadSafe c;
+    ThreadPoolStats before;
+    tp.getStats(&before);
+    EXPECT_EQ(before.workers.size(), static_cast<uint32_t>(NUM_WORKERS));
+    EXPECT_EQ(before.total.num_tasks, 0);
+    tp.setStatsEnabled(true);
+    for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+      tp.addTask(MakeTask(&CounterThreadSafe::inc, &c));
+    }
+    while (c.count() < NUM_TASK_REQUESTS) {
+      std::this_thread::yield();
+    }
+    tp.setStatsEnabled(false);
+    for (int i = 0; i < NUM_TASK_REQUESTS; i++) {
+      tp.addTask(MakeTask(&CounterThreadSafe::inc, &c));
+    }
+    while (c.count() < 2 * NUM_TASK_REQUESTS) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    // The last task may still be updating its counters until stop()
+    ThreadPoolStats after;
+    tp.getStats(&after);
+    after.subtract(before);
+    const ThreadPoolWorkerStats& total = after.total;
+    EXPECT_EQ(total.num_tasks, NUM_TASK_REQUESTS);
+    EXPECT_EQ(total.num_latency_samples, NUM_TASK_REQUESTS);
+    EXPECT_EQ(total.run_time.count(), NUM_TASK_REQUESTS);
+    EXPECT_EQ(total.latency.count(), NUM_TASK_REQUESTS);
+    EXPECT_TRUE(total.busy_ns > 0 && total.latency_ns > 0);
+    EXPECT_TRUE(total.latency.percentileUS(0.5) <=
+      total.latency.percentileUS(0.99));
+    uint64_t num_tasks = 0;
+    for (uint32_t i = 0; i < after.workers.size(); i++) {
+      num_tasks += after.workers[i].num_tasks;
+    }
+    EXPECT_EQ(num_tasks, NUM_TASK_REQUESTS);
+    EXPECT_EQ(after.queue_depth, 0);
+  }
+}
+
+// Spins for a little while so that a burst of them backs up the queue
+struct ElasticSpin {
+  explicit ElasticSpin(CounterThreadSafe* c) : c(c) { }
+  void operator()() {
+    std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+    while (std::chrono::steady_clock::now() < end) { }
+    c->inc();
+  }
+  CounterThreadSafe* c;
+};
+
+// Idle workers retire down to min_workers, a burst of work brings them back
+// (and every task still runs), and they retire again once it's over.
+TEST(ThreadPool, Elastic) {
+  ThreadPoolElastic elastic;
+  elastic.min_workers = 1;
+  elastic.idle_timeout_ms = 20;
+  elastic.grow_queue_depth = 4;
+  elastic.grow_latency_us = 500;
+  ThreadPool tp(NUM_WORKERS);
+  EXPECT_EQ(tp.numRunningWorkers(), NUM_WORKERS);
+  tp.setElastic(elastic);
+  for (int i = 0; i < 1000 && tp.numRunningWorkers() > 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(tp.numRunningWorkers(), 1);
+
+  CounterThreadSafe c;
+  const int num_tasks = 1000;
+  int max_running = 0;
+  for (int i = 0; i < num_tasks; i++) {
+    tp.addTask(MakeTask(ElasticSpin(&c)));
+    max_running = std::max<int>(max_running, tp.numRunningWorkers());
+  }
+  while (c.count() < num_tasks) {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(max_running > 1);
+  for (int i = 0; i < 1000 && tp.numRunningWorkers() > 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(tp.numRunningWorkers(), 1);
+  // Still works (and stops) with most of the workers retired
+  tp.addTask(MakeTask(&CounterThreadSafe::inc, &c));
+  while (c.count() < num_tasks + 1) {
+    std::this_thread::yield();
+  }
+  tp.stop();
+
+  ThreadPool tp_ws(2, TP_WORK_STEALING);
+  bool thrown = false;
+  try {
+    tp_ws.setElastic(elastic);
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  tp_ws.stop();
+}
+
+// Reserved workers never retire and don't count toward min_workers, so the
+// unreserved ones are always left to run TP_PRIORITY_LOW tasks
+TEST(ThreadPool, ElasticWithReservedWorkers) {
+  int num_reserved[TP_NUM_PRIORITIES] = {0};
+  num_reserved[TP_PRIORITY_HIGH] = 2;
+  ThreadPool tp(4, jtil::threading::TP_SHARED_QUEUE, num_reserved);
+  ThreadPoolElastic elastic;
+  elastic.min_workers = 3;  // Only 2 unreserved workers
+  elastic.idle_timeout_ms = 20;
+  bool thrown = false;
+  try {
+    tp.setElastic(elastic);
+  } catch (std::wruntime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+
+  elastic.min_workers = 1;
+  tp.setElastic(elastic);
+  for (int i = 0; i < 1000 && tp.numRunningWorkers() > 3; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(tp.numRunningWorkers(), 3);  // 2 reserved + 1 unreserved
+  CounterThreadSafe c;
+  tp.addTask(MakeTask(&CounterThreadSafe::inc, &c));
+  for (int i = 0; i < 1000 && c.count() < 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(c.count(), 1);
+  EXPECT_EQ(tp.count(), 0);
+  tp.stop();
+}
+
+// Functors for the parallelFor / parallelReduce tests
+struct ParallelForMark {
+  explicit ParallelForMark(int* marks) : marks(marks) { }
+  void operator()(const int b, const int e) const {
+    for (int i = b; i < e; i++) {
+      marks[i]++;
+    }
+  }
+  int* marks;
+};
+
+struct ParallelReduceSum {
+  explicit ParallelReduceSum(const float* vals) : vals(vals) { }
+  float operator()(const int b, const int e) const {
+    float sum = 0;
+    for (int i = b; i < e; i++) {
+      sum += vals[i];
+    }
+    return sum;
+  }
+  const float* vals;
+};
+
+struct ParallelReduceAdd {
+  float operator()(const float a, const float b) const { return a + b; }
+};
+
+// parallelFor should visit every index exactly once, for every pool mode and
+// for both a user defined grain and an automatic one.
+TEST(ThreadPool, ParallelFor) {
+  const int num_vals = 10007;  // prime, so the last chunk is always short
+  const jtil::threading::ThreadPoolMode modes[] = {
+    jtil::threading::TP_SHARED_QUEUE, TP_WORK_STEALING, TP_LOCK_FREE_QUEUE};
+  const int grains[] = {0, 1, 100, num_vals * 2};
+  int* marks = new int[num_vals];
+  for (int m = 0; m < 3; m++) {
+    ThreadPool tp(NUM_WORKERS, modes[m]);
+    for (int g = 0; g < 4; g++) {
+      for (int i = 0; i < num_vals; i++) {
+        marks[i] = 0;
+      }
+      tp.parallelFor(0, num_vals, grains[g], ParallelForMark(marks));
+      int num_wrong = 0;
+      for (int i = 0; i < num_vals; i++) {
+        num_wrong += marks[i] != 1 ? 1 : 0;
+      }
+      EXPECT_EQ(num_wrong, 0);
+    }
+    // Empty ranges are a no-op
+    tp.parallelFor(5, 5, 0, ParallelForMark(marks));
+    tp.stop();
+  }
+  delete[] marks;
+}
+
+// The reduction order is fixed, so the result must be bitwise identical to a
+// serial sum over the same chunks, however the chunks were scheduled.
+TEST(ThreadPool, ParallelReduce) {
+  const int num_vals = 100003;
+  const int grain = 1000;
+  float* vals = new float[num_vals];
+  for (int i = 0; i < num_vals; i++) {
+    vals[i] = 1.0f / static_cast<float>(i + 1);
+  }
+  float expected = 0;
+  for (int b = 0; b < num_vals; b += grain) {
+    float chunk_sum = 0;
+    for (int i = b; i < b + grain && i < num_vals; i++) {
+      chunk_sum += vals[i];
+    }
+    expected += chunk_sum;
+  }
+
+  ThreadPool tp(NUM_WORKERS, TP_WORK_STEALING);
+  for (int i = 0; i < NUM_TEST_REPEATS; i++) {
+    float sum = tp.parallelReduce(0, num_vals, grain, 0.0f, 
+      ParallelReduceSum(vals), ParallelReduceAdd());
+    EXPECT_EQ(sum, expected);
+  }
+  EXPECT_EQ(tp.parallelReduce(0, 0, grain, 3.0f, ParallelReduceSum(vals),
+    ParallelReduceAdd()), 3.0f);
+  tp.stop();
+  delete[] vals;
+}
+
+// A parallelFor issued from inside a task (the calling worker joins in), and
+// one issued on a stopped pool (the calling thread does all the work).
+class NestedParallelFor {
+public:
+  NestedParallelFor(ThreadPool* tp, int* marks, int num_vals) : tp_(tp), 
+    marks_(marks), num_vals_(num_vals) { done.store(false); }
+  void run() {
+    tp_->parallelFor(0, num_vals_, 10, ParallelForMark(marks_));
+    done.store(true);
+  }
+  std::atomic<bool> done;
+private:
+  ThreadPool* tp_;
+  int* marks_;
+  int num_vals_;
+};
+
+TEST(ThreadPool, ParallelForNestedAndStopped) {
+  const int num_vals = 1001;
+  int* marks = new int[num_vals];
+  for (int i = 0; i < num_vals; i++) {
+    marks[i] = 0;
+  }
+  ThreadPool tp(NUM_WORKERS);
+  NestedParallelFor nested(&tp, marks, num_vals);
+  tp.addTask(MakeCallableOnce(&NestedParallelFor::run, &nested));
+  while (!nested.done.load()) {
+    std::this_thread::yield();
+  }
+  tp.stop();
+  tp.parallelFor(0, num_vals, 10, ParallelForMark(marks));
+  int num_wrong = 0;
+  for (int i = 0; i < num_vals; i++) {
+    num_wrong += marks[i] != 2 ? 1 : 0;
+  }
+  EXPECT_EQ(num_wrong, 0);
+  delete[] marks;
+}
+
 #include "test_thread_pool_lerner.h"
@@ -0,0 +1,448 @@
+//
+//  test_thread_pool_profile.h
+//
+//  Task throughput of the ThreadPool schedulers as a function of the number of
+//  worker threads, and raw throughput of the queues they are built on.  These
+//  are benchmarks rather than correctness tests, so the numbers are only 
+//  printed (they only fail if tasks are lost).
+//
+//  Heap allocations per task are counted with the AllocTracker when jtil is
+//  built with JTIL_ALLOC_TRACKER.  Otherwise this header replaces the global
+//  operator new / delete to count them itself (except on Windows, where that
+//  would hide the allocations from the CRT debug heap's leak checks).
+
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <stdlib.h>  // malloc, free
+#include "test_unit/test_unit.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/callback_queue.h"
+#include "jtil/threading/lock_free_queue.h"
+#include "jtil/threading/callback.h"
+#include "jtil/threading/task.h"
+#include "jtil/clk/clk.h"
+#include "jtil/debug_util/alloc_tracker.h"
+
+#define PROFILE_TP_NUM_TASKS 200000
+#define PROFILE_TP_SPAWN_DEPTH 16  // 2^17 - 1 tasks
+#define PROFILE_TP_MAX_WORKERS 16
+#define PROFILE_QUEUE_NUM_ITEMS 1000000
+#define PROFILE_QUEUE_MAX_THREADS 8
+#define PROFILE_ALLOC_NUM_WORKERS 4
+#define PROFILE_ALLOC_BATCH_SIZE 256  // ie, image tiles per frame
+#define PROFILE_ALLOC_NUM_BATCHES 400
+#define PROFILE_LANE_NUM_BACKGROUND 64
+#define PROFILE_LANE_BACKGROUND_MS 5  // ie, decompressing an asset
+#define PROFILE_LANE_NUM_FRAME_TASKS 64
+
+using jtil::threading::ThreadPool;
+using jtil::threading::Callback;
+using jtil::threading::MakeCallableOnce;
+using jtil::threading::MakeCallableMany;
+using jtil::threading::ThreadPoolMode;
+using jtil::threading::TP_SHARED_QUEUE;
+using jtil::threading::TP_WORK_STEALING;
+using jtil::threading::TP_LOCK_FREE_QUEUE;
+using jtil::threading::CallbackQueue;
+using jtil::threading::LockFreeQueue;
+using jtil::threading::MakeTask;
+using jtil::threading::Task;
+using jtil::debug::AllocTracker;
+using jtil::debug::AllocStats;
+
+#if !defined(_WIN32) && !defined(JTIL_ALLOC_TRACKER)
+  #define PROFILE_COUNT_ALLOCATIONS
+  static std::atomic<int64_t> profile_num_allocs(0);
+
+  void* operator new(size_t size) {
+    profile_num_allocs.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+  void* operator new[](size_t size) {
+    return operator new(size);
+  }
+  void operator delete(void* ptr) noexcept {
+    free(ptr);
+  }
+  void operator delete[](void* ptr) noexcept {
+    free(ptr);
+  }
+#endif
+
+// The heap allocations so far, -1 if they can't be counted
+int64_t ProfileNumAllocs() {
+#ifdef PROFILE_COUNT_ALLOCATIONS
+  return profile_num_allocs.load();
+#else
+  if (!AllocTracker::supported()) {
+    return -1;
+  }
+  AllocStats stats;
+  AllocTracker::getStats(&stats);
+  return static_cast<int64_t>(stats.num_allocs);
+#endif
+}
+
+class ProfileTPTask {
+public:
+  explicit ProfileTPTask(ThreadPool* tp) : tp_(tp) { count.store(0); }
+  void inc() { count.fetch_add(1); }
+  void spawn(int depth) {
+    count.fetch_add(1);
+    if (depth > 0) {
+      tp_->addTask(MakeCallableOnce(&ProfileTPTask::spawn, this, depth - 1));
+      tp_->addTask(MakeCallableOnce(&ProfileTPTask::spawn, this, depth - 1));
+    }
+  }
+  std::atomic<int> count;
+private:
+  ThreadPool* tp_;
+};
+
+// Flat: N small tasks all added from the main thread
+static double ProfileTPFlat(const int num_workers, const ThreadPoolMode mode) {
+  jtil::clk::Clk clk;
+  ThreadPool tp(num_workers, mode);
+  ProfileTPTask task(&tp);
+  Callback<void>* body = MakeCallableMany(&ProfileTPTask::inc, &task);
+  double t0 = clk.getTime();
+  for (int i = 0; i < PROFILE_TP_NUM_TASKS; i++) {
+    tp.addTask(body);
+  }
+  while (task.count.load() < PROFILE_TP_NUM_TASKS) {
+    std::this_thread::yield();
+  }
+  double t1 = clk.getTime();
+  tp.stop();
+  delete body;
+  return static_cast<double>(PROFILE_TP_NUM_TASKS) / (t1 - t0);
+}
+
+// Nested: a binary tree of tasks, each spawned from inside a worker
+static double ProfileTPNested(const int num_workers,
+  const ThreadPoolMode mode) {
+  const int num_tasks = (1 << (PROFILE_TP_SPAWN_DEPTH + 1)) - 1;
+  jtil::clk::Clk clk;
+  ThreadPool tp(num_workers, mode);
+  ProfileTPTask task(&tp);
+  double t0 = clk.getTime();
+  tp.addTask(MakeCallableOnce(&ProfileTPTask::spawn, &task,
+    PROFILE_TP_SPAWN_DEPTH));
+  while (task.count.load() < num_tasks) {
+    std::this_thread::yield();
+  }
+  double t1 = clk.getTime();
+  tp.stop();
+  return static_cast<double>(num_tasks) / (t1 - t0);
+}
+
+TEST(ProfileThreadPool, TaskThroughputVsWorkers) {
+  const ThreadPoolMode modes[] = {TP_SHARED_QUEUE, TP_WORK_STEALING,
+    TP_LOCK_FREE_QUEUE};
+  const int num_modes = sizeof(modes) / sizeof(modes[0]);
+  std::cout << std::endl;
+  std::cout << "  workers | flat: shared stealing lock-free | "
+    << "nested: shared stealing lock-free  (tasks / sec)" << std::endl;
+  for (int w = 1; w <= PROFILE_TP_MAX_WORKERS; w *= 2) {
+    std::cout << "  " << w << " |";
+    for (int i = 0; i < num_modes; i++) {
+      std::cout << " " << ProfileTPFlat(w, modes[i]);
+    }
+    std::cout << " |";
+    for (int i = 0; i < num_modes; i++) {
+      std::cout << " " << ProfileTPNested(w, modes[i]);
+    }
+    std::cout << std::endl;
+  }
+}
+
+// The queue the thread pool used to use: a CallbackQueue behind a mutex
+class ProfileLockedQueue {
+public:
+  bool enqueue(const int& item) {
+    std::unique_lock<std::mutex> lock(lock_);
+    queue_.enqueue(item);
+    return true;
+  }
+  bool dequeue(int& item) {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (queue_.empty()) {
+      return false;
+    }
+    item = queue_.dequeue();
+    return true;
+  }
+private:
+  std::mutex lock_;
+  CallbackQueue<int> queue_;
+};
+
+template <class Queue>
+static void ProfileQueueProducer(Queue* q, const int num_items) {
+  for (int i = 0; i < num_items; i++) {
+    while (!q->enqueue(i)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <class Queue>
+static void ProfileQueueConsumer(Queue* q, std::atomic<int>* num_consumed,
+  const int num_items) {
+  int item;
+  while (num_consumed->load(std::memory_order_relaxed) < num_items) {
+    if (q->dequeue(item)) {
+      num_consumed->fetch_add(1, std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// num_threads producers and num_threads consumers hammering the same queue
+template <class Queue>
+static double ProfileQueue(Queue* q, const int num_threads) {
+  const int items_per_thread = PROFILE_QUEUE_NUM_ITEMS / num_threads;
+  const int num_items = items_per_thread * num_threads;
+  std::atomic<int> num_consumed;
+  num_consumed.store(0);
+  std::thread producers[PROFILE_QUEUE_MAX_THREADS];
+  std::thread consumers[PROFILE_QUEUE_MAX_THREADS];
+  jtil::clk::Clk clk;
+  double t0 = clk.getTime();
+  for (int i = 0; i < num_threads; i++) {
+    consumers[i] = std::thread(ProfileQueueConsumer<Queue>, q, &num_consumed,
+      num_items);
+    producers[i] = std::thread(ProfileQueueProducer<Queue>, q,
+      items_per_thread);
+  }
+  for (int i = 0; i < num_threads; i++) {
+    producers[i].join();
+    consumers[i].join();
+  }
+  double t1 = clk.getTime();
+  return static_cast<double>(num_items) / (t1 - t0);
+}
+
+TEST(ProfileLockFreeQueue, ThroughputVsCallbackQueue) {
+  std::cout << std::endl;
+  std::cout << "  producers = consumers | CallbackQueue + mutex | "
+    << "LockFreeQueue  (items / sec)" << std::endl;
+  for (int n = 1; n <= PROFILE_QUEUE_MAX_THREADS; n *= 2) {
+    ProfileLockedQueue locked_queue;
+    LockFreeQueue<int> lock_free_queue(THREAD_POOL_LOCK_FREE_QUEUE_SIZE);
+    std::cout << "  " << n << " | " << ProfileQueue(&locked_queue, n) << " | "
+      << ProfileQueue(&lock_free_queue, n) << std::endl;
+  }
+}
+
+// Add PROFILE_ALLOC_NUM_BATCHES batches of small tasks (waiting for each batch
+// to finish, like a per-frame job) either as MakeCallableOnce pointers or as
+// Tasks by value.
+static void ProfileTPBatches(ThreadPool* tp, ProfileTPTask* task, 
+  const bool by_value) {
+  int num_done = task->count.load();
+  for (int b = 0; b < PROFILE_ALLOC_NUM_BATCHES; b++) {
+    for (int i = 0; i < PROFILE_ALLOC_BATCH_SIZE; i++) {
+      if (by_value) {
+        tp->addTask(MakeTask(&ProfileTPTask::inc, task));
+      } else {
+        tp->addTask(MakeCallableOnce(&ProfileTPTask::inc, task));
+      }
+    }
+    num_done += PROFILE_ALLOC_BATCH_SIZE;
+    while (task->count.load() < num_done) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// The same per-frame batches submitted one addTask() at a time or with a
+// single addTasks() call.
+static void ProfileTPAddTasks(ThreadPool* tp, ProfileTPTask* task,
+  const bool batched) {
+  Task tasks[PROFILE_ALLOC_BATCH_SIZE];
+  for (int i = 0; i < PROFILE_ALLOC_BATCH_SIZE; i++) {
+    tasks[i] = MakeTask(&ProfileTPTask::inc, task);
+  }
+  int num_done = task->count.load();
+  for (int b = 0; b < PROFILE_ALLOC_NUM_BATCHES; b++) {
+    if (batched) {
+      tp->addTasks(tasks, PROFILE_ALLOC_BATCH_SIZE);
+    } else {
+      for (int i = 0; i < PROFILE_ALLOC_BATCH_SIZE; i++) {
+        tp->addTask(tasks[i]);
+      }
+    }
+    num_done += PROFILE_ALLOC_BATCH_SIZE;
+    while (task->count.load() < num_done) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+TEST(ProfileThreadPool, AddTasksBatch) {
+  const ThreadPoolMode modes[] = {TP_SHARED_QUEUE, TP_WORK_STEALING,
+    TP_LOCK_FREE_QUEUE};
+  const char* mode_names[] = {"shared", "stealing", "lock-free"};
+  const int num_tasks = PROFILE_ALLOC_NUM_BATCHES * PROFILE_ALLOC_BATCH_SIZE;
+  std::cout << std::endl;
+  std::cout << "  mode | addTask (tasks / sec) | addTasks (tasks / sec)"
+    << std::endl;
+  for (int m = 0; m < 3; m++) {
+    std::cout << "  " << mode_names[m];
+    for (int batched = 0; batched < 2; batched++) {
+      jtil::clk::Clk clk;
+      ThreadPool tp(PROFILE_ALLOC_NUM_WORKERS, modes[m]);
+      ProfileTPTask task(&tp);
+      ProfileTPAddTasks(&tp, &task, batched != 0);  // Warm up the queues
+      double t0 = clk.getTime();
+      ProfileTPAddTasks(&tp, &task, batched != 0);
+      double t1 = clk.getTime();
+      std::cout << " | " << static_cast<double>(num_tasks) / (t1 - t0);
+      tp.stop();
+      EXPECT_EQ(task.count.load(), 2 * num_tasks);
+    }
+    std::cout << std::endl;
+  }
+}
+
+// Throughput of small tasks with the pool's stats off and on
+TEST(ProfileThreadPool, StatsOverhead) {
+  const ThreadPoolMode modes[] = {TP_SHARED_QUEUE, TP_WORK_STEALING,
+    TP_LOCK_FREE_QUEUE};
+  const char* mode_names[] = {"shared", "stealing", "lock-free"};
+  const int num_tasks = PROFILE_ALLOC_NUM_BATCHES * PROFILE_ALLOC_BATCH_SIZE;
+  std::cout << std::endl;
+  std::cout << "  mode | stats off (tasks / sec) | stats on (tasks / sec)"
+    << std::endl;
+  for (int m = 0; m < 3; m++) {
+    std::cout << "  " << mode_names[m];
+    for (int stats = 0; stats < 2; stats++) {
+      jtil::clk::Clk clk;
+      ThreadPool tp(PROFILE_ALLOC_NUM_WORKERS, modes[m]);
+      tp.setStatsEnabled(stats != 0);
+      ProfileTPTask task(&tp);
+      ProfileTPAddTasks(&tp, &task, true);  // Warm up the queues
+      double t0 = clk.getTime();
+      ProfileTPAddTasks(&tp, &task, true);
+      double t1 = clk.getTime();
+      std::cout << " | " << static_cast<double>(num_tasks) / (t1 - t0);
+      tp.stop();
+      EXPECT_EQ(task.count.load(), 2 * num_tasks);
+    }
+    std::cout << std::endl;
+  }
+}
+
+TEST(ProfileThreadPool, AllocationsPerTask) {
+  const ThreadPoolMode modes[] = {TP_SHARED_QUEUE, TP_WORK_STEALING,
+    TP_LOCK_FREE_QUEUE};
+  const char* mode_names[] = {"shared", "stealing", "lock-free"};
+  const int num_tasks = PROFILE_ALLOC_NUM_BATCHES * PROFILE_ALLOC_BATCH_SIZE;
+  const bool was_enabled = AllocTracker::enabled();
+  AllocTracker::enable();
+  std::cout << std::endl;
+  std::cout << "  mode | MakeCallableOnce: allocs/task tasks/sec | "
+    << "Task: allocs/task tasks/sec" << std::endl;
+  for (int m = 0; m < 3; m++) {
+    std::cout << "  " << mode_names[m] << " |";
+    for (int by_value = 0; by_value < 2; by_value++) {
+      jtil::clk::Clk clk;
+      ThreadPool tp(PROFILE_ALLOC_NUM_WORKERS, modes[m]);
+      ProfileTPTask task(&tp);
+      ProfileTPBatches(&tp, &task, by_value != 0);  // Warm up the queues
+      int64_t allocs0 = ProfileNumAllocs();
+      double t0 = clk.getTime();
+      ProfileTPBatches(&tp, &task, by_value != 0);
+      double t1 = clk.getTime();
+      if (allocs0 >= 0) {
+        double allocs = static_cast<double>(ProfileNumAllocs() - allocs0);
+        std::cout << " " << allocs / static_cast<double>(num_tasks);
+      } else {
+        std::cout << " n/a";
+      }
+      std::cout << " " << static_cast<double>(num_tasks) / (t1 - t0);
+      std::cout << (by_value ? "" : " |");
+      tp.stop();
+      EXPECT_EQ(task.count.load(), 2 * num_tasks);
+    }
+    std::cout << std::endl;
+  }
+  if (!was_enabled) {
+    AllocTracker::disable();
+  }
+}
+
+// Frame tasks (short) submitted while the pool is flooded with background
+// tasks (PROFILE_LANE_BACKGROUND_MS each).  Reports the frame tasks' queue
+// latency (add to start) with everything in one lane, with the frame tasks
+// in TP_PRIORITY_HIGH and with one worker also reserved for them.
+class ProfileLaneLatency {
+public:
+  ProfileLaneLatency() { num_started.store(0); num_background.store(0); }
+  void background() {
+    const double t_end = clk.getTime() + PROFILE_LANE_BACKGROUND_MS * 1e-3;
+    while (clk.getTime() < t_end) { }
+    num_background.fetch_add(1);
+  }
+  void frame(int i) {
+    start_time[i] = clk.getTime();
+    num_started.fetch_add(1);
+  }
+  jtil::clk::Clk clk;
+  std::atomic<int> num_started;
+  std::atomic<int> num_background;
+  double add_time[PROFILE_LANE_NUM_FRAME_TASKS];
+  double start_time[PROFILE_LANE_NUM_FRAME_TASKS];
+};
+
+TEST(ProfileThreadPool, PriorityLaneLatency) {
+  const char* config_names[] = {"one lane", "high lane",
+    "high lane + 1 reserved"};
+  std::cout << std::endl;
+  std::cout << "  config | frame task latency: mean max (ms)" << std::endl;
+  for (int config = 0; config < 3; config++) {
+    int num_reserved[jtil::threading::TP_NUM_PRIORITIES] = {0};
+    num_reserved[jtil::threading::TP_PRIORITY_HIGH] = config == 2 ? 1 : 0;
+    ThreadPool tp(PROFILE_ALLOC_NUM_WORKERS, TP_SHARED_QUEUE, num_reserved);
+    const jtil::threading::ThreadPoolPriority frame_priority = config == 0 ?
+      jtil::threading::TP_PRIORITY_LOW : jtil::threading::TP_PRIORITY_HIGH;
+    ProfileLaneLatency lat;
+    for (int i = 0; i < PROFILE_LANE_NUM_BACKGROUND; i++) {
+      tp.addTask(MakeTask(&ProfileLaneLatency::background, &lat),
+        jtil::threading::TP_PRIORITY_LOW);
+    }
+    // A few frame tasks at a time, like per-frame jobs
+    for (int i = 0; i < PROFILE_LANE_NUM_FRAME_TASKS; i++) {
+      lat.add_time[i] = lat.clk.getTime();
+      tp.addTask(MakeTask(&ProfileLaneLatency::frame, &lat, i),
+        frame_priority);
+      if (i % 4 == 3) {
+        while (lat.num_started.load() <= i) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    while (lat.num_background.load() < PROFILE_LANE_NUM_BACKGROUND) {
+      std::this_thread::yield();
+    }
+    tp.stop();
+    double mean = 0;
+    double max = 0;
+    for (int i = 0; i < PROFILE_LANE_NUM_FRAME_TASKS; i++) {
+      const double latency = 1e3 * (lat.start_time[i] - lat.add_time[i]);
+      mean += latency / PROFILE_LANE_NUM_FRAME_TASKS;
+      max = latency > max ? latency : max;
+    }
+    std::cout << "  " << config_names[config] << " | " << mean << " " << max
+      << std::endl;
+  }
+}
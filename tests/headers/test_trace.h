@@ -0,0 +1,169 @@
+//
+//  test_trace.h
+//
+
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <stdlib.h>  // atoi
+#include "test_unit/test_unit.h"
+#include "jtil/debug_util/trace.h"
+#include "jtil/threading/thread.h"
+#include "jtil/threading/thread_pool.h"
+#include "jtil/threading/callback.h"
+
+#define TEST_TRACE_NUM_TASKS 10
+
+using jtil::debug::Trace;
+
+int TestTraceCount(const std::string& json, const std::string& str) {
+  int count = 0;
+  for (size_t pos = json.find(str); pos != std::string::npos;
+    pos = json.find(str, pos + str.size())) {
+    count++;
+  }
+  return count;
+}
+
+std::string TestTraceJSON() {
+  std::stringstream ss;
+  Trace::writeChromeJSON(ss);
+  return ss.str();
+}
+
+class TestTraceTasks {
+public:
+  TestTraceTasks() { num_done.store(0); }
+  void run() {
+    JTIL_TRACE_SCOPE("TestTraceTask");
+    num_done++;
+  }
+  std::atomic<int> num_done;
+};
+
+void TestTraceMany(const int num_scopes) {
+  jtil::threading::SetThreadName("TestTraceMany");
+  for (int i = 0; i < num_scopes; i++) {
+    JTIL_TRACE_SCOPE("TestTraceOuterMany");
+    JTIL_TRACE_SCOPE("TestTraceInnerMany");
+  }
+}
+
+TEST(Trace, ScopesAndThreads) {
+  {
+    JTIL_TRACE_SCOPE("TestTraceNotRecording");
+  }
+  Trace::start();
+  {
+    JTIL_TRACE_SCOPE("TestTraceOuter");
+    {
+      JTIL_TRACE_SCOPE("TestTraceInner");
+    }
+  }
+  jtil::threading::ThreadPool tp(2);
+  TestTraceTasks tasks;
+  for (int i = 0; i < TEST_TRACE_NUM_TASKS; i++) {
+    tp.addTask(jtil::threading::MakeCallableOnce(&TestTraceTasks::run,
+      &tasks));
+  }
+  while (tasks.num_done.load() < TEST_TRACE_NUM_TASKS) {
+    std::this_thread::yield();
+  }
+  tp.stop();  // The workers have ended their task scopes
+  Trace::stop();
+  {
+    JTIL_TRACE_SCOPE("TestTraceStopped");
+  }
+
+  const std::string json = TestTraceJSON();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0);
+  EXPECT_EQ(TestTraceCount(json, "TestTraceNotRecording"), 0);
+  EXPECT_EQ(TestTraceCount(json, "TestTraceStopped"), 0);
+  EXPECT_EQ(TestTraceCount(json, "\"TestTraceOuter\""), 2);
+  EXPECT_EQ(TestTraceCount(json, "\"TestTraceInner\""), 2);
+  EXPECT_EQ(TestTraceCount(json, "\"TestTraceTask\""),
+    2 * TEST_TRACE_NUM_TASKS);
+  EXPECT_EQ(TestTraceCount(json, "\"ThreadPool::task\""),
+    2 * TEST_TRACE_NUM_TASKS);
+  EXPECT_TRUE(TestTraceCount(json, "\"args\":{\"name\":\"TPWorker-") > 0);
+  EXPECT_EQ(TestTraceCount(json, "\"ph\":\"B\""),
+    TestTraceCount(json, "\"ph\":\"E\""));
+  // Nested: outer begin, inner begin, inner end, outer end
+  const size_t outer_b = json.find("\"TestTraceOuter\",\"ph\":\"B\"");
+  const size_t inner_b = json.find("\"TestTraceInner\",\"ph\":\"B\"");
+  const size_t inner_e = json.find("\"TestTraceInner\",\"ph\":\"E\"");
+  const size_t outer_e = json.find("\"TestTraceOuter\",\"ph\":\"E\"");
+  EXPECT_TRUE(outer_b < inner_b && inner_b < inner_e && inner_e < outer_e &&
+    outer_e != std::string::npos);
+
+  // A new recording drops the old events
+  Trace::start();
+  Trace::stop();
+  EXPECT_EQ(TestTraceCount(TestTraceJSON(), "\"TestTraceOuter\""), 0);
+}
+
+// Overflowing a ring buffer (and saving while it is being written) keeps the
+// newest events and begin / end pairs matched
+TEST(Trace, RingBufferOverflow) {
+  Trace::start();
+  std::thread thread(&TestTraceMany, 2 * TRACE_BUFFER_SIZE);
+  int num_unbalanced = 0;
+  for (int i = 0; i < 5; i++) {
+    const std::string json = TestTraceJSON();
+    num_unbalanced += TestTraceCount(json, "\"ph\":\"B\"") <
+      TestTraceCount(json, "\"ph\":\"E\"") ? 1 : 0;
+  }
+  thread.join();
+  Trace::stop();
+  const std::string json = TestTraceJSON();
+  EXPECT_EQ(num_unbalanced, 0);
+  EXPECT_EQ(TestTraceCount(json, "\"args\":{\"name\":\"TestTraceMany\"}"), 1);
+  const int num_outer = TestTraceCount(json, "\"TestTraceOuterMany\"");
+  const int num_inner = TestTraceCount(json, "\"TestTraceInnerMany\"");
+  EXPECT_TRUE(num_outer + num_inner <= TRACE_BUFFER_SIZE);
+  EXPECT_TRUE(num_outer + num_inner >= TRACE_BUFFER_SIZE - 4);
+  EXPECT_EQ(TestTraceCount(json, "\"ph\":\"B\""),
+    TestTraceCount(json, "\"ph\":\"E\""));
+}
+
+void TestTraceNamedScope(const char* thread_name, const char* scope_name) {
+  jtil::threading::SetThreadName(thread_name);
+  jtil::debug::TraceScope scope(scope_name);
+}
+
+// The tid of the first event called 'name', -1 if there is none
+int TestTraceTid(const std::string& json, const std::string& name) {
+  const size_t pos = json.find("\"" + name + "\",\"ph\"");
+  const std::string tid_str = "\"tid\":";
+  const size_t tid_pos = pos == std::string::npos ? pos :
+    json.find(tid_str, pos);
+  if (tid_pos == std::string::npos) {
+    return -1;
+  }
+  return atoi(json.c_str() + tid_pos + tid_str.size());
+}
+
+// A thread that exits hands its buffer, with its events, to the next thread
+// that traces rather than keeping it forever
+TEST(Trace, ReuseExitedThreadBuffers) {
+  Trace::start();
+  for (int i = 0; i < 2; i++) {
+    std::thread thread(&TestTraceNamedScope, i == 0 ? "TestTraceFirst" :
+      "TestTraceSecond", i == 0 ? "TestTraceFirstScope" :
+      "TestTraceSecondScope");
+    thread.join();
+  }
+  Trace::stop();
+  const std::string json = TestTraceJSON();
+  EXPECT_EQ(TestTraceCount(json, "\"TestTraceFirstScope\""), 2);
+  EXPECT_EQ(TestTraceCount(json, "\"TestTraceSecondScope\""), 2);
+  const int tid = TestTraceTid(json, "TestTraceFirstScope");
+  EXPECT_TRUE(tid > 0);
+  EXPECT_EQ(TestTraceTid(json, "TestTraceSecondScope"), tid);
+  // The buffer is named after the thread using it now
+  EXPECT_EQ(TestTraceCount(json, "\"args\":{\"name\":\"TestTraceSecond\"}"),
+    1);
+  EXPECT_EQ(TestTraceCount(json, "\"args\":{\"name\":\"TestTraceFirst\"}"),
+    0);
+}
@@ -5,18 +5,34 @@
 //
 //  Test everything
 
+#include "test_benchmark.h"
 #include "test_callback.h"
 #include "test_callback_queue.h"
+#include "test_lock_free_queue.h"
 #include "test_data_str.h"
 #include "test_math.h"
 #include "test_settings_manager.h"
 #include "test_thread.h"
 #include "test_thread_pool.h"
+#include "test_task_group.h"
+#include "test_pipeline.h"
+#include "test_async_io.h"
+#include "test_clk.h"
+#include "test_trace.h"
+#include "test_perf_counters.h"
+#include "test_alloc_tracker.h"
 #include "test_optimization.h"
 #include "test_marching_squares.h"
 #include "test_image_util.h"
 #include "test_math/test_profile_simd_math.h"  // Profile last
+#include "test_thread_pool_profile.h"
+#include "test_data_str/test_profile_concurrent_hash_map.h"
+#include "test_data_str/test_profile_flat_hash_map.h"
+#include "test_data_str/test_profile_vector.h"
+#include "test_async_io_profile.h"
+#include "test_clk_profile.h"
 
+#include "test_unit/perf_benchmark_counters.h"
 #include "jtil/debug_util/debug_util.h"  // Must come last in .cpp with main
 
 using std::cout;
@@ -27,6 +43,8 @@ int main(int argc, char* argv[]) {
   jtil::debug::EnableMemoryLeakChecks();
   // jtil::debug::SetBreakPointOnAlocation(26730);
 #endif
+  tests::PerfBenchmarkCounters perf_counters;
+  tests::TestRegistry::getInstance()->setBenchmarkCounters(&perf_counters);
   int ret_val = RUN_TESTS(argc, argv);
 #ifdef _WIN32
   system("PAUSE");